@@ -16,6 +16,8 @@ $(eval $(call gb_CppunitTest_add_exception_objects,vcl_graphic_test, \
     vcl/qa/cppunit/GraphicNativeMetadataTest \
     $(if $(filter PDFIUM,$(BUILD_TYPE)),vcl/qa/cppunit/VectorGraphicSearchTest) \
     vcl/qa/cppunit/BinaryDataContainerTest \
+    vcl/qa/cppunit/WmfWriterTest \
+    vcl/qa/cppunit/EpsWriterTest \
 ))
 
 $(eval $(call gb_CppunitTest_use_externals,vcl_graphic_test, \
@@ -297,6 +297,7 @@ $(eval $(call gb_Library_add_exception_objects,vcl,\
     vcl/source/gdi/regband \
     vcl/source/gdi/region \
     vcl/source/gdi/regionband \
+    vcl/source/gdi/regionbandarray \
     vcl/source/gdi/salgdilayout \
     vcl/source/gdi/salgdiimpl \
     vcl/source/gdi/sallayout \
@@ -339,8 +340,13 @@ $(eval $(call gb_Library_add_exception_objects,vcl,\
     vcl/source/bitmap/alpha \
     vcl/source/bitmap/dibtools \
     vcl/source/bitmap/bmpfast \
+    vcl/source/bitmap/bmpfastsimd \
     vcl/source/bitmap/bitmapfilter \
     vcl/source/bitmap/bitmappaint \
+    vcl/source/bitmap/BitmapParallel \
+    vcl/source/bitmap/BitmapFilterPipeline \
+    vcl/source/bitmap/BitmapBufferPool \
+    vcl/source/bitmap/BitmapRegionAccess \
     vcl/source/bitmap/BitmapShadowFilter \
     vcl/source/bitmap/BitmapAlphaClampFilter \
     vcl/source/bitmap/BitmapBasicMorphologyFilter \
@@ -367,10 +373,12 @@ $(eval $(call gb_Library_add_exception_objects,vcl,\
     vcl/source/bitmap/BitmapScaleConvolutionFilter \
     vcl/source/bitmap/BitmapSymmetryCheck \
     vcl/source/bitmap/BitmapColorQuantizationFilter \
+    vcl/source/bitmap/BitmapDitheredColorQuantizationFilter \
     vcl/source/bitmap/BitmapSimpleColorQuantizationFilter \
     vcl/source/bitmap/BitmapTools \
     vcl/source/bitmap/checksum \
     vcl/source/bitmap/Octree \
+    vcl/source/bitmap/WuQuantizer \
     vcl/source/bitmap/salbmp \
     vcl/source/image/Image \
     vcl/source/image/ImageTree \
@@ -466,6 +474,7 @@ $(eval $(call gb_Library_add_exception_objects,vcl,\
     vcl/source/filter/jpeg/JpegReader \
     vcl/source/filter/jpeg/JpegWriter \
     vcl/source/filter/jpeg/JpegTransform \
+    vcl/source/filter/svm/SvmCompact \
     vcl/source/filter/svm/SvmConverter \
     vcl/source/filter/svm/SvmReader \
     vcl/source/filter/svm/SvmWriter \
@@ -524,6 +533,15 @@ $(eval $(call gb_Library_add_exception_objects,vcl,\
     vcl/jsdialog/executor \
 ))
 
+# the bmpfast kernels are selected at runtime depending on the CPU
+$(eval $(call gb_Library_add_exception_objects,vcl,\
+    vcl/source/bitmap/bmpfastSSSE3, $(CXXFLAGS_INTRINSICS_SSSE3) \
+))
+
+$(eval $(call gb_Library_add_exception_objects,vcl,\
+    vcl/source/bitmap/bmpfastAVX2, $(CXXFLAGS_INTRINSICS_AVX2) \
+))
+
 $(eval $(call gb_Library_add_cobjects,vcl,\
     vcl/source/filter/jpeg/transupp \
 ))
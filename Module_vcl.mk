@@ -57,6 +57,8 @@ $(eval $(call gb_Module_add_targets,vcl,\
         Executable_fftester \
         Executable_svptest \
         Executable_listfonts \
+        Executable_bitmapbench \
+        Executable_regionbench \
         Executable_svpclient) \
 ))
 
@@ -209,6 +211,7 @@ $(eval $(call gb_Module_add_check_targets,vcl,\
     CppunitTest_vcl_mnemonic \
     CppunitTest_vcl_outdev \
     CppunitTest_vcl_gradient \
+    CppunitTest_vcl_region \
     CppunitTest_vcl_app_test \
     CppunitTest_vcl_jpeg_read_write_test \
     CppunitTest_vcl_svm_test \
@@ -0,0 +1,83 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <sal/types.h>
+#include <vcl/dllapi.h>
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace vcl::bitmap
+{
+/** Keeps the pixel memory of released bitmaps for the next bitmap of about the same size.
+
+    Scaling, converting, filtering and drawing through a VirtualDevice make a temporary bitmap
+    after the other, mostly of the same few sizes, and fresh multi-megabyte allocations are
+    slow: every one of them is mapped and page faulted again. Released buffers are kept here
+    instead, in size classes of a quarter of a power of two (so at most a quarter of a buffer
+    is wasted), and are handed out again for the next request of the same class.
+
+    Buffers below MinPooledBytes are left to the heap. The cached memory is limited: releasing
+    beyond the limit frees the oldest buffers, and Trim() frees them on memory pressure
+    (graphic::Manager does that when it has to reduce its memory). With VCL_NO_BITMAP_POOL set
+    in the environment nothing is cached, which keeps use after release visible to memory
+    checkers.
+
+    A buffer has to be given back with Release() with the size it was asked for.
+    All the methods are thread safe.
+*/
+class VCL_DLLPUBLIC BitmapBufferPool
+{
+public:
+    static constexpr size_t MinPooledBytes = 64 * 1024;
+
+    explicit BitmapBufferPool(size_t nMaxCachedBytes);
+    ~BitmapBufferPool();
+    BitmapBufferPool(const BitmapBufferPool&) = delete;
+    BitmapBufferPool& operator=(const BitmapBufferPool&) = delete;
+
+    /// The pool used for the pixels of bitmaps.
+    static BitmapBufferPool& get();
+
+    /// The number of bytes actually allocated for a request of nBytes.
+    static size_t getSizeClass(size_t nBytes);
+
+    /// Uninitialized memory of at least nBytes, nullptr if there is not enough memory.
+    sal_uInt8* Allocate(size_t nBytes);
+    /// Gives back pBuffer from Allocate(nBytes); nullptr is fine.
+    void Release(sal_uInt8* pBuffer, size_t nBytes);
+
+    /// Frees the least recently released buffers until at most nKeepBytes are cached.
+    void Trim(size_t nKeepBytes = 0);
+
+    size_t GetCachedBytes() const;
+
+private:
+    struct Entry
+    {
+        size_t mnSize;
+        sal_uInt8* mpBuffer;
+    };
+
+    static void freeEntries(const std::vector<Entry>& rEntries);
+    /// Takes the oldest entries above nKeepBytes out of maFree into rFreed.
+    void evict(size_t nKeepBytes, std::vector<Entry>& rFreed);
+
+    const size_t mnMaxCachedBytes;
+    mutable std::mutex maMutex;
+    std::vector<Entry> maFree; // least recently released first
+    size_t mnCachedBytes = 0;
+};
+
+} // end vcl::bitmap
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
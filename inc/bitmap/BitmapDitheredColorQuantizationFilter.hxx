@@ -0,0 +1,40 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ */
+
+#pragma once
+
+#include <vcl/BitmapFilter.hxx>
+
+#include <bitmap/WuQuantizer.hxx>
+
+/** Like BitmapColorQuantizationFilter, but dithers the pixels over the palette instead of
+    mapping each of them to its own palette entry.
+*/
+class VCL_DLLPUBLIC BitmapDitheredColorQuantizationFilter final : public BitmapFilter
+{
+public:
+    /** Reduce number of colors of the bitmap to at most nNewColorCount (and at most 256),
+        dithered with eDither.
+    */
+    BitmapDitheredColorQuantizationFilter(
+        sal_uInt16 nNewColorCount, QuantizationDither eDither = QuantizationDither::FloydSteinberg)
+        : mnNewColorCount(nNewColorCount)
+        , meDither(eDither)
+    {
+    }
+
+    virtual BitmapEx execute(BitmapEx const& rBitmapEx) const override;
+
+private:
+    sal_uInt16 mnNewColorCount;
+    QuantizationDither meDither;
+};
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
@@ -0,0 +1,100 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <sal/types.h>
+#include <vcl/BitmapFilter.hxx>
+#include <vcl/dllapi.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+class Bitmap;
+class BitmapWriteAccess;
+
+namespace vcl::bitmap
+{
+/// Maps the 256 values of one color channel.
+typedef std::array<sal_uInt8, 256> ChannelTable;
+
+/** A sequence of filters run as few passes over the pixels as possible.
+
+    Chaining filters one after another costs a pass, a new bitmap and often a format conversion
+    for each of them. Most adjustments however only look at one pixel at a time: the pointwise
+    stages here (channel tables and greying) are run together as one kernel over every pixel in a
+    single pass split into bands of rows, and two tables following each other are joined into one
+    table already when added.
+
+    Filters that need the neighbourhood of a pixel (blur, mosaic, ...) are added with Filter()
+    and run on their own, so only they make intermediate bitmaps.
+*/
+class VCL_DLLPUBLIC BitmapFilterPipeline final : public BitmapFilter
+{
+public:
+    /// Maps red, green and blue through their own table.
+    BitmapFilterPipeline& Lookup(const ChannelTable& rRed, const ChannelTable& rGreen,
+                                 const ChannelTable& rBlue);
+    BitmapFilterPipeline& Lookup(const ChannelTable& rTable)
+    {
+        return Lookup(rTable, rTable, rTable);
+    }
+
+    /// Sets all channels to the luminance, as Color::GetLuminance() does.
+    BitmapFilterPipeline& Grey();
+
+    /// The tables Bitmap::Adjust() maps the channels with, the same arguments.
+    BitmapFilterPipeline& Adjust(short nLuminancePercent, short nContrastPercent,
+                                 short nChannelRPercent, short nChannelGPercent,
+                                 short nChannelBPercent, double fGamma, bool bInvert,
+                                 bool msoBrightness);
+
+    /// A filter working on more than one pixel at a time, run on its own.
+    BitmapFilterPipeline& Filter(std::shared_ptr<const BitmapFilter> pFilter);
+
+    bool IsEmpty() const { return maStages.empty(); }
+    /// Whether there are only pointwise stages, so Apply() can be used.
+    bool IsPointwise() const;
+    /// The number of stages after joining the tables.
+    size_t GetStageCount() const { return maStages.size(); }
+
+    /// Runs the pointwise stages on rBitmap in place; palettes are mapped instead of pixels.
+    bool Apply(Bitmap& rBitmap) const;
+
+    /// Keeps the alpha of rBitmapEx as it is.
+    virtual BitmapEx execute(BitmapEx const& rBitmapEx) const override;
+
+private:
+    enum class StageType
+    {
+        Lookup,
+        Grey,
+        Filter
+    };
+
+    struct Stage
+    {
+        StageType meType;
+        std::array<ChannelTable, 3> maTables; // red, green, blue
+        std::shared_ptr<const BitmapFilter> mpFilter;
+    };
+
+    typedef std::vector<Stage>::const_iterator StageIterator;
+
+    static void applyKernel(StageIterator aBegin, StageIterator aEnd, sal_uInt8& rR,
+                            sal_uInt8& rG, sal_uInt8& rB);
+    static void applyPointwise(StageIterator aBegin, StageIterator aEnd, BitmapWriteAccess& rAcc);
+
+    std::vector<Stage> maStages;
+};
+
+} // end vcl::bitmap
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
@@ -0,0 +1,44 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <sal/types.h>
+#include <vcl/bitmapex.hxx>
+#include <vcl/dllapi.h>
+#include <vcl/Scanline.hxx>
+
+#include <functional>
+
+namespace vcl::bitmap
+{
+/// Gets back the pixels given to CreateFromBuffer() once they are not used any more.
+typedef std::function<void(sal_uInt8*)> BufferReleaseFunction;
+
+/** Makes a BitmapEx of pixels in a buffer from elsewhere, without copying them if possible.
+
+    Unlike CreateFromData(), which always copies, this takes over pData: if the backend keeps
+    its pixels in the same layout (format and 4 byte aligned stride), the bitmap uses pData,
+    and rRelease is called once the bitmap does not need it any more. The backend may swap
+    the color order of 24 bit pixels in place for that. Otherwise the pixels are
+    converted into a new bitmap and rRelease is called before returning. Either way the caller
+    must not touch pData after the call, other than from rRelease.
+
+    The rows are from top to bottom, nStride bytes apart. eFormat is one of N8BitPal (grey
+    values), N24BitTcBgr, N24BitTcRgb, N32BitTcBgra and N32BitTcRgba; the 32 bit formats have
+    unpremultiplied alpha (255 is opaque) and are always converted, as the BitmapEx keeps the
+    alpha separately.
+*/
+VCL_DLLPUBLIC BitmapEx CreateFromBuffer(sal_uInt8* pData, sal_Int32 nWidth, sal_Int32 nHeight,
+                                        sal_Int32 nStride, ScanlineFormat eFormat,
+                                        const BufferReleaseFunction& rRelease);
+
+} // end vcl::bitmap
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
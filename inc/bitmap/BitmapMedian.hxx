@@ -0,0 +1,35 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <sal/types.h>
+#include <vcl/bitmap.hxx>
+#include <vcl/dllapi.h>
+
+namespace vcl::bitmap
+{
+/// The column histograms count up to 2 * nRadius + 1 rows in 16 bits.
+constexpr sal_Int32 MedianMaxRadius = 32767;
+
+/** Replaces every pixel by the per channel median of the (2 * nRadius + 1)^2 pixels around it.
+
+    Pixels beyond the borders repeat the border pixels, like BitmapMedianFilter always did for
+    its 3x3 window. Bitmaps with the 8 bit grey palette give an 8 bit grey bitmap, all others
+    a 24 bit one. nRadius is clamped to 0 .. MedianMaxRadius.
+
+    Apart from the 3x3 case, which uses a sorting network, the median is found with sliding
+    column histograms, so the time per pixel does not depend on the radius. Returns an empty
+    bitmap if the bitmaps could not be accessed.
+*/
+VCL_DLLPUBLIC Bitmap medianFilter(const Bitmap& rBitmap, sal_Int32 nRadius);
+
+} // end vcl::bitmap
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
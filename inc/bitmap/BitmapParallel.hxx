@@ -0,0 +1,42 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <sal/types.h>
+#include <vcl/dllapi.h>
+
+#include <functional>
+
+namespace vcl::bitmap
+{
+/// Below this number of pixels filters are not worth the threading overhead.
+constexpr sal_Int64 ParallelFilterMinPixels = 256 * 256;
+
+/** Calls rFunction(nStart, nEnd) for consecutive strips covering the rows 0 .. nRows - 1.
+
+    nEnd is inclusive, like with generateStripRanges(). If there are at least nMinPixels
+    pixels in total, the strips are processed on the shared thread pool, otherwise (or
+    with VCL_NO_THREAD_FILTER set) rFunction is called once for all rows in this thread.
+
+    rFunction may be called concurrently and so must only write to its own rows, and keep
+    any per row state (like rolling line buffers) local to the call. Reading the rows of
+    another strip is fine as long as nothing writes to them: neighbourhood filters that
+    write to a new bitmap simply read the rows around their strip from the source.
+
+    A "row" can be anything row shaped, e.g. a row of mosaic tiles, nPixelsPerRow is
+    only used for deciding on threading and the strip size.
+*/
+VCL_DLLPUBLIC void parallelForRows(sal_Int32 nRows, sal_Int64 nPixelsPerRow,
+                                   const std::function<void(sal_Int32, sal_Int32)>& rFunction,
+                                   sal_Int64 nMinPixels = ParallelFilterMinPixels);
+
+} // end vcl::bitmap
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
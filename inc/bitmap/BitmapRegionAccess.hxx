@@ -0,0 +1,107 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <tools/gen.hxx>
+#include <vcl/bitmap.hxx>
+#include <vcl/BitmapAccessMode.hxx>
+#include <vcl/BitmapBuffer.hxx>
+#include <vcl/BitmapReadAccess.hxx>
+#include <vcl/dllapi.h>
+
+#include <memory>
+
+class SalBitmap;
+
+namespace vcl::bitmap
+{
+/** Read or write access to the pixels in a rectangle of a bitmap.
+
+    BitmapReadAccess and BitmapWriteAccess always make the whole bitmap accessible, and backends
+    that keep the pixels elsewhere (e.g. in a texture) copy and convert all of them for that.
+    This tells the backend the rectangle that is going to be accessed instead (see
+    SalBitmap::AcquireRegionBuffer()), so it can do only that part.
+
+    The region is clipped to the bitmap, and all coordinates are relative to its top left.
+    Only the pixels inside the region may be accessed.
+*/
+class VCL_DLLPUBLIC BitmapRegionAccess
+{
+public:
+    BitmapRegionAccess(Bitmap& rBitmap, const tools::Rectangle& rRegion,
+                       BitmapAccessMode nMode = BitmapAccessMode::Read);
+    ~BitmapRegionAccess();
+    BitmapRegionAccess(const BitmapRegionAccess&) = delete;
+    BitmapRegionAccess& operator=(const BitmapRegionAccess&) = delete;
+
+    explicit operator bool() const { return mpBuffer != nullptr; }
+
+    /// In the coordinates of the bitmap.
+    const tools::Rectangle& GetRegion() const { return maRegion; }
+    tools::Long Width() const { return maRegion.GetWidth(); }
+    tools::Long Height() const { return maRegion.GetHeight(); }
+
+    ScanlineFormat GetScanlineFormat() const { return RemoveScanline(mpBuffer->mnFormat); }
+    bool HasPalette() const { return mpBuffer->maPalette.GetEntryCount() != 0; }
+    const BitmapPalette& GetPalette() const { return mpBuffer->maPalette; }
+
+    /// The row of the buffer with the row nY of the region.
+    Scanline GetScanline(tools::Long nY) const
+    {
+        assert(nY >= 0 && nY < Height() && "y-coordinate out of range!");
+        const tools::Long nRow = maBufferPos.Y() + nY;
+        if (mpBuffer->mnFormat & ScanlineFormat::TopDown)
+            return mpBuffer->mpBits + nRow * mpBuffer->mnScanlineSize;
+        return mpBuffer->mpBits + (mpBuffer->mnHeight - nRow - 1) * mpBuffer->mnScanlineSize;
+    }
+
+    /// nX is in the region, pScanline from GetScanline().
+    BitmapColor GetPixelFromData(ConstScanline pScanline, tools::Long nX) const
+    {
+        assert(nX >= 0 && nX < Width() && "x-coordinate out of range!");
+        return mFncGetPixel(pScanline, maBufferPos.X() + nX, mpBuffer->maColorMask);
+    }
+    void SetPixelOnData(Scanline pScanline, tools::Long nX, const BitmapColor& rColor)
+    {
+        assert(mnAccessMode == BitmapAccessMode::Write && "Not a write access!");
+        assert(nX >= 0 && nX < Width() && "x-coordinate out of range!");
+        mFncSetPixel(pScanline, maBufferPos.X() + nX, rColor, mpBuffer->maColorMask);
+    }
+
+    BitmapColor GetPixel(tools::Long nY, tools::Long nX) const
+    {
+        return GetPixelFromData(GetScanline(nY), nX);
+    }
+    void SetPixel(tools::Long nY, tools::Long nX, const BitmapColor& rColor)
+    {
+        SetPixelOnData(GetScanline(nY), nX, rColor);
+    }
+
+    /// The color of the pixel, also for palette bitmaps.
+    BitmapColor GetColor(tools::Long nY, tools::Long nX) const
+    {
+        const BitmapColor aPixel(GetPixel(nY, nX));
+        return HasPalette() ? mpBuffer->maPalette[aPixel.GetIndex()] : aPixel;
+    }
+
+private:
+    std::shared_ptr<SalBitmap> mxSalBitmap;
+    BitmapBuffer* mpBuffer = nullptr;
+    tools::Rectangle maRegion;
+    /// The top left of the region in the buffer, which may have only the region.
+    Point maBufferPos;
+    BitmapAccessMode mnAccessMode;
+    FncGetPixel mFncGetPixel = nullptr;
+    FncSetPixel mFncSetPixel = nullptr;
+};
+
+} // end vcl::bitmap
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
@@ -0,0 +1,62 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vcl/dllapi.h>
+#include <vcl/BitmapColor.hxx>
+#include <vcl/BitmapPalette.hxx>
+
+#include <vector>
+
+class BitmapReadAccess;
+class BitmapWriteAccess;
+
+enum class QuantizationDither
+{
+    None,
+    FloydSteinberg,
+    /// 8x8 Bayer matrix, unlike Floyd-Steinberg every pixel only depends on its own color
+    Ordered
+};
+
+/** Reduces the colors of a bitmap with Wu's variance minimization.
+
+    See Xiaolin Wu, "Efficient Statistical Computations for Optimal Color Quantization",
+    Graphics Gems II. The colors are counted in a histogram of 32 levels per channel, whose
+    cumulative moments give the color variance of any box of it in constant time. Starting
+    from the whole color cube, the box with the largest variance is cut where that reduces
+    the sum of variances the most, until there are as many boxes as colors. The time taken is
+    linear in the number of pixels, plus a constant for the histogram.
+
+    Every histogram cell belongs to exactly one box, so mapping a color to its palette entry
+    is a single table lookup.
+*/
+class VCL_DLLPUBLIC WuQuantizer
+{
+public:
+    WuQuantizer(const BitmapReadAccess& rReadAcc, sal_uInt16 nColors);
+
+    /// The mean colors of the boxes, fewer than requested if the bitmap has fewer colors.
+    const BitmapPalette& GetPalette() const { return maPalette; }
+
+    sal_uInt16 GetBestPaletteIndex(const BitmapColor& rColor) const;
+
+    /// Writes the palette indices of the pixels of rReadAcc to rWriteAcc, which has to have
+    /// the same size and a palette with the entries of GetPalette() at its start. When
+    /// dithering, the pixels are mapped to the nearest palette entry instead of their box.
+    void Map(const BitmapReadAccess& rReadAcc, BitmapWriteAccess& rWriteAcc,
+             QuantizationDither eDither) const;
+
+private:
+    BitmapPalette maPalette;
+    std::vector<sal_uInt8> maTags;
+};
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
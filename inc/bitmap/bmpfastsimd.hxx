@@ -0,0 +1,81 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vcl/dllapi.h>
+#include <vcl/Scanline.hxx>
+
+#include <array>
+#include <vector>
+
+namespace vcl::bitmap
+{
+/// Marks a destination byte that is not taken from the source but set to 0xff (opaque alpha).
+constexpr sal_uInt8 ShuffleOpaque = 0xff;
+
+/** Describes the conversion of one truecolor scanline format into another.
+
+    All conversions done by bmpfast between the 8 bit grey, 24 bit and 32 bit
+    formats only move bytes around, so a conversion is fully described by the
+    source byte each destination byte of a pixel comes from.
+*/
+struct PixelShuffle
+{
+    sal_uInt8 mnSrcBytes = 0; ///< bytes per source pixel: 1, 3 or 4
+    sal_uInt8 mnDstBytes = 0; ///< bytes per destination pixel: 3 or 4
+    std::array<sal_uInt8, 4> maSource{}; ///< source byte per destination byte, or ShuffleOpaque
+    sal_uInt8 mnDstAlpha = ShuffleOpaque; ///< alpha byte of a destination pixel, if it has one
+};
+
+/// Fills rShuffle for converting eSrc into eDst, returns false if that isn't a pure byte shuffle.
+VCL_DLLPUBLIC bool getPixelShuffle(ScanlineFormat eSrc, ScanlineFormat eDst,
+                                   PixelShuffle& rShuffle);
+
+/// Converts nPixelCount pixels, pDst and pSrc must not overlap.
+typedef void (*ShuffleLineFunction)(sal_uInt8* pDst, const sal_uInt8* pSrc, int nPixelCount,
+                                    const PixelShuffle& rShuffle);
+
+VCL_DLLPUBLIC void shuffleLineScalar(sal_uInt8* pDst, const sal_uInt8* pSrc, int nPixelCount,
+                                     const PixelShuffle& rShuffle);
+
+/// The fastest vectorized shuffle this CPU supports, or nullptr if there is none.
+VCL_DLLPUBLIC ShuffleLineFunction getShuffleLineFunction();
+
+/// All vectorized shuffles this CPU supports, for comparing them against the scalar one.
+VCL_DLLPUBLIC std::vector<ShuffleLineFunction> getSupportedShuffleLineFunctions();
+
+/** Blends a line of 32 bit pixels like ImplBlendPixels() does.
+
+    pSrc has to be in the same format as pDst already. A mask value of 0 copies
+    the source pixel, 255 keeps the destination pixel, everything in between mixes
+    the color bytes and keeps the destination's alpha byte nDstAlpha.
+*/
+typedef void (*BlendLine32Function)(sal_uInt8* pDst, const sal_uInt8* pSrc,
+                                    const sal_uInt8* pMask, int nPixelCount, sal_uInt8 nDstAlpha);
+
+VCL_DLLPUBLIC void blendLine32Scalar(sal_uInt8* pDst, const sal_uInt8* pSrc,
+                                     const sal_uInt8* pMask, int nPixelCount, sal_uInt8 nDstAlpha);
+
+/// The fastest blend this CPU supports, the scalar one if there is no vectorized one.
+VCL_DLLPUBLIC BlendLine32Function getBlendLine32Function();
+
+/// All vectorized blends this CPU supports, for comparing them against the scalar one.
+VCL_DLLPUBLIC std::vector<BlendLine32Function> getSupportedBlendLine32Functions();
+
+// Implemented in separate files that are built with the respective instruction set
+// enabled, they return nullptr if the compiler could not build them.
+ShuffleLineFunction getShuffleLineSSSE3();
+ShuffleLineFunction getShuffleLineAVX2();
+BlendLine32Function getBlendLine32SSSE3();
+BlendLine32Function getBlendLine32AVX2();
+
+} // end vcl::bitmap
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
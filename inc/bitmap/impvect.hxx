@@ -19,14 +19,21 @@
 
 #pragma once
 
+#include <vcl/dllapi.h>
 #include <vcl/gdimtf.hxx>
 
 namespace tools { class PolyPolygon; }
 
 namespace ImplVectorizer
 {
-    bool     ImplVectorize( const Bitmap& rColorBmp, GDIMetaFile& rMtf,
-                            sal_uInt8 cReduce, const Link<tools::Long,void>* pProgress );
+    /** Traces the areas of each palette color of rColorBmp into polygons.
+
+        With fTolerance > 0 the outlines are simplified with Douglas-Peucker, dropping points
+        that are less than fTolerance pixels away from the simplified outline.
+    */
+    VCL_DLLPUBLIC bool ImplVectorize( const Bitmap& rColorBmp, GDIMetaFile& rMtf,
+                                      sal_uInt8 cReduce, const Link<tools::Long,void>* pProgress,
+                                      double fTolerance = 0.0 );
 };
 
 /* vim:set shiftwidth=4 softtabstop=4 expandtab: */
@@ -22,7 +22,23 @@
 #include <vcl/graph.hxx>
 #include <vcl/FilterConfigItem.hxx>
 
+#include <string>
+
 VCL_DLLPUBLIC bool ExportEpsGraphic(SvStream& rStream, const Graphic& rGraphic,
                                     FilterConfigItem* pFilterConfigItem);
 
+namespace vcl::eps
+{
+/// Appends nSize bytes as upper case hex digits to rOut. rLinePos is the column of the
+/// current output line; a line feed is added whenever it reaches nLineSize.
+VCL_DLLPUBLIC void EncodeHex(std::string& rOut, const sal_uInt8* pData, size_t nSize,
+                             sal_uInt32& rLinePos, sal_uInt32 nLineSize);
+
+/// Appends nSize bytes in ASCII85 to rOut, without the ~> end of data marker. Groups of four
+/// zero bytes are written as z, and a final partial group of n bytes as n + 1 characters.
+/// Line feeds are added like in EncodeHex, and a line never starts with %.
+VCL_DLLPUBLIC void EncodeASCII85(std::string& rOut, const sal_uInt8* pData, size_t nSize,
+                                 sal_uInt32& rLinePos, sal_uInt32 nLineSize);
+}
+
 /* vim:set shiftwidth=4 softtabstop=4 expandtab: */
@@ -0,0 +1,54 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <tools/poly.hxx>
+#include <tools/stream.hxx>
+#include <vcl/dllapi.h>
+#include <vcl/filter/SvmWriter.hxx>
+#include <vcl/gdimtf.hxx>
+#include <vcl/metaact.hxx>
+
+/**
+ * Compact encoding of the point arrays of polygon actions in SVM.
+ *
+ * Points are stored as zigzag varint deltas to the previous point, which
+ * typically needs 2-3 bytes per point instead of 8. The encoded block is
+ * prefixed by its byte length, so it can be read in one go.
+ *
+ * Only CompactSvmWriter writes this form, and only the graphic swap file uses
+ * that writer, as it is read back by the same code. Its polygon actions get a
+ * new action version whose Version 1 polygon data is left empty, so older
+ * readers still parse the stream but see empty polygons. A plain SvmWriter,
+ * used for the clipboard and files, writes the same bytes as before.
+ */
+namespace vcl::svm
+{
+/// SvmWriter that writes the polygon, polyline and polypolygon points compactly.
+class VCL_DLLPUBLIC CompactSvmWriter : public SvmWriter
+{
+public:
+    explicit CompactSvmWriter(SvStream& rOStm);
+
+    SvStream& Write(const GDIMetaFile& rMetaFile);
+
+private:
+    void CompactPolyLineHandler(const MetaPolyLineAction* pAction);
+    void CompactPolygonHandler(const MetaPolygonAction* pAction);
+    void CompactPolyPolygonHandler(const MetaPolyPolygonAction* pAction);
+
+    SvStream& mrOStm;
+};
+
+bool ReadCompactPolygon(SvStream& rIStm, tools::Polygon& rPoly);
+bool ReadCompactPolyPolygon(SvStream& rIStm, tools::PolyPolygon& rPolyPoly);
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
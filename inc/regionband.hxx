@@ -31,6 +31,7 @@ class RegionBand
 {
 private:
     friend const char* ImplDbgTestRegionBand(const void*);
+    friend class RegionBandArray;
 
     ImplRegionBand* mpFirstBand; // root of the list with y-bands
     ImplRegionBand* mpLastCheckedBand;
@@ -0,0 +1,85 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4; fill-column: 100 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <sal/types.h>
+#include <tools/long.hxx>
+
+#include <vector>
+
+class RegionBand;
+
+enum class RegionBandOperation
+{
+    Union,
+    Intersect,
+    Exclude,
+    XOr
+};
+
+/** The bands of a RegionBand in one array and all their separations in another.
+
+    RegionBand keeps the bands in a linked list, each with a linked list of separations, which
+    suits building a region from polygons band by band. Combining two regions that way is slow
+    though: every rectangle of one is applied to the other on its own, walking the lists and
+    allocating nodes each time, which is quadratic for clip regions of many rectangles.
+
+    Here both regions are merged in one pass instead, like a merge of two sorted lists: the y
+    ranges are walked from top to bottom, and for each range the separations of both are merged
+    from left to right. The result is normalized the way RegionBand::OptimizeBandList() does it
+    (no empty bands, touching separations joined, equal bands on top of each other joined), so
+    that it compares equal to the result of applying the rectangles one by one.
+
+    All the coordinates are inclusive, as in RegionBand.
+*/
+class RegionBandArray
+{
+public:
+    struct Band
+    {
+        tools::Long mnYTop;
+        tools::Long mnYBottom;
+        // the separations of the band are maSeps[mnFirstSep] to maSeps[mnEndSep - 1]
+        sal_uInt32 mnFirstSep;
+        sal_uInt32 mnEndSep;
+    };
+
+    struct Sep
+    {
+        tools::Long mnXLeft;
+        tools::Long mnXRight;
+    };
+
+    RegionBandArray() = default;
+    explicit RegionBandArray(const RegionBand& rRegionBand);
+    /// The result of eOperation with rFirst and rSecond.
+    RegionBandArray(const RegionBandArray& rFirst, const RegionBandArray& rSecond,
+                    RegionBandOperation eOperation);
+
+    bool IsEmpty() const { return maBands.empty(); }
+    const std::vector<Band>& GetBands() const { return maBands; }
+    const std::vector<Sep>& GetSeps() const { return maSeps; }
+
+    /// Replaces the bands of rRegionBand with these.
+    void ToRegionBand(RegionBand& rRegionBand) const;
+
+private:
+    /// Adds the separation to the band starting at nFirstSep, joined to the last one if touching.
+    void appendSep(sal_uInt32 nFirstSep, tools::Long nXLeft, tools::Long nXRight);
+    /// Adds the band with the separations from nFirstSep, joined to the last one if equal.
+    void appendBand(tools::Long nYTop, tools::Long nYBottom, sal_uInt32 nFirstSep);
+    void combineSeps(const Sep* pFirst, const Sep* pFirstEnd, const Sep* pSecond,
+                     const Sep* pSecondEnd, RegionBandOperation eOperation);
+
+    std::vector<Band> maBands;
+    std::vector<Sep> maSeps;
+};
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
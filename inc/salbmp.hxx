@@ -29,6 +29,8 @@
 #include <com/sun/star/rendering/XBitmapCanvas.hpp>
 #include <basegfx/utils/systemdependentdata.hxx>
 
+#include <functional>
+
 struct BitmapBuffer;
 class Color;
 class SalGraphics;
@@ -65,11 +67,32 @@ public:
     virtual bool            Create( const css::uno::Reference< css::rendering::XBitmapCanvas >& rBitmapCanvas,
                                     Size& rSize,
                                     bool bMask = false ) = 0;
+    // Uses pData as the pixels if they are in the layout the backend keeps them in, possibly
+    // after converting them in place; rRelease is called once they are not needed any more.
+    // Returns false without touching pData otherwise.
+    virtual bool            CreateFromBuffer( const Size& /*rSize*/,
+                                              vcl::PixelFormat /*ePixelFormat*/,
+                                              const BitmapPalette& /*rPal*/,
+                                              ScanlineFormat /*eFormat*/,
+                                              sal_uInt8* /*pData*/, sal_Int32 /*nStride*/,
+                                              const std::function<void(sal_uInt8*)>& /*rRelease*/ )
+    {
+        return false;
+    }
     virtual void            Destroy() = 0;
     virtual Size            GetSize() const = 0;
     virtual sal_uInt16      GetBitCount() const = 0;
 
     virtual BitmapBuffer*   AcquireBuffer( BitmapAccessMode nMode ) = 0;
+    // Like AcquireBuffer(), for when only the pixels in rRegion will be accessed. Backends that
+    // copy or convert their pixels into the buffer may return one with only rRegion in it, which
+    // then has the size of rRegion and starts with its top left pixel. Otherwise the buffer has
+    // the whole bitmap. Released with ReleaseBuffer().
+    virtual BitmapBuffer*   AcquireRegionBuffer( BitmapAccessMode nMode,
+                                                 const tools::Rectangle& /*rRegion*/ )
+    {
+        return AcquireBuffer( nMode );
+    }
     virtual void            ReleaseBuffer( BitmapBuffer* pBuffer, BitmapAccessMode nMode ) = 0;
     virtual bool            GetSystemData( BitmapSystemData& rData ) = 0;
 
@@ -25,6 +25,9 @@
 
 #include <boost/shared_ptr.hpp>
 
+#include <utility>
+#include <vector>
+
 #include <skia/utils.hxx>
 
 #include <SkImage.h>
@@ -45,12 +48,19 @@ public:
     virtual bool Create(const css::uno::Reference<css::rendering::XBitmapCanvas>& rBitmapCanvas,
                         Size& rSize, bool bMask = false) override;
 
+    virtual bool CreateFromBuffer(const Size& rSize, vcl::PixelFormat ePixelFormat,
+                                  const BitmapPalette& rPal, ScanlineFormat eFormat,
+                                  sal_uInt8* pData, sal_Int32 nStride,
+                                  const std::function<void(sal_uInt8*)>& rRelease) override;
+
     virtual void Destroy() final override;
 
     virtual Size GetSize() const override;
     virtual sal_uInt16 GetBitCount() const override;
 
     virtual BitmapBuffer* AcquireBuffer(BitmapAccessMode nMode) override;
+    virtual BitmapBuffer* AcquireRegionBuffer(BitmapAccessMode nMode,
+                                              const tools::Rectangle& rRegion) override;
     virtual void ReleaseBuffer(BitmapBuffer* pBuffer, BitmapAccessMode nMode) override;
 
     virtual bool GetSystemData(BitmapSystemData& rData) override;
@@ -141,6 +151,8 @@ private:
     void ReleaseBuffer(BitmapBuffer* pBuffer, BitmapAccessMode nMode, bool dontChangeToErase);
     SkBitmap GetAsSkBitmap() const;
     bool ConserveMemory() const;
+    // The alpha type to read mImage pixels as for mBuffer.
+    SkAlphaType ReadAlphaType() const;
     void verify() const
 #ifdef DBG_UTIL
         ;
@@ -212,8 +224,12 @@ private:
     bool mEraseColorSet = false;
     Color mEraseColor;
     int mReadAccessCount = 0; // number of read AcquireAccess() that have not been released
+    // Read buffers from AcquireRegionBuffer() that have only the region converted from mImage,
+    // not mBuffer.
+    std::vector<std::pair<const BitmapBuffer*, boost::shared_ptr<sal_uInt8[]>>> mRegionBuffers;
 #ifdef DBG_UTIL
     int mWriteAccessCount = 0; // number of write AcquireAccess() that have not been released
+    bool mBufferAdopted = false; // mBuffer is from CreateFromBuffer() and has no canary
 #endif
 };
 
@@ -12,11 +12,16 @@
 #include <cppunit/extensions/HelperMacros.h>
 
 #include <vcl/bitmapex.hxx>
+#include <vcl/skia/SkiaHelper.hxx>
 #include <basegfx/matrix/b2dhommatrix.hxx>
+#include <basegfx/point/b2dpoint.hxx>
+#include <bitmap/BitmapFromBuffer.hxx>
 #include <bitmap/BitmapWriteAccess.hxx>
 #include <svdata.hxx>
 #include <salinst.hxx>
 
+#include <cstdlib>
+
 namespace
 {
 class BitmapExTest : public CppUnit::TestFixture
@@ -24,11 +29,17 @@ class BitmapExTest : public CppUnit::TestFixture
     void testGetPixelColor24_8();
     void testGetPixelColor32();
     void testTransformBitmapEx();
+    void testTransformBitmapExRotated();
+    void testTransformBitmapExNearest();
+    void testCreateFromBuffer();
 
     CPPUNIT_TEST_SUITE(BitmapExTest);
     CPPUNIT_TEST(testGetPixelColor24_8);
     CPPUNIT_TEST(testGetPixelColor32);
     CPPUNIT_TEST(testTransformBitmapEx);
+    CPPUNIT_TEST(testTransformBitmapExRotated);
+    CPPUNIT_TEST(testTransformBitmapExNearest);
+    CPPUNIT_TEST(testCreateFromBuffer);
     CPPUNIT_TEST_SUITE_END();
 };
 
@@ -107,6 +118,156 @@ void BitmapExTest::testTransformBitmapEx()
     }
 }
 
+void BitmapExTest::testTransformBitmapExRotated()
+{
+    Bitmap aBitmap(Size(37, 23), vcl::PixelFormat::N24_BPP);
+    {
+        BitmapScopedWriteAccess pWriteAccess(aBitmap);
+        for (int y = 0; y < 23; ++y)
+            for (int x = 0; x < 37; ++x)
+                pWriteAccess->SetPixel(y, x, Color(x * 7, y * 11, (x * y) % 256));
+    }
+    BitmapEx aBitmapEx(aBitmap);
+
+    // a rotation by 30 degrees, mapping destination pixels to source pixels
+    basegfx::B2DHomMatrix aMatrix;
+    aMatrix.rotate(M_PI / 6);
+    aMatrix.translate(-3.37, 5.61);
+    BitmapEx aTransformed = aBitmapEx.TransformBitmapEx(48, 40, aMatrix);
+    Bitmap aResult = aTransformed.GetBitmap();
+    CPPUNIT_ASSERT_EQUAL(Size(48, 40), aResult.GetSizePixel());
+
+    // the rows are resampled incrementally, check against sampling each pixel on its own
+    Bitmap::ScopedReadAccess pSource(aBitmap);
+    Bitmap::ScopedReadAccess pAccess(aResult);
+    const BitmapColor aOutside(0xff, 0xff, 0xff);
+    for (int y = 0; y < 40; ++y)
+    {
+        for (int x = 0; x < 48; ++x)
+        {
+            const basegfx::B2DPoint aSource(aMatrix * basegfx::B2DPoint(x, y));
+            const BitmapColor aExpected(pSource->GetInterpolatedColorWithFallback(
+                aSource.getY(), aSource.getX(), aOutside));
+            const BitmapColor aColor(pAccess->GetColor(y, x));
+            CPPUNIT_ASSERT_LESSEQUAL(3, std::abs(aExpected.GetRed() - aColor.GetRed()));
+            CPPUNIT_ASSERT_LESSEQUAL(3, std::abs(aExpected.GetGreen() - aColor.GetGreen()));
+            CPPUNIT_ASSERT_LESSEQUAL(3, std::abs(aExpected.GetBlue() - aColor.GetBlue()));
+        }
+    }
+}
+
+void BitmapExTest::testTransformBitmapExNearest()
+{
+    Bitmap aBitmap(Size(37, 23), vcl::PixelFormat::N24_BPP);
+    {
+        BitmapScopedWriteAccess pWriteAccess(aBitmap);
+        for (int y = 0; y < 23; ++y)
+            for (int x = 0; x < 37; ++x)
+                pWriteAccess->SetPixel(y, x, Color(x * 7, y * 11, (x * y) % 256));
+    }
+    BitmapEx aBitmapEx(aBitmap);
+
+    // a rotation by 90 degrees takes the nearest pixel; the translation keeps the source
+    // coordinates well away from pixel borders, where rounding them could pick another pixel
+    basegfx::B2DHomMatrix aMatrix;
+    aMatrix.rotate(M_PI / 2);
+    aMatrix.translate(30.37, -4.61);
+    BitmapEx aTransformed = aBitmapEx.TransformBitmapEx(40, 48, aMatrix);
+    Bitmap aResult = aTransformed.GetBitmap();
+    CPPUNIT_ASSERT_EQUAL(Size(40, 48), aResult.GetSizePixel());
+
+    // the same pixels as sampling each one on its own, also where the row leaves the source
+    Bitmap::ScopedReadAccess pSource(aBitmap);
+    Bitmap::ScopedReadAccess pAccess(aResult);
+    const BitmapColor aOutside(0xff, 0xff, 0xff);
+    int nInside = 0;
+    for (int y = 0; y < 48; ++y)
+    {
+        for (int x = 0; x < 40; ++x)
+        {
+            const basegfx::B2DPoint aSource(aMatrix * basegfx::B2DPoint(x, y));
+            const BitmapColor aExpected(
+                pSource->GetColorWithFallback(aSource.getY(), aSource.getX(), aOutside));
+            CPPUNIT_ASSERT_EQUAL(aExpected, pAccess->GetColor(y, x));
+            if (aSource.getX() >= 0 && aSource.getY() >= 0 && aSource.getX() < 37
+                && aSource.getY() < 23)
+                ++nInside;
+        }
+    }
+    CPPUNIT_ASSERT(nInside > 0 && nInside < 40 * 48);
+}
+
+void BitmapExTest::testCreateFromBuffer()
+{
+    int nReleased = 0;
+    auto aRelease = [&nReleased](sal_uInt8* pData) {
+        ++nReleased;
+        delete[] pData;
+    };
+
+    // 24 bit in both color orders, in the stride the backends use; Skia keeps the pixels
+    for (ScanlineFormat eFormat : { ScanlineFormat::N24BitTcBgr, ScanlineFormat::N24BitTcRgb })
+    {
+        const int nBlue = eFormat == ScanlineFormat::N24BitTcBgr ? 0 : 2;
+        sal_uInt8* pData = new sal_uInt8[16 * 3];
+        for (int y = 0; y < 3; ++y)
+            for (int x = 0; x < 5; ++x)
+            {
+                pData[y * 16 + x * 3 + nBlue] = x;
+                pData[y * 16 + x * 3 + 1] = y;
+                pData[y * 16 + x * 3 + 2 - nBlue] = 200;
+            }
+        nReleased = 0;
+        {
+            BitmapEx aBitmapEx(
+                vcl::bitmap::CreateFromBuffer(pData, 5, 3, 16, eFormat, aRelease));
+            CPPUNIT_ASSERT_EQUAL(Size(5, 3), aBitmapEx.GetSizePixel());
+            CPPUNIT_ASSERT(!aBitmapEx.IsAlpha());
+            CPPUNIT_ASSERT_EQUAL(Color(200, 2, 4), aBitmapEx.GetPixelColor(4, 2).GetRGBColor());
+            CPPUNIT_ASSERT_EQUAL(Color(200, 1, 0), aBitmapEx.GetPixelColor(0, 1).GetRGBColor());
+            if (SkiaHelper::isVCLSkiaEnabled())
+            {
+                Bitmap aBitmap(aBitmapEx.GetBitmap());
+                BitmapReadAccess aAccess(aBitmap);
+                CPPUNIT_ASSERT_EQUAL(static_cast<ConstScanline>(pData), aAccess.GetScanline(0));
+                CPPUNIT_ASSERT_EQUAL(0, nReleased);
+            }
+        }
+        CPPUNIT_ASSERT_EQUAL(1, nReleased);
+    }
+
+    // rows that are not 4 byte aligned, like those of RawBitmap, are copied right away
+    {
+        sal_uInt8* pData = new sal_uInt8[5 * 3 * 2];
+        for (int i = 0; i < 5 * 3 * 2; ++i)
+            pData[i] = i;
+        nReleased = 0;
+        BitmapEx aBitmapEx(
+            vcl::bitmap::CreateFromBuffer(pData, 5, 2, 15, ScanlineFormat::N24BitTcRgb, aRelease));
+        CPPUNIT_ASSERT_EQUAL(1, nReleased);
+        CPPUNIT_ASSERT_EQUAL(Color(27, 28, 29), aBitmapEx.GetPixelColor(4, 1).GetRGBColor());
+    }
+
+    // grey values
+    {
+        sal_uInt8* pData = new sal_uInt8[8 * 2]{ 0, 10, 20, 30, 0, 0, 0, 0, 40, 50, 60, 70 };
+        BitmapEx aBitmapEx(
+            vcl::bitmap::CreateFromBuffer(pData, 4, 2, 8, ScanlineFormat::N8BitPal, aRelease));
+        CPPUNIT_ASSERT_EQUAL(Color(50, 50, 50), aBitmapEx.GetPixelColor(1, 1).GetRGBColor());
+    }
+    CPPUNIT_ASSERT_EQUAL(2, nReleased);
+
+    // with alpha, always copied into a separate alpha mask
+    sal_uInt8* pData = new sal_uInt8[2 * 4]{ 10, 20, 30, 255, 40, 50, 60, 0 };
+    BitmapEx aBitmapEx(
+        vcl::bitmap::CreateFromBuffer(pData, 2, 1, 8, ScanlineFormat::N32BitTcRgba, aRelease));
+    CPPUNIT_ASSERT_EQUAL(3, nReleased);
+    CPPUNIT_ASSERT(aBitmapEx.IsAlpha());
+    CPPUNIT_ASSERT_EQUAL(Color(10, 20, 30), aBitmapEx.GetPixelColor(0, 0).GetRGBColor());
+    CPPUNIT_ASSERT_EQUAL(sal_uInt8(255), aBitmapEx.GetAlpha(0, 0));
+    CPPUNIT_ASSERT_EQUAL(sal_uInt8(0), aBitmapEx.GetAlpha(1, 0));
+}
+
 } // namespace
 
 CPPUNIT_TEST_SUITE_REGISTRATION(BitmapExTest);
@@ -17,10 +17,20 @@
 
 #include <vcl/BitmapBasicMorphologyFilter.hxx>
 #include <vcl/BitmapFilterStackBlur.hxx>
+#include <vcl/BitmapMedianFilter.hxx>
 #include <BitmapSymmetryCheck.hxx>
+#include <bitmap/BitmapFilterPipeline.hxx>
+#include <bitmap/BitmapMedian.hxx>
+#include <bitmap/BitmapParallel.hxx>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <memory>
 #include <string_view>
+#include <vector>
 
 namespace
 {
@@ -39,12 +49,20 @@ public:
     void testBasicMorphology();
     void testPerformance();
     void testGenerateStripRanges();
+    void testParallelForRows();
+    void testMedianFilterParallel();
+    void testMedianFilterRadius();
+    void testFilterPipeline();
 
     CPPUNIT_TEST_SUITE(BitmapFilterTest);
     CPPUNIT_TEST(testBlurCorrectness);
     CPPUNIT_TEST(testBasicMorphology);
     CPPUNIT_TEST(testPerformance);
     CPPUNIT_TEST(testGenerateStripRanges);
+    CPPUNIT_TEST(testParallelForRows);
+    CPPUNIT_TEST(testMedianFilterParallel);
+    CPPUNIT_TEST(testMedianFilterRadius);
+    CPPUNIT_TEST(testFilterPipeline);
     CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -276,6 +294,302 @@ void BitmapFilterTest::testGenerateStripRanges()
     }
 }
 
+void BitmapFilterTest::testParallelForRows()
+{
+    for (sal_Int32 nRows : { 1, 2, 7, 1000 })
+    {
+        for (sal_Int64 nPixelsPerRow : { 1, 100, 100000 })
+        {
+            // every row has to be handed out exactly once, threaded or not
+            for (sal_Int64 nMinPixels : { sal_Int64(0), SAL_MAX_INT64 })
+            {
+                std::unique_ptr<std::atomic<int>[]> pVisits(new std::atomic<int>[nRows]);
+                for (sal_Int32 i = 0; i < nRows; ++i)
+                    pVisits[i] = 0;
+
+                vcl::bitmap::parallelForRows(
+                    nRows, nPixelsPerRow,
+                    [&](sal_Int32 nStart, sal_Int32 nEnd) {
+                        CPPUNIT_ASSERT(nStart <= nEnd);
+                        for (sal_Int32 i = nStart; i <= nEnd; ++i)
+                            ++pVisits[i];
+                    },
+                    nMinPixels);
+
+                for (sal_Int32 i = 0; i < nRows; ++i)
+                    CPPUNIT_ASSERT_EQUAL(1, pVisits[i].load());
+            }
+        }
+    }
+}
+
+void BitmapFilterTest::testMedianFilterParallel()
+{
+    // large enough to be filtered in several strips, the rows at the strip borders
+    // have to see the rows of the neighbouring strips
+    const Size aSize(400, 300);
+    auto aComponents = [](tools::Long nX, tools::Long nY) {
+        return std::array<sal_uInt8, 3>{ sal_uInt8(nX * 7 + nY * 13), sal_uInt8(nX * 3 + nY * 29),
+                                         sal_uInt8(nX * nY) };
+    };
+
+    Bitmap aBitmap(aSize, vcl::PixelFormat::N24_BPP);
+    {
+        BitmapScopedWriteAccess pWriteAccess(aBitmap);
+        for (tools::Long nY = 0; nY < aSize.Height(); ++nY)
+        {
+            for (tools::Long nX = 0; nX < aSize.Width(); ++nX)
+            {
+                const std::array<sal_uInt8, 3> aColor = aComponents(nX, nY);
+                pWriteAccess->SetPixel(nY, nX, BitmapColor(aColor[0], aColor[1], aColor[2]));
+            }
+        }
+    }
+
+    BitmapEx aBitmapEx(aBitmap);
+    CPPUNIT_ASSERT(BitmapFilter::Filter(aBitmapEx, BitmapMedianFilter()));
+
+    Bitmap aResult(aBitmapEx.GetBitmap());
+    Bitmap::ScopedReadAccess pReadAccess(aResult);
+    for (tools::Long nY = 0; nY < aSize.Height(); ++nY)
+    {
+        for (tools::Long nX = 0; nX < aSize.Width(); ++nX)
+        {
+            std::array<std::array<sal_uInt8, 9>, 3> aWindow;
+            int nIndex = 0;
+            for (tools::Long nDY = -1; nDY <= 1; ++nDY)
+            {
+                for (tools::Long nDX = -1; nDX <= 1; ++nDX, ++nIndex)
+                {
+                    const std::array<sal_uInt8, 3> aColor
+                        = aComponents(std::clamp<tools::Long>(nX + nDX, 0, aSize.Width() - 1),
+                                      std::clamp<tools::Long>(nY + nDY, 0, aSize.Height() - 1));
+                    for (int i = 0; i < 3; ++i)
+                        aWindow[i][nIndex] = aColor[i];
+                }
+            }
+            for (auto& rComponent : aWindow)
+                std::nth_element(rComponent.begin(), rComponent.begin() + 4, rComponent.end());
+
+            const BitmapColor aColor = pReadAccess->GetColor(nY, nX);
+            CPPUNIT_ASSERT_EQUAL(aWindow[0][4], aColor.GetRed());
+            CPPUNIT_ASSERT_EQUAL(aWindow[1][4], aColor.GetGreen());
+            CPPUNIT_ASSERT_EQUAL(aWindow[2][4], aColor.GetBlue());
+        }
+    }
+}
+
+void BitmapFilterTest::testMedianFilterRadius()
+{
+    // the histogram median has to give exactly the median of the whole window, also in the
+    // windows reaching beyond the borders and across the tiles and strips it is done in
+    const Size aSize(1100, 90);
+    auto aComponents = [](tools::Long nX, tools::Long nY) {
+        return std::array<sal_uInt8, 3>{ sal_uInt8(nX * 7 + nY * 13), sal_uInt8((nX ^ nY) * 5),
+                                         sal_uInt8(nX * nY) };
+    };
+
+    Bitmap aBitmap24Bit(aSize, vcl::PixelFormat::N24_BPP);
+    Bitmap aBitmapGrey(aSize, vcl::PixelFormat::N8_BPP, &Bitmap::GetGreyPalette(256));
+    {
+        BitmapScopedWriteAccess pWriteAccess24Bit(aBitmap24Bit);
+        BitmapScopedWriteAccess pWriteAccessGrey(aBitmapGrey);
+        for (tools::Long nY = 0; nY < aSize.Height(); ++nY)
+        {
+            for (tools::Long nX = 0; nX < aSize.Width(); ++nX)
+            {
+                const std::array<sal_uInt8, 3> aColor = aComponents(nX, nY);
+                pWriteAccess24Bit->SetPixel(nY, nX,
+                                            BitmapColor(aColor[0], aColor[1], aColor[2]));
+                pWriteAccessGrey->SetPixelIndex(nY, nX, aColor[0]);
+            }
+        }
+    }
+
+    // BitmapMedianFilter itself gives 24 bit for grey bitmaps too, as it always did
+    BitmapEx aFilteredGrey(aBitmapGrey);
+    CPPUNIT_ASSERT(BitmapFilter::Filter(aFilteredGrey, BitmapMedianFilter()));
+    CPPUNIT_ASSERT_EQUAL(vcl::PixelFormat::N24_BPP, aFilteredGrey.getPixelFormat());
+
+    for (sal_Int32 nRadius : { 0, 2, 7 })
+    {
+        Bitmap aResult24Bit(vcl::bitmap::medianFilter(aBitmap24Bit, nRadius));
+        Bitmap aResultGrey(vcl::bitmap::medianFilter(aBitmapGrey, nRadius));
+        CPPUNIT_ASSERT_EQUAL(vcl::PixelFormat::N24_BPP, aResult24Bit.getPixelFormat());
+        CPPUNIT_ASSERT_EQUAL(vcl::PixelFormat::N8_BPP, aResultGrey.getPixelFormat());
+        CPPUNIT_ASSERT(aResultGrey.HasGreyPalette8Bit());
+
+        Bitmap::ScopedReadAccess pReadAccess24Bit(aResult24Bit);
+        Bitmap::ScopedReadAccess pReadAccessGrey(aResultGrey);
+        std::array<std::vector<sal_uInt8>, 3> aWindow;
+        for (tools::Long nY = 0; nY < aSize.Height(); nY += 3)
+        {
+            for (tools::Long nX = 0; nX < aSize.Width(); nX += 5)
+            {
+                for (auto& rComponent : aWindow)
+                    rComponent.clear();
+                for (tools::Long nDY = -nRadius; nDY <= nRadius; ++nDY)
+                {
+                    for (tools::Long nDX = -nRadius; nDX <= nRadius; ++nDX)
+                    {
+                        const std::array<sal_uInt8, 3> aColor = aComponents(
+                            std::clamp<tools::Long>(nX + nDX, 0, aSize.Width() - 1),
+                            std::clamp<tools::Long>(nY + nDY, 0, aSize.Height() - 1));
+                        for (int i = 0; i < 3; ++i)
+                            aWindow[i].push_back(aColor[i]);
+                    }
+                }
+                const size_t nMedian = aWindow[0].size() / 2;
+                for (auto& rComponent : aWindow)
+                    std::nth_element(rComponent.begin(), rComponent.begin() + nMedian,
+                                     rComponent.end());
+
+                const BitmapColor aColor = pReadAccess24Bit->GetColor(nY, nX);
+                CPPUNIT_ASSERT_EQUAL(aWindow[0][nMedian], aColor.GetRed());
+                CPPUNIT_ASSERT_EQUAL(aWindow[1][nMedian], aColor.GetGreen());
+                CPPUNIT_ASSERT_EQUAL(aWindow[2][nMedian], aColor.GetBlue());
+                CPPUNIT_ASSERT_EQUAL(aWindow[0][nMedian], pReadAccessGrey->GetPixelIndex(nY, nX));
+            }
+        }
+    }
+}
+
+// What Bitmap::Adjust() without msoBrightness does to a channel value, worked out on its own
+// rather than through the lookup tables of BitmapFilterPipeline, which Adjust() now uses itself.
+sal_uInt8 adjustChannel(int nValue, int nLuminancePercent, int nContrastPercent,
+                        int nChannelPercent, double fGamma)
+{
+    const double fSlope = nContrastPercent >= 0
+                              ? 128.0 / (128.0 - 1.27 * std::min(nContrastPercent, 100))
+                              : (128.0 + 1.27 * std::max(nContrastPercent, -100)) / 128.0;
+    const double fOffset = std::clamp(nLuminancePercent, -100, 100) * 2.55 + 128.0
+                           - fSlope * 128.0 + nChannelPercent * 2.55;
+    long nResult = std::clamp(std::lround(nValue * fSlope + fOffset), 0L, 255L);
+    if (fGamma != 1.0)
+        nResult = std::clamp(std::lround(std::pow(nResult / 255.0, 1.0 / fGamma) * 255.0), 0L,
+                             255L);
+    return sal_uInt8(nResult);
+}
+
+void BitmapFilterTest::testFilterPipeline()
+{
+    const Size aSize(53, 41);
+    Bitmap aBitmap(aSize, vcl::PixelFormat::N24_BPP);
+    {
+        BitmapScopedWriteAccess pWriteAccess(aBitmap);
+        for (tools::Long nY = 0; nY < aSize.Height(); ++nY)
+            for (tools::Long nX = 0; nX < aSize.Width(); ++nX)
+                pWriteAccess->SetPixel(
+                    nY, nX, BitmapColor(sal_uInt8(nX * 5), sal_uInt8(nY * 6), sal_uInt8(nX * nY)));
+    }
+
+    auto aGrey = [](Bitmap& rBitmap) {
+        BitmapScopedWriteAccess pWriteAccess(rBitmap);
+        for (tools::Long nY = 0; nY < pWriteAccess->Height(); ++nY)
+        {
+            for (tools::Long nX = 0; nX < pWriteAccess->Width(); ++nX)
+            {
+                const sal_uInt8 nLuminance = pWriteAccess->GetColor(nY, nX).GetLuminance();
+                pWriteAccess->SetPixel(nY, nX, BitmapColor(nLuminance, nLuminance, nLuminance));
+            }
+        }
+    };
+    auto aAdjust = [](Bitmap& rBitmap, int nLuminancePercent, int nContrastPercent,
+                      int nRedPercent, int nGreenPercent, int nBluePercent, double fGamma) {
+        BitmapScopedWriteAccess pWriteAccess(rBitmap);
+        for (tools::Long nY = 0; nY < pWriteAccess->Height(); ++nY)
+        {
+            for (tools::Long nX = 0; nX < pWriteAccess->Width(); ++nX)
+            {
+                const BitmapColor aColor = pWriteAccess->GetColor(nY, nX);
+                pWriteAccess->SetPixel(
+                    nY, nX,
+                    BitmapColor(adjustChannel(aColor.GetRed(), nLuminancePercent,
+                                              nContrastPercent, nRedPercent, fGamma),
+                                adjustChannel(aColor.GetGreen(), nLuminancePercent,
+                                              nContrastPercent, nGreenPercent, fGamma),
+                                adjustChannel(aColor.GetBlue(), nLuminancePercent,
+                                              nContrastPercent, nBluePercent, fGamma)));
+            }
+        }
+    };
+    auto aInvertColors = [](Bitmap& rBitmap) {
+        BitmapScopedWriteAccess pWriteAccess(rBitmap);
+        for (tools::Long nY = 0; nY < pWriteAccess->Height(); ++nY)
+        {
+            for (tools::Long nX = 0; nX < pWriteAccess->Width(); ++nX)
+            {
+                const BitmapColor aColor = pWriteAccess->GetColor(nY, nX);
+                pWriteAccess->SetPixel(nY, nX,
+                                       BitmapColor(255 - aColor.GetRed(), 255 - aColor.GetGreen(),
+                                                   255 - aColor.GetBlue()));
+            }
+        }
+    };
+    auto aCompare = [](const Bitmap& rExpected, const Bitmap& rActual) {
+        CPPUNIT_ASSERT_EQUAL(rExpected.GetSizePixel(), rActual.GetSizePixel());
+        Bitmap::ScopedReadAccess pExpected(const_cast<Bitmap&>(rExpected));
+        Bitmap::ScopedReadAccess pActual(const_cast<Bitmap&>(rActual));
+        for (tools::Long nY = 0; nY < pExpected->Height(); ++nY)
+            for (tools::Long nX = 0; nX < pExpected->Width(); ++nX)
+                CPPUNIT_ASSERT_EQUAL(pExpected->GetColor(nY, nX), pActual->GetColor(nY, nX));
+    };
+
+    vcl::bitmap::ChannelTable aInvert;
+    for (int i = 0; i < 256; i++)
+        aInvert[i] = 255 - i;
+
+    // two tables become one, the same as running them one after the other
+    {
+        vcl::bitmap::BitmapFilterPipeline aPipeline;
+        aPipeline.Adjust(10, 30, 0, 5, 0, 1.5, false, false).Lookup(aInvert);
+        CPPUNIT_ASSERT_EQUAL(size_t(1), aPipeline.GetStageCount());
+        CPPUNIT_ASSERT(aPipeline.IsPointwise());
+
+        Bitmap aExpected(aBitmap);
+        aAdjust(aExpected, 10, 30, 0, 5, 0, 1.5);
+        aInvertColors(aExpected);
+
+        Bitmap aActual(aBitmap);
+        CPPUNIT_ASSERT(aPipeline.Apply(aActual));
+        aCompare(aExpected, aActual);
+        aCompare(aExpected, aPipeline.execute(BitmapEx(aBitmap)).GetBitmap());
+    }
+
+    // greying twice is greying once, and stays between the tables
+    {
+        vcl::bitmap::BitmapFilterPipeline aPipeline;
+        aPipeline.Adjust(-20, 0, 0, 0, 0, 1.0, false, false).Grey().Grey().Lookup(aInvert);
+        CPPUNIT_ASSERT_EQUAL(size_t(3), aPipeline.GetStageCount());
+
+        Bitmap aExpected(aBitmap);
+        aAdjust(aExpected, -20, 0, 0, 0, 0, 1.0);
+        aGrey(aExpected);
+        aInvertColors(aExpected);
+
+        Bitmap aActual(aBitmap);
+        CPPUNIT_ASSERT(aPipeline.Apply(aActual));
+        aCompare(aExpected, aActual);
+    }
+
+    // a neighbourhood filter runs on its own, between the pointwise passes
+    {
+        vcl::bitmap::BitmapFilterPipeline aPipeline;
+        aPipeline.Grey().Filter(std::make_shared<BitmapMedianFilter>()).Lookup(aInvert);
+        CPPUNIT_ASSERT(!aPipeline.IsPointwise());
+        Bitmap aUnchanged(aBitmap);
+        CPPUNIT_ASSERT(!aPipeline.Apply(aUnchanged));
+
+        Bitmap aGreyBitmap(aBitmap);
+        aGrey(aGreyBitmap);
+        BitmapEx aExpected(aGreyBitmap);
+        CPPUNIT_ASSERT(BitmapFilter::Filter(aExpected, BitmapMedianFilter()));
+        CPPUNIT_ASSERT(aExpected.Invert());
+
+        aCompare(aExpected.GetBitmap(), aPipeline.execute(BitmapEx(aBitmap)).GetBitmap());
+    }
+}
+
 } // namespace
 
 CPPUNIT_TEST_SUITE_REGISTRATION(BitmapFilterTest);
@@ -17,6 +17,7 @@
 #include <vcl/graphicfilter.hxx>
 
 #include <BitmapSymmetryCheck.hxx>
+#include <bitmap/BitmapScaleConvolutionFilter.hxx>
 #include <bitmap/BitmapWriteAccess.hxx>
 
 namespace
@@ -26,11 +27,13 @@ class BitmapScaleTest : public CppUnit::TestFixture
     void testScale();
     void testScale2();
     void testScaleSymmetry();
+    void testScaleConvolutionFormats();
 
     CPPUNIT_TEST_SUITE(BitmapScaleTest);
     CPPUNIT_TEST(testScale);
     CPPUNIT_TEST(testScale2);
     CPPUNIT_TEST(testScaleSymmetry);
+    CPPUNIT_TEST(testScaleConvolutionFormats);
     CPPUNIT_TEST_SUITE_END();
 };
 
@@ -305,6 +308,56 @@ void BitmapScaleTest::testScaleSymmetry()
     }
 }
 
+void BitmapScaleTest::testScaleConvolutionFormats()
+{
+    // The convolution scalers work on 24 bit rows, other source formats get converted
+    // first. Both must give the same result, also when the weight tables come from the cache.
+    const Size aSize(600, 400);
+    Bitmap aBitmap24Bit(aSize, vcl::PixelFormat::N24_BPP);
+    Bitmap aBitmap32Bit(aSize, vcl::PixelFormat::N32_BPP);
+    {
+        BitmapScopedWriteAccess pWriteAccess24Bit(aBitmap24Bit);
+        BitmapScopedWriteAccess pWriteAccess32Bit(aBitmap32Bit);
+        for (tools::Long y = 0; y < aSize.Height(); ++y)
+        {
+            for (tools::Long x = 0; x < aSize.Width(); ++x)
+            {
+                const BitmapColor aColor(sal_uInt8(x * 7 + y * 3), sal_uInt8((x / 5) * (y / 7)),
+                                         (x / 16 + y / 16) % 2 ? 255 : 0);
+                pWriteAccess24Bit->SetPixel(y, x, aColor);
+                pWriteAccess32Bit->SetPixel(y, x, aColor);
+            }
+        }
+    }
+
+    // horizontal pass first, vertical pass first, and only one of them
+    const std::pair<double, double> aScales[]
+        = { { 0.3, 0.9 }, { 0.9, 0.3 }, { 1.7, 0.6 }, { 1.0, 2.5 }, { 0.3, 0.9 } };
+    for (const auto& [ fScaleX, fScaleY ] : aScales)
+    {
+        BitmapEx aResult24Bit(aBitmap24Bit);
+        BitmapEx aResult32Bit(aBitmap32Bit);
+        CPPUNIT_ASSERT(
+            BitmapFilter::Filter(aResult24Bit, vcl::BitmapScaleLanczos3Filter(fScaleX, fScaleY)));
+        CPPUNIT_ASSERT(
+            BitmapFilter::Filter(aResult32Bit, vcl::BitmapScaleLanczos3Filter(fScaleX, fScaleY)));
+        CPPUNIT_ASSERT_EQUAL(aResult24Bit.GetSizePixel(), aResult32Bit.GetSizePixel());
+
+        Bitmap aScaled24Bit(aResult24Bit.GetBitmap());
+        Bitmap aScaled32Bit(aResult32Bit.GetBitmap());
+        Bitmap::ScopedReadAccess pReadAccess24Bit(aScaled24Bit);
+        Bitmap::ScopedReadAccess pReadAccess32Bit(aScaled32Bit);
+        for (tools::Long y = 0; y < pReadAccess24Bit->Height(); ++y)
+        {
+            for (tools::Long x = 0; x < pReadAccess24Bit->Width(); ++x)
+            {
+                CPPUNIT_ASSERT_EQUAL(pReadAccess24Bit->GetColor(y, x).GetRGBColor(),
+                                     pReadAccess32Bit->GetColor(y, x).GetRGBColor());
+            }
+        }
+    }
+}
+
 } // namespace
 
 CPPUNIT_TEST_SUITE_REGISTRATION(BitmapScaleTest);
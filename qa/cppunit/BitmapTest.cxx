@@ -17,16 +17,27 @@
 
 #include <vcl/BitmapTools.hxx>
 #include <vcl/bitmap.hxx>
+#include <vcl/checksum.hxx>
+#include <vcl/gdimtf.hxx>
+#include <vcl/metaact.hxx>
 #include <vcl/virdev.hxx>
 #include <vcl/skia/SkiaHelper.hxx>
+#include <vcl/BitmapColorQuantizationFilter.hxx>
 #include <vcl/BitmapMonochromeFilter.hxx>
 
+#include <bitmap/BitmapBufferPool.hxx>
+#include <bitmap/BitmapDitheredColorQuantizationFilter.hxx>
+#include <bitmap/BitmapRegionAccess.hxx>
 #include <bitmap/BitmapWriteAccess.hxx>
 #include <bitmap/Octree.hxx>
+#include <bitmap/WuQuantizer.hxx>
+#include <bitmap/impvect.hxx>
 #include <salinst.hxx>
 #include <svdata.hxx>
 
+#include <cstdlib>
 #include <unordered_map>
+#include <vector>
 
 namespace
 {
@@ -38,16 +49,22 @@ class BitmapTest : public CppUnit::TestFixture
     void testN8Greyscale();
     void testConvert();
     void testCRC();
+    void testCRC64();
     void testGreyPalette();
     void testCustom8BitPalette();
     void testErase();
     void testBitmap32();
     void testOctree();
+    void testWuQuantizer();
+    void testVectorize();
+    void testBitmapBufferPool();
+    void testBitmapRegionAccess();
     void testEmptyAccess();
     void testDitherSize();
     void testMirror();
     void testCrop();
     void testCroppedDownsampledBitmap();
+    void testPaletteBestIndex();
 
     CPPUNIT_TEST_SUITE(BitmapTest);
     CPPUNIT_TEST(testCreation);
@@ -56,16 +73,22 @@ class BitmapTest : public CppUnit::TestFixture
     CPPUNIT_TEST(testConvert);
     CPPUNIT_TEST(testN8Greyscale);
     CPPUNIT_TEST(testCRC);
+    CPPUNIT_TEST(testCRC64);
     CPPUNIT_TEST(testGreyPalette);
     CPPUNIT_TEST(testCustom8BitPalette);
     CPPUNIT_TEST(testErase);
     CPPUNIT_TEST(testBitmap32);
     CPPUNIT_TEST(testOctree);
+    CPPUNIT_TEST(testWuQuantizer);
+    CPPUNIT_TEST(testVectorize);
+    CPPUNIT_TEST(testBitmapBufferPool);
+    CPPUNIT_TEST(testBitmapRegionAccess);
     CPPUNIT_TEST(testEmptyAccess);
     CPPUNIT_TEST(testDitherSize);
     CPPUNIT_TEST(testMirror);
     CPPUNIT_TEST(testCrop);
     CPPUNIT_TEST(testCroppedDownsampledBitmap);
+    CPPUNIT_TEST(testPaletteBestIndex);
     CPPUNIT_TEST_SUITE_END();
 };
 
@@ -391,6 +414,29 @@ void BitmapTest::testCRC()
     checkAndInsert(aCRCs, aChecker, "inverted checkerboard");
 }
 
+void BitmapTest::testCRC64()
+{
+    // vcl_crc64 works on eight bytes at a time for longer data, it has to stay
+    // identical to the plain table driven CRC for every length and alignment
+    const sal_uInt64* pTable = vcl_get_crc64_table();
+    std::vector<sal_uInt8> aData(300);
+    for (size_t i = 0; i < aData.size(); ++i)
+        aData[i] = sal_uInt8(i * 131 + 17);
+
+    for (sal_uInt32 nOffset = 0; nOffset < 8; ++nOffset)
+    {
+        for (sal_uInt32 nLength = 0; nLength + nOffset <= aData.size(); nLength += 13)
+        {
+            sal_uInt64 nExpected = ~sal_uInt64(42);
+            for (sal_uInt32 i = 0; i < nLength; ++i)
+                nExpected = pTable[(nExpected ^ aData[nOffset + i]) & 0xff] ^ (nExpected >> 8);
+            nExpected = ~nExpected;
+
+            CPPUNIT_ASSERT_EQUAL(nExpected, vcl_crc64(42, aData.data() + nOffset, nLength));
+        }
+    }
+}
+
 void BitmapTest::testGreyPalette()
 {
     {
@@ -577,6 +623,399 @@ void BitmapTest::testOctree()
     }
 }
 
+void BitmapTest::testWuQuantizer()
+{
+    // the same gradient as in testOctree
+    Size aSize(1000, 100);
+    Bitmap aBitmap(aSize, vcl::PixelFormat::N24_BPP);
+    {
+        BitmapScopedWriteAccess pWriteAccess(aBitmap);
+        for (tools::Long y = 0; y < aSize.Height(); ++y)
+        {
+            for (tools::Long x = 0; x < aSize.Width(); ++x)
+            {
+                double fPercent = double(x) / double(aSize.Width());
+                pWriteAccess->SetPixel(y, x,
+                                       BitmapColor(255.0 * fPercent, 64.0 + (128.0 * fPercent),
+                                                   255.0 - 255.0 * fPercent));
+            }
+        }
+    }
+
+    Bitmap::ScopedReadAccess pAccess(aBitmap);
+
+    // the mean squared error per pixel of a palette and a way of mapping colors into it
+    auto meanError = [&pAccess](const BitmapPalette& rPalette, auto aBestIndex) {
+        double fError = 0.0;
+        for (tools::Long y = 0; y < pAccess->Height(); ++y)
+        {
+            for (tools::Long x = 0; x < pAccess->Width(); ++x)
+            {
+                const BitmapColor aColor = pAccess->GetPixel(y, x);
+                const BitmapColor& rMapped = rPalette[aBestIndex(aColor)];
+                const double fRed = aColor.GetRed() - rMapped.GetRed();
+                const double fGreen = aColor.GetGreen() - rMapped.GetGreen();
+                const double fBlue = aColor.GetBlue() - rMapped.GetBlue();
+                fError += fRed * fRed + fGreen * fGreen + fBlue * fBlue;
+            }
+        }
+        return fError / (pAccess->Width() * pAccess->Height());
+    };
+
+    {
+        // Reduce to 1 color, the mean of all
+        WuQuantizer aQuantizer(*pAccess, 1);
+        const BitmapPalette& rPalette = aQuantizer.GetPalette();
+        CPPUNIT_ASSERT_EQUAL(sal_uInt16(1), rPalette.GetEntryCount());
+        CPPUNIT_ASSERT_EQUAL(BitmapColor(0x7f, 0x7f, 0x80), rPalette[0]);
+    }
+
+    for (sal_uInt16 nColors : { 4, 16, 64 })
+    {
+        // Wu's boxes have to fit the gradient better than the octree, whose palette entries
+        // follow the fixed subdivision of the color cube
+        WuQuantizer aQuantizer(*pAccess, nColors);
+        const BitmapPalette& rPalette = aQuantizer.GetPalette();
+        CPPUNIT_ASSERT_EQUAL(nColors, rPalette.GetEntryCount());
+
+        Octree aOctree(*pAccess, nColors);
+        const BitmapPalette& rOctreePalette = aOctree.GetPalette();
+        InverseColorMap aColorMap(rOctreePalette);
+
+        const double fError = meanError(rPalette, [&](const BitmapColor& rColor) {
+            return aQuantizer.GetBestPaletteIndex(rColor);
+        });
+        const double fOctreeError = meanError(rOctreePalette, [&](const BitmapColor& rColor) {
+            return aColorMap.GetBestPaletteIndex(rColor);
+        });
+        CPPUNIT_ASSERT_LESS(fOctreeError, fError);
+    }
+
+    {
+        // Only the 74 colors of the 32 levels per channel the gradient uses are needed
+        WuQuantizer aQuantizer(*pAccess, 256);
+        CPPUNIT_ASSERT_EQUAL(sal_uInt16(74), aQuantizer.GetPalette().GetEntryCount());
+    }
+
+    for (QuantizationDither eDither :
+         { QuantizationDither::None, QuantizationDither::FloydSteinberg,
+           QuantizationDither::Ordered })
+    {
+        WuQuantizer aQuantizer(*pAccess, 16);
+        const BitmapPalette& rPalette = aQuantizer.GetPalette();
+        Bitmap aQuantized(aSize, vcl::PixelFormat::N8_BPP, &rPalette);
+        {
+            BitmapScopedWriteAccess pWriteAccess(aQuantized);
+            aQuantizer.Map(*pAccess, *pWriteAccess, eDither);
+        }
+
+        // every pixel has to get one of the palette colors, and on average a close one
+        Bitmap::ScopedReadAccess pQuantizedAccess(aQuantized);
+        double fError = 0.0;
+        for (tools::Long y = 0; y < aSize.Height(); ++y)
+        {
+            for (tools::Long x = 0; x < aSize.Width(); ++x)
+            {
+                const sal_uInt8 nIndex = pQuantizedAccess->GetPixelIndex(y, x);
+                CPPUNIT_ASSERT_LESS(sal_uInt8(rPalette.GetEntryCount()), nIndex);
+                const BitmapColor aColor = pAccess->GetPixel(y, x);
+                fError += std::abs(aColor.GetRed() - rPalette[nIndex].GetRed())
+                          + std::abs(aColor.GetGreen() - rPalette[nIndex].GetGreen())
+                          + std::abs(aColor.GetBlue() - rPalette[nIndex].GetBlue());
+            }
+        }
+        CPPUNIT_ASSERT_LESS(24.0, fError / (aSize.Width() * aSize.Height()));
+    }
+
+    {
+        // A mid gray mapped to a black and white palette: without dithering every pixel gets
+        // the same entry, with dithering they get mixed about evenly
+        const Size aSmallSize(32, 32);
+        Bitmap aBlackWhite(aSmallSize, vcl::PixelFormat::N24_BPP);
+        {
+            BitmapScopedWriteAccess pWriteAccess(aBlackWhite);
+            pWriteAccess->Erase(COL_BLACK);
+            pWriteAccess->SetFillColor(COL_WHITE);
+            pWriteAccess->FillRect(tools::Rectangle(Point(16, 0), Size(16, 32)));
+        }
+        Bitmap::ScopedReadAccess pBlackWhiteAccess(aBlackWhite);
+        WuQuantizer aQuantizer(*pBlackWhiteAccess, 2);
+        const BitmapPalette& rPalette = aQuantizer.GetPalette();
+        CPPUNIT_ASSERT_EQUAL(sal_uInt16(2), rPalette.GetEntryCount());
+
+        Bitmap aGray(aSmallSize, vcl::PixelFormat::N24_BPP);
+        {
+            BitmapScopedWriteAccess pWriteAccess(aGray);
+            pWriteAccess->Erase(Color(0x80, 0x80, 0x80));
+        }
+        Bitmap::ScopedReadAccess pGrayAccess(aGray);
+
+        for (QuantizationDither eDither :
+             { QuantizationDither::None, QuantizationDither::FloydSteinberg,
+               QuantizationDither::Ordered })
+        {
+            Bitmap aQuantized(aSmallSize, vcl::PixelFormat::N8_BPP, &rPalette);
+            {
+                BitmapScopedWriteAccess pWriteAccess(aQuantized);
+                aQuantizer.Map(*pGrayAccess, *pWriteAccess, eDither);
+            }
+
+            Bitmap::ScopedReadAccess pQuantizedAccess(aQuantized);
+            sal_Int32 nWhite = 0;
+            for (tools::Long y = 0; y < aSmallSize.Height(); ++y)
+                for (tools::Long x = 0; x < aSmallSize.Width(); ++x)
+                    if (rPalette[pQuantizedAccess->GetPixelIndex(y, x)] == COL_WHITE)
+                        ++nWhite;
+
+            if (eDither == QuantizationDither::None)
+                CPPUNIT_ASSERT(nWhite == 0 || nWhite == 32 * 32);
+            else
+            {
+                CPPUNIT_ASSERT_GREATER(sal_Int32(32 * 32 * 3 / 8), nWhite);
+                CPPUNIT_ASSERT_LESS(sal_Int32(32 * 32 * 5 / 8), nWhite);
+            }
+        }
+    }
+
+    // the quantization filters only dither when asked to: on a horizontal gradient reduced to
+    // two colors, the columns stay of one color each without dithering
+    {
+        const Size aGradientSize(64, 16);
+        Bitmap aGradient(aGradientSize, vcl::PixelFormat::N24_BPP);
+        {
+            BitmapScopedWriteAccess pWriteAccess(aGradient);
+            for (tools::Long y = 0; y < aGradientSize.Height(); ++y)
+                for (tools::Long x = 0; x < aGradientSize.Width(); ++x)
+                    pWriteAccess->SetPixel(y, x, Color(x * 4, x * 4, x * 4));
+        }
+        const auto countMixedColumns = [&aGradientSize](const BitmapEx& rBitmapEx) {
+            Bitmap aBitmap(rBitmapEx.GetBitmap());
+            Bitmap::ScopedReadAccess pAccess(aBitmap);
+            sal_Int32 nMixed = 0;
+            for (tools::Long x = 0; x < aGradientSize.Width(); ++x)
+            {
+                for (tools::Long y = 1; y < aGradientSize.Height(); ++y)
+                {
+                    if (pAccess->GetColor(y, x) != pAccess->GetColor(0, x))
+                    {
+                        ++nMixed;
+                        break;
+                    }
+                }
+            }
+            return nMixed;
+        };
+
+        BitmapEx aPlain(aGradient);
+        CPPUNIT_ASSERT(BitmapFilter::Filter(aPlain, BitmapColorQuantizationFilter(2)));
+        CPPUNIT_ASSERT_EQUAL(sal_Int32(0), countMixedColumns(aPlain));
+
+        for (QuantizationDither eDither :
+             { QuantizationDither::FloydSteinberg, QuantizationDither::Ordered })
+        {
+            BitmapEx aDithered(aGradient);
+            CPPUNIT_ASSERT(
+                BitmapFilter::Filter(aDithered, BitmapDitheredColorQuantizationFilter(2, eDither)));
+            CPPUNIT_ASSERT_EQUAL(vcl::PixelFormat::N8_BPP, aDithered.getPixelFormat());
+            CPPUNIT_ASSERT_GREATER(sal_Int32(aGradientSize.Width() / 4),
+                                   countMixedColumns(aDithered));
+        }
+    }
+}
+
+void BitmapTest::testVectorize()
+{
+    // a red rectangle and a blue disc on white
+    BitmapPalette aPalette;
+    aPalette.SetEntryCount(3);
+    aPalette[0] = BitmapColor(COL_WHITE);
+    aPalette[1] = BitmapColor(COL_LIGHTRED);
+    aPalette[2] = BitmapColor(COL_LIGHTBLUE);
+    Bitmap aBitmap(Size(120, 90), vcl::PixelFormat::N8_BPP, &aPalette);
+    {
+        BitmapScopedWriteAccess pAccess(aBitmap);
+        for (tools::Long y = 0; y < 90; ++y)
+        {
+            for (tools::Long x = 0; x < 120; ++x)
+            {
+                sal_uInt8 nIndex = 0;
+                if (x >= 10 && x < 50 && y >= 10 && y < 40)
+                    nIndex = 1;
+                else if ((x - 85) * (x - 85) + (y - 55) * (y - 55) < 25 * 25)
+                    nIndex = 2;
+                pAccess->SetPixelIndex(y, x, nIndex);
+            }
+        }
+    }
+
+    // the colors are traced in parallel, but put into the metafile from light to dark
+    GDIMetaFile aFirst;
+    aBitmap.Vectorize(aFirst, 0, nullptr);
+    std::vector<Color> aFillColors;
+    std::vector<const tools::PolyPolygon*> aPolyPolygons;
+    for (size_t i = 0; i < aFirst.GetActionSize(); ++i)
+    {
+        const MetaAction* pAction = aFirst.GetAction(i);
+        if (pAction->GetType() == MetaActionType::FILLCOLOR)
+            aFillColors.push_back(static_cast<const MetaFillColorAction*>(pAction)->GetColor());
+        else if (pAction->GetType() == MetaActionType::POLYPOLYGON)
+            aPolyPolygons.push_back(
+                &static_cast<const MetaPolyPolygonAction*>(pAction)->GetPolyPolygon());
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t(3), aFillColors.size());
+    CPPUNIT_ASSERT_EQUAL(COL_WHITE, aFillColors[0]);
+    CPPUNIT_ASSERT_EQUAL(COL_LIGHTRED, aFillColors[1]);
+    CPPUNIT_ASSERT_EQUAL(COL_LIGHTBLUE, aFillColors[2]);
+    CPPUNIT_ASSERT_EQUAL(size_t(3), aPolyPolygons.size());
+    for (const tools::PolyPolygon* pPolyPolygon : aPolyPolygons)
+        CPPUNIT_ASSERT(pPolyPolygon->Count() > 0);
+
+    // and the result does not depend on which thread traced which color
+    for (int nRun = 0; nRun < 4; ++nRun)
+    {
+        GDIMetaFile aAgain;
+        aBitmap.Vectorize(aAgain, 0, nullptr);
+        CPPUNIT_ASSERT_EQUAL(aFirst.GetActionSize(), aAgain.GetActionSize());
+        size_t nPolyPolygon = 0;
+        for (size_t i = 0; i < aAgain.GetActionSize(); ++i)
+        {
+            const MetaAction* pAction = aAgain.GetAction(i);
+            CPPUNIT_ASSERT_EQUAL(int(aFirst.GetAction(i)->GetType()), int(pAction->GetType()));
+            if (pAction->GetType() == MetaActionType::POLYPOLYGON)
+                CPPUNIT_ASSERT(
+                    bool(*aPolyPolygons[nPolyPolygon++]
+                         == static_cast<const MetaPolyPolygonAction*>(pAction)->GetPolyPolygon()));
+        }
+    }
+
+    // a tolerance simplifies the staircase outline of the disc, and no tolerance gives what
+    // Vectorize() gives
+    auto countPoints = [](const GDIMetaFile& rMtf) {
+        std::vector<sal_uInt32> aPoints;
+        for (size_t i = 0; i < rMtf.GetActionSize(); ++i)
+        {
+            const MetaAction* pAction = rMtf.GetAction(i);
+            if (pAction->GetType() != MetaActionType::POLYPOLYGON)
+                continue;
+            const tools::PolyPolygon& rPolyPolygon
+                = static_cast<const MetaPolyPolygonAction*>(pAction)->GetPolyPolygon();
+            sal_uInt32 nPoints = 0;
+            for (sal_uInt16 j = 0; j < rPolyPolygon.Count(); ++j)
+                nPoints += rPolyPolygon[j].GetSize();
+            aPoints.push_back(nPoints);
+        }
+        return aPoints;
+    };
+    GDIMetaFile aExact;
+    CPPUNIT_ASSERT(ImplVectorizer::ImplVectorize(aBitmap, aExact, 0, nullptr));
+    const std::vector<sal_uInt32> aExactPoints = countPoints(aExact);
+    CPPUNIT_ASSERT(bool(countPoints(aFirst) == aExactPoints));
+
+    GDIMetaFile aSimplified;
+    CPPUNIT_ASSERT(ImplVectorizer::ImplVectorize(aBitmap, aSimplified, 0, nullptr, 1.5));
+    const std::vector<sal_uInt32> aSimplifiedPoints = countPoints(aSimplified);
+    CPPUNIT_ASSERT_EQUAL(size_t(3), aSimplifiedPoints.size());
+    CPPUNIT_ASSERT_LESS(aExactPoints[2], aSimplifiedPoints[2]);
+}
+
+void BitmapTest::testBitmapBufferPool()
+{
+    using vcl::bitmap::BitmapBufferPool;
+
+    // within a quarter of a power of two
+    CPPUNIT_ASSERT_EQUAL(size_t(1000), BitmapBufferPool::getSizeClass(1000));
+    CPPUNIT_ASSERT_EQUAL(size_t(262144), BitmapBufferPool::getSizeClass(262144));
+    CPPUNIT_ASSERT_EQUAL(size_t(327680), BitmapBufferPool::getSizeClass(262145));
+    CPPUNIT_ASSERT_EQUAL(size_t(327680), BitmapBufferPool::getSizeClass(300000));
+
+    BitmapBufferPool aPool(1024 * 1024);
+
+    // a released buffer is handed out again for the same size class
+    sal_uInt8* pBuffer = aPool.Allocate(300000);
+    CPPUNIT_ASSERT(pBuffer);
+    pBuffer[299999] = 1;
+    aPool.Release(pBuffer, 300000);
+    CPPUNIT_ASSERT_EQUAL(size_t(327680), aPool.GetCachedBytes());
+    CPPUNIT_ASSERT_EQUAL(pBuffer, aPool.Allocate(290000));
+    CPPUNIT_ASSERT_EQUAL(size_t(0), aPool.GetCachedBytes());
+    aPool.Release(pBuffer, 290000);
+
+    // small buffers are not kept
+    aPool.Release(aPool.Allocate(1000), 1000);
+    CPPUNIT_ASSERT_EQUAL(size_t(327680), aPool.GetCachedBytes());
+
+    // no more than the limit is kept
+    std::vector<sal_uInt8*> aBuffers;
+    for (int i = 0; i < 4; i++)
+        aBuffers.push_back(aPool.Allocate(600000));
+    for (sal_uInt8* p : aBuffers)
+        aPool.Release(p, 600000);
+    CPPUNIT_ASSERT_EQUAL(size_t(655360), aPool.GetCachedBytes());
+
+    aPool.Trim();
+    CPPUNIT_ASSERT_EQUAL(size_t(0), aPool.GetCachedBytes());
+}
+
+void BitmapTest::testBitmapRegionAccess()
+{
+    auto aColor = [](tools::Long nX, tools::Long nY) {
+        return BitmapColor(sal_uInt8(nX * 10), sal_uInt8(nY * 10), 7);
+    };
+    Bitmap aBitmap(Size(20, 15), vcl::PixelFormat::N24_BPP);
+    {
+        BitmapScopedWriteAccess pWriteAccess(aBitmap);
+        for (tools::Long nY = 0; nY < 15; ++nY)
+            for (tools::Long nX = 0; nX < 20; ++nX)
+                pWriteAccess->SetPixel(nY, nX, aColor(nX, nY));
+    }
+
+    // coordinates are relative to the region, which is clipped to the bitmap
+    {
+        vcl::bitmap::BitmapRegionAccess aAccess(aBitmap,
+                                                tools::Rectangle(Point(15, 4), Size(9, 3)));
+        CPPUNIT_ASSERT(aAccess);
+        CPPUNIT_ASSERT_EQUAL(tools::Long(5), aAccess.Width());
+        CPPUNIT_ASSERT_EQUAL(tools::Long(3), aAccess.Height());
+        for (tools::Long nY = 0; nY < aAccess.Height(); ++nY)
+            for (tools::Long nX = 0; nX < aAccess.Width(); ++nX)
+                CPPUNIT_ASSERT_EQUAL(aColor(nX + 15, nY + 4), aAccess.GetColor(nY, nX));
+    }
+
+    // writing changes only the region
+    {
+        vcl::bitmap::BitmapRegionAccess aAccess(aBitmap, tools::Rectangle(Point(2, 3), Size(4, 5)),
+                                                BitmapAccessMode::Write);
+        CPPUNIT_ASSERT(aAccess);
+        for (tools::Long nY = 0; nY < aAccess.Height(); ++nY)
+            for (tools::Long nX = 0; nX < aAccess.Width(); ++nX)
+                aAccess.SetPixel(nY, nX, BitmapColor(COL_WHITE));
+    }
+    {
+        Bitmap::ScopedReadAccess pReadAccess(aBitmap);
+        for (tools::Long nY = 0; nY < 15; ++nY)
+        {
+            for (tools::Long nX = 0; nX < 20; ++nX)
+            {
+                const bool bInside = nX >= 2 && nX < 6 && nY >= 3 && nY < 8;
+                CPPUNIT_ASSERT_EQUAL(bInside ? BitmapColor(COL_WHITE) : aColor(nX, nY),
+                                     pReadAccess->GetColor(nY, nX));
+            }
+        }
+    }
+
+    // palette bitmaps give the palette colors
+    Bitmap aPaletteBitmap(Size(8, 8), vcl::PixelFormat::N8_BPP, &Bitmap::GetGreyPalette(256));
+    aPaletteBitmap.Erase(COL_GRAY);
+    vcl::bitmap::BitmapRegionAccess aAccess(aPaletteBitmap,
+                                            tools::Rectangle(Point(1, 1), Size(2, 2)));
+    CPPUNIT_ASSERT(aAccess);
+    CPPUNIT_ASSERT_EQUAL(BitmapColor(COL_GRAY), aAccess.GetColor(1, 1));
+
+    // nothing to access outside of the bitmap
+    CPPUNIT_ASSERT(!vcl::bitmap::BitmapRegionAccess(
+        aBitmap, tools::Rectangle(Point(30, 30), Size(2, 2))));
+}
+
 void BitmapTest::testEmptyAccess()
 {
     Bitmap empty;
@@ -730,6 +1169,48 @@ void BitmapTest::testCrop()
         CPPUNIT_ASSERT_EQUAL(Size(10, 10), aCroppedBmp.GetSizePixel());
     }
 }
+
+void BitmapTest::testPaletteBestIndex()
+{
+    // irregular palette with duplicates, so that ties are resolved by the lowest index
+    BitmapPalette aPalette(256);
+    for (sal_uInt16 i = 0; i < 256; i++)
+        aPalette[i] = BitmapColor(sal_uInt8(i * 37 + 11), sal_uInt8(i * 101), sal_uInt8(i * 13 + 200));
+    aPalette[200] = aPalette[100];
+
+    const BitmapPalette& rPalette = aPalette;
+    auto aLinearSearch = [&rPalette](const BitmapColor& rCol) {
+        sal_uInt16 nBest = 0;
+        sal_uInt16 nBestErr = SAL_MAX_UINT16;
+        for (sal_uInt16 i = 0; i < rPalette.GetEntryCount(); i++)
+        {
+            if (rCol.GetColorError(rPalette[i]) < nBestErr)
+            {
+                nBestErr = rCol.GetColorError(rPalette[i]);
+                nBest = i;
+            }
+        }
+        return nBest;
+    };
+
+    // enough lookups for the palette to switch from linear search to its inverse map
+    for (int nRed = 0; nRed < 256; nRed += 5)
+    {
+        for (int nGreen = 0; nGreen < 256; nGreen += 7)
+        {
+            for (int nBlue = 0; nBlue < 256; nBlue += 9)
+            {
+                const BitmapColor aColor(nRed, nGreen, nBlue);
+                CPPUNIT_ASSERT_EQUAL(aLinearSearch(aColor), rPalette.GetBestIndex(aColor));
+            }
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL(sal_uInt16(100), rPalette.GetBestIndex(rPalette[200]));
+
+    // changing an entry must not leave a stale map behind
+    aPalette[5] = BitmapColor(1, 2, 3);
+    CPPUNIT_ASSERT_EQUAL(sal_uInt16(5), rPalette.GetBestIndex(BitmapColor(1, 2, 3)));
+}
 } // namespace
 
 CPPUNIT_TEST_SUITE_REGISTRATION(BitmapTest);
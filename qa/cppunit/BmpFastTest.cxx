@@ -0,0 +1,185 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <bitmap/bmpfastsimd.hxx>
+
+#include <vector>
+
+namespace
+{
+constexpr ScanlineFormat aTrueColorFormats[]
+    = { ScanlineFormat::N8BitPal,     ScanlineFormat::N24BitTcBgr,  ScanlineFormat::N24BitTcRgb,
+        ScanlineFormat::N32BitTcAbgr, ScanlineFormat::N32BitTcArgb, ScanlineFormat::N32BitTcBgra,
+        ScanlineFormat::N32BitTcRgba };
+
+class BmpFastTest : public CppUnit::TestFixture
+{
+    void testPixelShuffle();
+    void testShuffleLineScalar();
+    void testShuffleLineVectorized();
+    void testBlendLine32Scalar();
+    void testBlendLine32Vectorized();
+
+    CPPUNIT_TEST_SUITE(BmpFastTest);
+    CPPUNIT_TEST(testPixelShuffle);
+    CPPUNIT_TEST(testShuffleLineScalar);
+    CPPUNIT_TEST(testShuffleLineVectorized);
+    CPPUNIT_TEST(testBlendLine32Scalar);
+    CPPUNIT_TEST(testBlendLine32Vectorized);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+void BmpFastTest::testPixelShuffle()
+{
+    vcl::bitmap::PixelShuffle aShuffle;
+
+    CPPUNIT_ASSERT(vcl::bitmap::getPixelShuffle(ScanlineFormat::N24BitTcBgr,
+                                                ScanlineFormat::N32BitTcRgba, aShuffle));
+    CPPUNIT_ASSERT_EQUAL(sal_uInt8(3), aShuffle.mnSrcBytes);
+    CPPUNIT_ASSERT_EQUAL(sal_uInt8(4), aShuffle.mnDstBytes);
+    CPPUNIT_ASSERT_EQUAL(sal_uInt8(2), aShuffle.maSource[0]);
+    CPPUNIT_ASSERT_EQUAL(sal_uInt8(1), aShuffle.maSource[1]);
+    CPPUNIT_ASSERT_EQUAL(sal_uInt8(0), aShuffle.maSource[2]);
+    CPPUNIT_ASSERT_EQUAL(vcl::bitmap::ShuffleOpaque, aShuffle.maSource[3]);
+
+    CPPUNIT_ASSERT(vcl::bitmap::getPixelShuffle(ScanlineFormat::N32BitTcArgb,
+                                                ScanlineFormat::N32BitTcBgra, aShuffle));
+    CPPUNIT_ASSERT_EQUAL(sal_uInt8(3), aShuffle.maSource[0]);
+    CPPUNIT_ASSERT_EQUAL(sal_uInt8(2), aShuffle.maSource[1]);
+    CPPUNIT_ASSERT_EQUAL(sal_uInt8(1), aShuffle.maSource[2]);
+    CPPUNIT_ASSERT_EQUAL(sal_uInt8(0), aShuffle.maSource[3]);
+
+    // nothing can be converted into 8 bit by shuffling bytes
+    CPPUNIT_ASSERT(!vcl::bitmap::getPixelShuffle(ScanlineFormat::N32BitTcRgba,
+                                                 ScanlineFormat::N8BitPal, aShuffle));
+    CPPUNIT_ASSERT(!vcl::bitmap::getPixelShuffle(ScanlineFormat::N1BitMsbPal,
+                                                 ScanlineFormat::N32BitTcRgba, aShuffle));
+}
+
+void BmpFastTest::testShuffleLineScalar()
+{
+    vcl::bitmap::PixelShuffle aShuffle;
+
+    std::vector<sal_uInt8> aBgr{ 1, 2, 3, 4, 5, 6 };
+    std::vector<sal_uInt8> aRgba(8, 0);
+    CPPUNIT_ASSERT(vcl::bitmap::getPixelShuffle(ScanlineFormat::N24BitTcBgr,
+                                                ScanlineFormat::N32BitTcRgba, aShuffle));
+    vcl::bitmap::shuffleLineScalar(aRgba.data(), aBgr.data(), 2, aShuffle);
+    std::vector<sal_uInt8> aExpectedRgba{ 3, 2, 1, 255, 6, 5, 4, 255 };
+    CPPUNIT_ASSERT(bool(aExpectedRgba == aRgba));
+
+    std::vector<sal_uInt8> aGrey{ 10, 20 };
+    std::vector<sal_uInt8> aArgb(8, 0);
+    CPPUNIT_ASSERT(vcl::bitmap::getPixelShuffle(ScanlineFormat::N8BitPal,
+                                                ScanlineFormat::N32BitTcArgb, aShuffle));
+    vcl::bitmap::shuffleLineScalar(aArgb.data(), aGrey.data(), 2, aShuffle);
+    std::vector<sal_uInt8> aExpectedArgb{ 255, 10, 10, 10, 255, 20, 20, 20 };
+    CPPUNIT_ASSERT(bool(aExpectedArgb == aArgb));
+}
+
+void BmpFastTest::testShuffleLineVectorized()
+{
+    // every kernel the CPU supports must give exactly the scalar result, for all
+    // line lengths around the vector widths and without touching bytes after the line
+    for (vcl::bitmap::ShuffleLineFunction pFunction :
+         vcl::bitmap::getSupportedShuffleLineFunctions())
+    {
+        for (ScanlineFormat eSrc : aTrueColorFormats)
+        {
+            for (ScanlineFormat eDst : aTrueColorFormats)
+            {
+                vcl::bitmap::PixelShuffle aShuffle;
+                if (!vcl::bitmap::getPixelShuffle(eSrc, eDst, aShuffle))
+                    continue;
+
+                for (int nWidth = 0; nWidth < 70; ++nWidth)
+                {
+                    std::vector<sal_uInt8> aSrc(nWidth * aShuffle.mnSrcBytes);
+                    for (size_t i = 0; i < aSrc.size(); ++i)
+                        aSrc[i] = sal_uInt8(i * 7 + 13);
+
+                    std::vector<sal_uInt8> aExpected(nWidth * aShuffle.mnDstBytes + 32, 0xcd);
+                    std::vector<sal_uInt8> aResult(aExpected);
+                    vcl::bitmap::shuffleLineScalar(aExpected.data(), aSrc.data(), nWidth,
+                                                   aShuffle);
+                    pFunction(aResult.data(), aSrc.data(), nWidth, aShuffle);
+                    CPPUNIT_ASSERT(bool(aExpected == aResult));
+                }
+            }
+        }
+    }
+}
+
+void BmpFastTest::testBlendLine32Scalar()
+{
+    // RGBA pixels: transparent mask copies, opaque mask keeps, partial mask mixes colors
+    std::vector<sal_uInt8> aDst{ 10, 20, 30, 40, 10, 20, 30, 40, 200, 100, 0, 40 };
+    const std::vector<sal_uInt8> aSrc{ 1, 2, 3, 4, 1, 2, 3, 4, 100, 200, 255, 4 };
+    const std::vector<sal_uInt8> aMask{ 0, 255, 128 };
+    vcl::bitmap::blendLine32Scalar(aDst.data(), aSrc.data(), aMask.data(), 3, 3);
+
+    const std::vector<sal_uInt8> aExpected{ 1, 2, 3, 4, 10, 20, 30, 40, 150, 150, 127, 40 };
+    CPPUNIT_ASSERT(bool(aExpected == aDst));
+}
+
+void BmpFastTest::testBlendLine32Vectorized()
+{
+    for (vcl::bitmap::BlendLine32Function pFunction :
+         vcl::bitmap::getSupportedBlendLine32Functions())
+    {
+        for (sal_uInt8 nDstAlpha : { 0, 3 })
+        {
+            for (int nWidth = 0; nWidth < 70; ++nWidth)
+            {
+                std::vector<sal_uInt8> aSrc(nWidth * 4);
+                std::vector<sal_uInt8> aDst(nWidth * 4 + 32);
+                for (size_t i = 0; i < aSrc.size(); ++i)
+                    aSrc[i] = sal_uInt8(i * 7 + 13);
+                for (size_t i = 0; i < aDst.size(); ++i)
+                    aDst[i] = sal_uInt8(i * 11 + 5);
+
+                // runs of transparent and opaque pixels mixed with partial ones
+                std::vector<sal_uInt8> aMask(nWidth);
+                for (int i = 0; i < nWidth; ++i)
+                {
+                    switch ((i / 8) % 3)
+                    {
+                        case 0:
+                            aMask[i] = 0;
+                            break;
+                        case 1:
+                            aMask[i] = 255;
+                            break;
+                        default:
+                            aMask[i] = sal_uInt8(i * 37);
+                            break;
+                    }
+                }
+                if (nWidth > 20)
+                    aMask[20] = 255;
+
+                std::vector<sal_uInt8> aExpected(aDst);
+                vcl::bitmap::blendLine32Scalar(aExpected.data(), aSrc.data(), aMask.data(), nWidth,
+                                               nDstAlpha);
+                pFunction(aDst.data(), aSrc.data(), aMask.data(), nWidth, nDstAlpha);
+                CPPUNIT_ASSERT(bool(aExpected == aDst));
+            }
+        }
+    }
+}
+
+} // namespace
+
+CPPUNIT_TEST_SUITE_REGISTRATION(BmpFastTest);
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
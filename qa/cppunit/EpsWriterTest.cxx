@@ -0,0 +1,177 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <test/bootstrapfixture.hxx>
+
+#include <comphelper/propertyvalue.hxx>
+#include <tools/stream.hxx>
+#include <tools/zcodec.hxx>
+#include <vcl/BitmapWriteAccess.hxx>
+#include <vcl/bitmapex.hxx>
+#include <vcl/graph.hxx>
+#include <filter/EpsWriter.hxx>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+class EpsWriterTest : public test::BootstrapFixture
+{
+public:
+    EpsWriterTest()
+        : BootstrapFixture(true, false)
+    {
+    }
+
+    static std::string encodeASCII85(const std::vector<sal_uInt8>& rData,
+                                     sal_uInt32 nLinePos = 0)
+    {
+        std::string aOut;
+        vcl::eps::EncodeASCII85(aOut, rData.data(), rData.size(), nLinePos, 70);
+        return aOut;
+    }
+
+    // independent of the encoder: whitespace is skipped, z stands for four zero bytes and a
+    // final group of n characters gives n - 1 bytes
+    static std::vector<sal_uInt8> decodeASCII85(std::string_view aText)
+    {
+        std::vector<sal_uInt8> aOut;
+        sal_uInt64 nGroup = 0;
+        int nChars = 0;
+        for (char c : aText)
+        {
+            if (c == 'z' && !nChars)
+            {
+                aOut.insert(aOut.end(), 4, 0);
+                continue;
+            }
+            if (c < '!' || c > 'u')
+                continue;
+            nGroup = nGroup * 85 + (c - '!');
+            if (++nChars == 5)
+            {
+                for (int i = 3; i >= 0; --i)
+                    aOut.push_back(static_cast<sal_uInt8>(nGroup >> (8 * i)));
+                nGroup = 0;
+                nChars = 0;
+            }
+        }
+        if (nChars)
+        {
+            for (int i = nChars; i < 5; ++i)
+                nGroup = nGroup * 85 + 84;
+            for (int i = 0; i < nChars - 1; ++i)
+                aOut.push_back(static_cast<sal_uInt8>(nGroup >> (24 - 8 * i)));
+        }
+        return aOut;
+    }
+};
+}
+
+CPPUNIT_TEST_FIXTURE(EpsWriterTest, testEncodeHex)
+{
+    const std::vector<sal_uInt8> aData = { 0x00, 0x1f, 0xa0, 0xff };
+    std::string aOut;
+    sal_uInt32 nLinePos = 0;
+    vcl::eps::EncodeHex(aOut, aData.data(), aData.size(), nLinePos, 70);
+    CPPUNIT_ASSERT_EQUAL(std::string("001FA0FF"), aOut);
+    CPPUNIT_ASSERT_EQUAL(sal_uInt32(8), nLinePos);
+
+    // 35 bytes fill a line of 70 characters, the rest goes to the next one
+    const std::vector<sal_uInt8> aLong(40, 0x5a);
+    aOut.clear();
+    nLinePos = 0;
+    vcl::eps::EncodeHex(aOut, aLong.data(), aLong.size(), nLinePos, 70);
+    std::string aExpected;
+    for (int i = 0; i < 35; ++i)
+        aExpected += "5A";
+    aExpected += "\n";
+    for (int i = 0; i < 5; ++i)
+        aExpected += "5A";
+    CPPUNIT_ASSERT_EQUAL(aExpected, aOut);
+    CPPUNIT_ASSERT_EQUAL(sal_uInt32(10), nLinePos);
+}
+
+CPPUNIT_TEST_FIXTURE(EpsWriterTest, testEncodeASCII85)
+{
+    // full groups
+    CPPUNIT_ASSERT_EQUAL(std::string("9jqo^"), encodeASCII85({ 'M', 'a', 'n', ' ' }));
+
+    // four zero bytes are written as z, but not in a final partial group
+    CPPUNIT_ASSERT_EQUAL(std::string("z"), encodeASCII85({ 0, 0, 0, 0 }));
+    CPPUNIT_ASSERT_EQUAL(std::string("zrr"), encodeASCII85({ 0, 0, 0, 0, 0xff }));
+    CPPUNIT_ASSERT_EQUAL(std::string("!!!!"), encodeASCII85({ 0, 0, 0 }));
+
+    // a final partial group of n bytes gives n + 1 characters
+    CPPUNIT_ASSERT_EQUAL(std::string("9`"), encodeASCII85({ 'M' }));
+    CPPUNIT_ASSERT_EQUAL(std::string("9jqo^Bla"), encodeASCII85({ 'M', 'a', 'n', ' ', 'i', 's' }));
+
+    // a line must not start with %, which DSC parsers would take for a comment
+    CPPUNIT_ASSERT_EQUAL(std::string(" %\"J<X"), encodeASCII85({ 0x0c, 0x80, 0, 0 }));
+    CPPUNIT_ASSERT_EQUAL(std::string("%\"J<X"), encodeASCII85({ 0x0c, 0x80, 0, 0 }, 10));
+
+    // 14 groups fill a line of 70 characters
+    const std::vector<sal_uInt8> aData(15 * 4, 'M');
+    const std::string aOut = encodeASCII85(aData);
+    CPPUNIT_ASSERT_EQUAL(size_t(15 * 5 + 1), aOut.size());
+    CPPUNIT_ASSERT_EQUAL('\n', aOut[70]);
+    CPPUNIT_ASSERT(bool(aData == decodeASCII85(aOut)));
+}
+
+CPPUNIT_TEST_FIXTURE(EpsWriterTest, testLevel3Image)
+{
+    const Size aSize(16, 8);
+    Bitmap aBitmap(aSize, vcl::PixelFormat::N24_BPP);
+    std::vector<sal_uInt8> aPixels;
+    {
+        BitmapScopedWriteAccess pAccess(aBitmap);
+        for (tools::Long y = 0; y < aSize.Height(); ++y)
+        {
+            for (tools::Long x = 0; x < aSize.Width(); ++x)
+            {
+                const Color aColor(x * 16, y * 32, (x + y) % 2 ? 0xff : 0);
+                pAccess->SetPixel(y, x, aColor);
+                aPixels.push_back(aColor.GetRed());
+                aPixels.push_back(aColor.GetGreen());
+                aPixels.push_back(aColor.GetBlue());
+            }
+        }
+    }
+
+    css::uno::Sequence<css::beans::PropertyValue> aFilterData{
+        comphelper::makePropertyValue("Version", sal_Int32(3))
+    };
+    FilterConfigItem aConfigItem(&aFilterData);
+    SvMemoryStream aStream;
+    CPPUNIT_ASSERT(ExportEpsGraphic(aStream, Graphic(BitmapEx(aBitmap)), &aConfigItem));
+
+    const std::string_view aEps(static_cast<const char*>(aStream.GetData()), aStream.TellEnd());
+    const std::string_view aStart("/ASCII85Decode filter\n/FlateDecode filter\n>>\nimage\n");
+    const size_t nStart = aEps.find(aStart);
+    CPPUNIT_ASSERT(nStart != std::string_view::npos);
+    const size_t nEnd = aEps.find("~>", nStart);
+    CPPUNIT_ASSERT(nEnd != std::string_view::npos);
+
+    const std::vector<sal_uInt8> aCompressed
+        = decodeASCII85(aEps.substr(nStart + aStart.size(), nEnd - nStart - aStart.size()));
+    SvMemoryStream aCompressedStream(const_cast<sal_uInt8*>(aCompressed.data()),
+                                     aCompressed.size(), StreamMode::READ);
+    SvMemoryStream aDecompressed;
+    ZCodec aCodec;
+    aCodec.BeginCompression();
+    aCodec.Decompress(aCompressedStream, aDecompressed);
+    CPPUNIT_ASSERT(aCodec.EndCompression() >= 0);
+
+    CPPUNIT_ASSERT_EQUAL(sal_uInt64(aPixels.size()), aDecompressed.TellEnd());
+    const sal_uInt8* pData = static_cast<const sal_uInt8*>(aDecompressed.GetData());
+    CPPUNIT_ASSERT(bool(aPixels == std::vector<sal_uInt8>(pData, pData + aPixels.size())));
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
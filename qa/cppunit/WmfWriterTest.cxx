@@ -0,0 +1,280 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <test/bootstrapfixture.hxx>
+
+#include <tools/stream.hxx>
+#include <vcl/gdimtf.hxx>
+#include <vcl/virdev.hxx>
+#include <vcl/wmf.hxx>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+struct Record
+{
+    sal_uInt32 nType;
+    std::vector<sal_uInt8> aData; // the whole record, header included
+};
+
+class WmfWriterTest : public test::BootstrapFixture
+{
+public:
+    WmfWriterTest()
+        : BootstrapFixture(true, false)
+    {
+    }
+
+    // A metafile mixing polygon records with records that are still written field by field.
+    // The two lines come first, so that their MOVETO/LINETO records give the points P0 to P3
+    // in the coordinates of the output.
+    static GDIMetaFile createMixedMetafile(const std::vector<Point>& rPoints)
+    {
+        GDIMetaFile aMtf;
+        ScopedVclPtrInstance<VirtualDevice> pDev;
+        pDev->SetMapMode(MapMode(MapUnit::Map100thMM));
+        aMtf.Record(pDev.get());
+
+        pDev->SetLineColor(COL_RED);
+        pDev->DrawLine(rPoints[0], rPoints[1]);
+        pDev->DrawLine(rPoints[2], rPoints[3]);
+        pDev->SetFillColor(COL_YELLOW);
+        pDev->DrawRect(tools::Rectangle(Point(100, 200), Size(3000, 1500)));
+        pDev->DrawPolyLine(getPolyLine(rPoints));
+        pDev->SetLineColor(COL_BLUE);
+        pDev->DrawPolygon(getPolygon(rPoints));
+        pDev->DrawEllipse(tools::Rectangle(Point(4000, 4000), Size(2000, 1000)));
+        pDev->DrawPolyPolygon(getPolyPolygon(rPoints));
+        pDev->DrawText(Point(500, 6000), "Mixed records");
+
+        aMtf.Stop();
+        aMtf.SetPrefMapMode(MapMode(MapUnit::Map100thMM));
+        aMtf.SetPrefSize(Size(10000, 10000));
+        return aMtf;
+    }
+
+    static tools::Polygon getPolyLine(const std::vector<Point>& rPoints)
+    {
+        return tools::Polygon({ rPoints[0], rPoints[1], rPoints[2] });
+    }
+
+    static tools::Polygon getPolygon(const std::vector<Point>& rPoints)
+    {
+        return tools::Polygon({ rPoints[1], rPoints[2], rPoints[3] });
+    }
+
+    static tools::PolyPolygon getPolyPolygon(const std::vector<Point>& rPoints)
+    {
+        tools::PolyPolygon aPolyPolygon(getPolyLine(rPoints));
+        aPolyPolygon.Insert(tools::Polygon({ rPoints[3], rPoints[2], rPoints[1], rPoints[0] }));
+        return aPolyPolygon;
+    }
+
+    static std::vector<sal_uInt8> getBytes(SvMemoryStream& rStream)
+    {
+        const sal_uInt8* pData = static_cast<const sal_uInt8*>(rStream.GetData());
+        return std::vector<sal_uInt8>(pData, pData + rStream.TellEnd());
+    }
+
+    static const Record& findRecord(const std::vector<Record>& rRecords, sal_uInt32 nType,
+                                    size_t nSkip = 0)
+    {
+        for (const Record& rRecord : rRecords)
+        {
+            if (rRecord.nType == nType && !nSkip--)
+                return rRecord;
+        }
+        CPPUNIT_FAIL("record not found");
+        return rRecords.front();
+    }
+};
+
+const std::vector<Point> aPoints = { Point(1000, 1000), Point(9000, 2500), Point(7000, 8000),
+                                     Point(1500, 6000) };
+}
+
+CPPUNIT_TEST_FIXTURE(WmfWriterTest, testWmfPolygonRecords)
+{
+    const GDIMetaFile aMtf = createMixedMetafile(aPoints);
+    SvMemoryStream aStream;
+    CPPUNIT_ASSERT(ConvertGDIMetaFileToWMF(aMtf, aStream, nullptr, true));
+
+    // walk the records from the header to the end of file record
+    aStream.Seek(22); // placeable header
+    aStream.SetEndian(SvStreamEndian::LITTLE);
+    const sal_uInt64 nHeaderPos = aStream.Tell();
+    sal_uInt16 nFileType(0), nHeaderSize(0), nVersion(0), nObjects(0), nReserved(0);
+    sal_uInt32 nFileSize(0), nMaxRecord(0);
+    aStream.ReadUInt16(nFileType).ReadUInt16(nHeaderSize).ReadUInt16(nVersion);
+    aStream.ReadUInt32(nFileSize).ReadUInt16(nObjects).ReadUInt32(nMaxRecord).ReadUInt16(nReserved);
+    CPPUNIT_ASSERT_EQUAL(sal_uInt16(9), nHeaderSize);
+    CPPUNIT_ASSERT_EQUAL(sal_uInt64(nFileSize) * 2, aStream.TellEnd() - nHeaderPos);
+
+    const std::vector<sal_uInt8> aBytes = getBytes(aStream);
+    std::vector<Record> aRecords;
+    sal_uInt32 nMaxSeen = 0;
+    for (;;)
+    {
+        const sal_uInt64 nPos = aStream.Tell();
+        sal_uInt32 nSize(0);
+        sal_uInt16 nFunction(0);
+        aStream.ReadUInt32(nSize).ReadUInt16(nFunction);
+        CPPUNIT_ASSERT(aStream.good());
+        CPPUNIT_ASSERT(nSize >= 3);
+        CPPUNIT_ASSERT(nPos + nSize * 2 <= aBytes.size());
+        nMaxSeen = std::max(nMaxSeen, nSize);
+        aRecords.push_back(
+            { nFunction, std::vector<sal_uInt8>(aBytes.begin() + nPos,
+                                                aBytes.begin() + nPos + nSize * 2) });
+        aStream.Seek(nPos + nSize * 2);
+        if (nFunction == 0)
+            break;
+    }
+    CPPUNIT_ASSERT_EQUAL(sal_uInt64(aBytes.size()), aStream.Tell());
+    CPPUNIT_ASSERT_EQUAL(nMaxSeen, nMaxRecord);
+
+    // the points as the writer transformed them: MOVETO and LINETO store y before x
+    std::vector<Point> aTransformed;
+    for (size_t i = 0; i < 2; ++i)
+    {
+        for (sal_uInt32 nType : { 0x0214, 0x0213 })
+        {
+            SvMemoryStream aRecord(const_cast<sal_uInt8*>(findRecord(aRecords, nType, i).aData.data()),
+                                   10, StreamMode::READ);
+            aRecord.SetEndian(SvStreamEndian::LITTLE);
+            aRecord.SeekRel(6);
+            sal_Int16 nX(0), nY(0);
+            aRecord.ReadInt16(nY).ReadInt16(nX);
+            aTransformed.emplace_back(nX, nY);
+        }
+    }
+
+    // the records as WMFWriter wrote them field by field before they were buffered
+    auto writePolyRecord = [](const tools::Polygon& rPoly, sal_uInt16 nType) {
+        SvMemoryStream aExpected;
+        aExpected.SetEndian(SvStreamEndian::LITTLE);
+        const sal_uInt16 nSize = rPoly.GetSize();
+        aExpected.WriteUInt32(static_cast<sal_uInt32>(nSize) * 2 + 4).WriteUInt16(nType);
+        aExpected.WriteUInt16(nSize);
+        for (sal_uInt16 i = 0; i < nSize; ++i)
+            aExpected.WriteInt16(rPoly[i].X()).WriteInt16(rPoly[i].Y());
+        return getBytes(aExpected);
+    };
+
+    CPPUNIT_ASSERT(bool(writePolyRecord(getPolyLine(aTransformed), 0x0325)
+                        == findRecord(aRecords, 0x0325).aData));
+    CPPUNIT_ASSERT(bool(writePolyRecord(getPolygon(aTransformed), 0x0324)
+                        == findRecord(aRecords, 0x0324).aData));
+
+    // the polypolygon record had its size patched in afterwards
+    const tools::PolyPolygon aPolyPolygon = getPolyPolygon(aTransformed);
+    SvMemoryStream aExpected;
+    aExpected.SetEndian(SvStreamEndian::LITTLE);
+    aExpected.WriteUInt32(0).WriteUInt16(0x0538);
+    aExpected.WriteUInt16(aPolyPolygon.Count());
+    for (sal_uInt16 i = 0; i < aPolyPolygon.Count(); ++i)
+        aExpected.WriteUInt16(aPolyPolygon[i].GetSize());
+    for (sal_uInt16 i = 0; i < aPolyPolygon.Count(); ++i)
+    {
+        for (sal_uInt16 j = 0; j < aPolyPolygon[i].GetSize(); ++j)
+            aExpected.WriteInt16(aPolyPolygon[i][j].X()).WriteInt16(aPolyPolygon[i][j].Y());
+    }
+    const sal_uInt32 nSize = aExpected.Tell() / 2;
+    aExpected.Seek(0);
+    aExpected.WriteUInt32(nSize);
+    CPPUNIT_ASSERT(bool(getBytes(aExpected) == findRecord(aRecords, 0x0538).aData));
+}
+
+CPPUNIT_TEST_FIXTURE(WmfWriterTest, testEmfPolygonRecords)
+{
+    const GDIMetaFile aMtf = createMixedMetafile(aPoints);
+    SvMemoryStream aStream;
+    CPPUNIT_ASSERT(ConvertGDIMetaFileToEMF(aMtf, aStream));
+
+    aStream.Seek(48);
+    aStream.SetEndian(SvStreamEndian::LITTLE);
+    sal_uInt32 nBytes(0), nRecordCount(0);
+    aStream.ReadUInt32(nBytes).ReadUInt32(nRecordCount);
+
+    const std::vector<sal_uInt8> aBytes = getBytes(aStream);
+    CPPUNIT_ASSERT_EQUAL(sal_uInt64(aBytes.size()), sal_uInt64(nBytes));
+
+    std::vector<Record> aRecords;
+    aStream.Seek(0);
+    for (;;)
+    {
+        const sal_uInt64 nPos = aStream.Tell();
+        sal_uInt32 nType(0), nSize(0);
+        aStream.ReadUInt32(nType).ReadUInt32(nSize);
+        CPPUNIT_ASSERT(aStream.good());
+        CPPUNIT_ASSERT(nSize >= 8);
+        CPPUNIT_ASSERT_EQUAL(sal_uInt32(0), nSize % 4);
+        CPPUNIT_ASSERT(nPos + nSize <= aBytes.size());
+        aRecords.push_back(
+            { nType, std::vector<sal_uInt8>(aBytes.begin() + nPos, aBytes.begin() + nPos + nSize) });
+        aStream.Seek(nPos + nSize);
+        if (nType == 14) // EMR_EOF
+            break;
+    }
+    CPPUNIT_ASSERT_EQUAL(sal_uInt64(aBytes.size()), aStream.Tell());
+    CPPUNIT_ASSERT_EQUAL(size_t(nRecordCount), aRecords.size());
+
+    // EMFWriter writes in 1/100 mm, like the metafile, so the points are not transformed.
+    // These are the records as EMFWriter wrote them field by field before they were buffered.
+    auto beginRecord = [](SvMemoryStream& rRecord, sal_uInt32 nType, const tools::Rectangle& rBound) {
+        rRecord.SetEndian(SvStreamEndian::LITTLE);
+        rRecord.WriteUInt32(nType).WriteUInt32(0);
+        rRecord.WriteInt32(rBound.Left()).WriteInt32(rBound.Top());
+        rRecord.WriteInt32(rBound.Right()).WriteInt32(rBound.Bottom());
+    };
+    auto writePoints = [](SvMemoryStream& rRecord, const tools::Polygon& rPoly) {
+        for (sal_uInt16 i = 0; i < rPoly.GetSize(); ++i)
+            rRecord.WriteInt32(rPoly[i].X()).WriteInt32(rPoly[i].Y());
+    };
+    auto endRecord = [](SvMemoryStream& rRecord) {
+        sal_uInt32 nSize = rRecord.Tell();
+        while (nSize % 4)
+        {
+            rRecord.WriteUChar(0);
+            ++nSize;
+        }
+        rRecord.Seek(4);
+        rRecord.WriteUInt32(nSize);
+        return getBytes(rRecord);
+    };
+    auto writePolyRecord = [&](const tools::Polygon& rPoly, sal_uInt32 nType) {
+        SvMemoryStream aRecord;
+        beginRecord(aRecord, nType, rPoly.GetBoundRect());
+        aRecord.WriteUInt32(rPoly.GetSize());
+        writePoints(aRecord, rPoly);
+        return endRecord(aRecord);
+    };
+
+    CPPUNIT_ASSERT(bool(writePolyRecord(getPolyLine(aPoints), 4) // EMR_POLYLINE
+                        == findRecord(aRecords, 4).aData));
+    CPPUNIT_ASSERT(bool(writePolyRecord(getPolygon(aPoints), 3) // EMR_POLYGON
+                        == findRecord(aRecords, 3).aData));
+
+    const tools::PolyPolygon aPolyPolygon = getPolyPolygon(aPoints);
+    SvMemoryStream aExpected;
+    beginRecord(aExpected, 8, aPolyPolygon.GetBoundRect()); // EMR_POLYPOLYGON
+    sal_uInt32 nTotalPoints = 0;
+    for (sal_uInt16 i = 0; i < aPolyPolygon.Count(); ++i)
+        nTotalPoints += aPolyPolygon[i].GetSize();
+    aExpected.WriteUInt32(aPolyPolygon.Count()).WriteUInt32(nTotalPoints);
+    for (sal_uInt16 i = 0; i < aPolyPolygon.Count(); ++i)
+        aExpected.WriteUInt32(aPolyPolygon[i].GetSize());
+    for (sal_uInt16 i = 0; i < aPolyPolygon.Count(); ++i)
+        writePoints(aExpected, aPolyPolygon[i]);
+    CPPUNIT_ASSERT(bool(endRecord(aExpected) == findRecord(aRecords, 8).aData));
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
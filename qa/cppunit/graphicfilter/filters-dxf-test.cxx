@@ -12,7 +12,10 @@
 #include <vcl/FilterConfigItem.hxx>
 #include <tools/stream.hxx>
 #include <vcl/graph.hxx>
+#include <vcl/gdimtf.hxx>
+#include <vcl/metaact.hxx>
 #include <filter/DxfReader.hxx>
+#include <rtl/strbuf.hxx>
 
 using namespace css;
 
@@ -34,8 +37,11 @@ public:
      */
     void testCVEs();
 
+    void testManyBlocks();
+
     CPPUNIT_TEST_SUITE(DxfFilterTest);
     CPPUNIT_TEST(testCVEs);
+    CPPUNIT_TEST(testManyBlocks);
     CPPUNIT_TEST_SUITE_END();
 };
 
@@ -56,6 +62,44 @@ void DxfFilterTest::testCVEs()
 #endif
 }
 
+void DxfFilterTest::testManyBlocks()
+{
+    // A drawing made of many small blocks, each holding one line and inserted
+    // once from the ENTITIES section.
+    constexpr sal_Int32 nBlocks = 2000;
+
+    OStringBuffer aDxf("0\nSECTION\n2\nHEADER\n"
+                       "9\n$EXTMIN\n10\n0.0\n20\n0.0\n30\n0.0\n"
+                       "9\n$EXTMAX\n10\n" + OString::number(nBlocks + 1) + "\n20\n1.0\n30\n0.0\n"
+                       "0\nENDSEC\n0\nSECTION\n2\nBLOCKS\n");
+    for (sal_Int32 i = 0; i < nBlocks; ++i)
+    {
+        aDxf.append("0\nBLOCK\n2\nB" + OString::number(i) + "\n70\n0\n10\n0.0\n20\n0.0\n30\n0.0\n"
+                    "0\nLINE\n8\n0\n10\n0.0\n20\n0.0\n11\n1.0\n21\n1.0\n"
+                    "0\nENDBLK\n");
+    }
+    aDxf.append("0\nENDSEC\n0\nSECTION\n2\nENTITIES\n");
+    for (sal_Int32 i = 0; i < nBlocks; ++i)
+    {
+        aDxf.append("0\nINSERT\n8\n0\n2\nB" + OString::number(i) + "\n10\n"
+                    + OString::number(i) + "\n20\n0.0\n");
+    }
+    aDxf.append("0\nENDSEC\n0\nEOF\n");
+
+    SvMemoryStream aStream(const_cast<char*>(aDxf.getStr()), aDxf.getLength(), StreamMode::READ);
+    Graphic aGraphic;
+    CPPUNIT_ASSERT(ImportDxfGraphic(aStream, aGraphic));
+
+    const GDIMetaFile& rMtf = aGraphic.GetGDIMetaFile();
+    sal_Int32 nLines = 0;
+    for (size_t i = 0; i < rMtf.GetActionSize(); ++i)
+    {
+        if (rMtf.GetAction(i)->GetType() == MetaActionType::LINE)
+            ++nLines;
+    }
+    CPPUNIT_ASSERT_EQUAL(nBlocks, nLines);
+}
+
 CPPUNIT_TEST_SUITE_REGISTRATION(DxfFilterTest);
 
 /* vim:set shiftwidth=4 softtabstop=4 expandtab: */
@@ -97,6 +97,7 @@ public:
     void testDrawGradient_polygon_linear();
     void testDrawGradient_polygon_axial();
     void testDrawGradient_rect_complex();
+    void testLogicToPixelPolygon();
 
     CPPUNIT_TEST_SUITE(VclOutdevTest);
     CPPUNIT_TEST(testVirtualDevice);
@@ -156,6 +157,7 @@ public:
     CPPUNIT_TEST(testDrawGradient_polygon_linear);
     CPPUNIT_TEST(testDrawGradient_polygon_axial);
     CPPUNIT_TEST(testDrawGradient_rect_complex);
+    CPPUNIT_TEST(testLogicToPixelPolygon);
     CPPUNIT_TEST_SUITE_END();
 };
 
@@ -2228,6 +2230,48 @@ void VclOutdevTest::testDrawGradient_rect_complex()
                                  pAction->GetType());
 }
 
+void VclOutdevTest::testLogicToPixelPolygon()
+{
+    ScopedVclPtrInstance<VirtualDevice> pVDev;
+
+    // the polygons are converted with the scale worked out once, that must round like the
+    // conversion of single points
+    tools::Polygon aPolygon(200);
+    for (sal_uInt16 i = 0; i < aPolygon.GetSize(); ++i)
+    {
+        const tools::Long nX = (i * 7919) % 200003 - 100000;
+        const tools::Long nY = (i * 104729) % 2000003 - 1000000;
+        aPolygon.SetPoint(Point(i % 2 ? nX : nX / 1000, i % 3 ? nY : -nY / 333), i);
+    }
+    tools::PolyPolygon aPolyPolygon(aPolygon);
+    aPolyPolygon.Insert(tools::Polygon(tools::Rectangle(Point(-3, -7), Size(11, 13))));
+
+    const MapMode aMapModes[] = {
+        MapMode(MapUnit::Map100thMM),
+        MapMode(MapUnit::MapTwip, Point(17, -23), Fraction(3, 7), Fraction(5, 11)),
+        MapMode(MapUnit::MapPoint, Point(), Fraction(1, 2), Fraction(1, 3)),
+        MapMode(MapUnit::MapInch),
+        MapMode(MapUnit::MapPixel, Point(5, 6), Fraction(2, 1), Fraction(3, 1)),
+    };
+    for (const MapMode& rMapMode : aMapModes)
+    {
+        pVDev->SetMapMode(rMapMode);
+        const tools::Polygon aPixelPolygon = pVDev->LogicToPixel(aPolygon);
+        const tools::PolyPolygon aPixelPolyPolygon = pVDev->LogicToPixel(aPolyPolygon);
+        const tools::Polygon aPixelPolygon2 = pVDev->LogicToPixel(aPolygon, rMapMode);
+        for (sal_uInt16 i = 0; i < aPolygon.GetSize(); ++i)
+        {
+            const Point aPixel = pVDev->LogicToPixel(aPolygon.GetPoint(i));
+            CPPUNIT_ASSERT_EQUAL(aPixel, aPixelPolygon.GetPoint(i));
+            CPPUNIT_ASSERT_EQUAL(aPixel, aPixelPolyPolygon[0].GetPoint(i));
+            CPPUNIT_ASSERT_EQUAL(aPixel, aPixelPolygon2.GetPoint(i));
+        }
+        for (sal_uInt16 i = 0; i < aPolyPolygon[1].GetSize(); ++i)
+            CPPUNIT_ASSERT_EQUAL(pVDev->LogicToPixel(aPolyPolygon[1].GetPoint(i)),
+                                 aPixelPolyPolygon[1].GetPoint(i));
+    }
+}
+
 CPPUNIT_TEST_SUITE_REGISTRATION(VclOutdevTest);
 
 CPPUNIT_PLUGIN_IMPLEMENT();
@@ -0,0 +1,267 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <test/bootstrapfixture.hxx>
+#include <cppunit/TestAssert.h>
+
+#include <tools/gen.hxx>
+#include <vcl/region.hxx>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+// all the regions of the tests are within [0, nExtent) in both directions
+constexpr tools::Long nExtent = 48;
+
+class VclRegionTest : public test::BootstrapFixture
+{
+public:
+    VclRegionTest()
+        : BootstrapFixture(true, false)
+    {
+    }
+
+    void testUnion();
+    void testIntersect();
+    void testExclude();
+    void testXOr();
+    void testAgainstRectangles();
+
+    CPPUNIT_TEST_SUITE(VclRegionTest);
+    CPPUNIT_TEST(testUnion);
+    CPPUNIT_TEST(testIntersect);
+    CPPUNIT_TEST(testExclude);
+    CPPUNIT_TEST(testXOr);
+    CPPUNIT_TEST(testAgainstRectangles);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+vcl::Region createRegion(const RectangleVector& rRectangles)
+{
+    vcl::Region aRegion;
+    for (const tools::Rectangle& rRectangle : rRectangles)
+        aRegion.Union(rRectangle);
+    return aRegion;
+}
+
+RectangleVector getRectangles(const vcl::Region& rRegion)
+{
+    RectangleVector aRectangles;
+    rRegion.GetRegionRectangles(aRectangles);
+    return aRectangles;
+}
+
+/// The pixels of rRegion, row by row, so that regions can be compared however they are banded.
+std::string getPixels(const vcl::Region& rRegion)
+{
+    std::string aPixels(nExtent * nExtent, '.');
+    for (const tools::Rectangle& rRectangle : getRectangles(rRegion))
+    {
+        for (tools::Long nY = rRectangle.Top(); nY <= rRectangle.Bottom(); ++nY)
+        {
+            CPPUNIT_ASSERT(nY >= 0 && nY < nExtent);
+            for (tools::Long nX = rRectangle.Left(); nX <= rRectangle.Right(); ++nX)
+            {
+                CPPUNIT_ASSERT(nX >= 0 && nX < nExtent);
+                CPPUNIT_ASSERT_EQUAL_MESSAGE("overlapping rectangles", '.',
+                                             aPixels[nY * nExtent + nX]);
+                aPixels[nY * nExtent + nX] = '#';
+            }
+        }
+    }
+    return aPixels;
+}
+
+void checkRectangles(const RectangleVector& rExpected, const vcl::Region& rRegion)
+{
+    const RectangleVector aActual(getRectangles(rRegion));
+    CPPUNIT_ASSERT_EQUAL(rExpected.size(), aActual.size());
+    for (size_t i = 0; i < rExpected.size(); ++i)
+        CPPUNIT_ASSERT_EQUAL(rExpected[i], aActual[i]);
+}
+
+void VclRegionTest::testUnion()
+{
+    // touching separations are merged
+    vcl::Region aRegion(tools::Rectangle(0, 0, 9, 9));
+    aRegion.Union(vcl::Region(tools::Rectangle(10, 0, 19, 9)));
+    checkRectangles({ tools::Rectangle(0, 0, 19, 9) }, aRegion);
+
+    // touching bands with the same separations are merged
+    aRegion = vcl::Region(tools::Rectangle(0, 0, 9, 9));
+    aRegion.Union(vcl::Region(tools::Rectangle(0, 10, 9, 19)));
+    checkRectangles({ tools::Rectangle(0, 0, 9, 19) }, aRegion);
+
+    // disjoint y ranges
+    aRegion = vcl::Region(tools::Rectangle(0, 0, 9, 9));
+    aRegion.Union(vcl::Region(tools::Rectangle(5, 20, 14, 29)));
+    checkRectangles({ tools::Rectangle(0, 0, 9, 9), tools::Rectangle(5, 20, 14, 29) }, aRegion);
+
+    // bands which are only in one of the regions
+    aRegion = vcl::Region(tools::Rectangle(0, 0, 9, 19));
+    aRegion.Union(vcl::Region(tools::Rectangle(5, 10, 14, 29)));
+    checkRectangles({ tools::Rectangle(0, 0, 9, 9), tools::Rectangle(0, 10, 14, 19),
+                      tools::Rectangle(5, 20, 14, 29) },
+                    aRegion);
+
+    // a gap of one pixel stays
+    aRegion = vcl::Region(tools::Rectangle(0, 0, 9, 9));
+    aRegion.Union(vcl::Region(tools::Rectangle(11, 0, 19, 9)));
+    checkRectangles({ tools::Rectangle(0, 0, 9, 9), tools::Rectangle(11, 0, 19, 9) }, aRegion);
+}
+
+void VclRegionTest::testIntersect()
+{
+    vcl::Region aRegion(tools::Rectangle(0, 0, 9, 19));
+    aRegion.Intersect(vcl::Region(tools::Rectangle(5, 10, 14, 29)));
+    checkRectangles({ tools::Rectangle(5, 10, 9, 19) }, aRegion);
+
+    // one separation of the other region covers two of this one
+    aRegion = createRegion({ tools::Rectangle(0, 0, 4, 9), tools::Rectangle(10, 0, 14, 9) });
+    aRegion.Intersect(vcl::Region(tools::Rectangle(2, 5, 12, 14)));
+    checkRectangles({ tools::Rectangle(2, 5, 4, 9), tools::Rectangle(10, 5, 12, 9) }, aRegion);
+
+    // touching separations do not intersect
+    aRegion = vcl::Region(tools::Rectangle(0, 0, 9, 9));
+    aRegion.Intersect(vcl::Region(tools::Rectangle(10, 0, 19, 9)));
+    CPPUNIT_ASSERT(aRegion.IsEmpty());
+
+    // disjoint y ranges
+    aRegion = vcl::Region(tools::Rectangle(0, 0, 9, 9));
+    aRegion.Intersect(vcl::Region(tools::Rectangle(0, 10, 9, 19)));
+    CPPUNIT_ASSERT(aRegion.IsEmpty());
+}
+
+void VclRegionTest::testExclude()
+{
+    // a hole splits the band into three
+    vcl::Region aRegion(tools::Rectangle(0, 0, 29, 29));
+    aRegion.Exclude(vcl::Region(tools::Rectangle(10, 10, 19, 19)));
+    checkRectangles({ tools::Rectangle(0, 0, 29, 9), tools::Rectangle(0, 10, 9, 19),
+                      tools::Rectangle(20, 10, 29, 19), tools::Rectangle(0, 20, 29, 29) },
+                    aRegion);
+
+    // bands which are only in one of the regions
+    aRegion = vcl::Region(tools::Rectangle(0, 0, 9, 19));
+    aRegion.Exclude(vcl::Region(tools::Rectangle(5, 10, 14, 29)));
+    checkRectangles({ tools::Rectangle(0, 0, 9, 9), tools::Rectangle(0, 10, 4, 19) }, aRegion);
+
+    // disjoint y ranges leave the region as it is
+    aRegion = vcl::Region(tools::Rectangle(0, 0, 9, 9));
+    aRegion.Exclude(vcl::Region(tools::Rectangle(0, 20, 9, 29)));
+    checkRectangles({ tools::Rectangle(0, 0, 9, 9) }, aRegion);
+
+    // RegionBand::Exclude returns false for an empty result, which has to give an empty region and
+    // not one with an empty band list
+    aRegion = createRegion({ tools::Rectangle(0, 0, 4, 9), tools::Rectangle(10, 5, 14, 14) });
+    aRegion.Exclude(vcl::Region(tools::Rectangle(0, 0, 19, 19)));
+    CPPUNIT_ASSERT(aRegion.IsEmpty());
+    CPPUNIT_ASSERT(getRectangles(aRegion).empty());
+
+    aRegion = vcl::Region(tools::Rectangle(0, 0, 9, 9));
+    aRegion.Exclude(createRegion({ tools::Rectangle(0, 0, 9, 4), tools::Rectangle(0, 5, 9, 9) }));
+    CPPUNIT_ASSERT(aRegion.IsEmpty());
+}
+
+void VclRegionTest::testXOr()
+{
+    vcl::Region aRegion(tools::Rectangle(0, 0, 9, 19));
+    aRegion.XOr(vcl::Region(tools::Rectangle(5, 10, 14, 29)));
+    checkRectangles({ tools::Rectangle(0, 0, 9, 9), tools::Rectangle(0, 10, 4, 19),
+                      tools::Rectangle(10, 10, 14, 19), tools::Rectangle(5, 20, 14, 29) },
+                    aRegion);
+
+    // touching separations are merged
+    aRegion = vcl::Region(tools::Rectangle(0, 0, 9, 9));
+    aRegion.XOr(vcl::Region(tools::Rectangle(10, 0, 19, 9)));
+    checkRectangles({ tools::Rectangle(0, 0, 19, 9) }, aRegion);
+
+    // disjoint y ranges
+    aRegion = vcl::Region(tools::Rectangle(0, 0, 9, 9));
+    aRegion.XOr(vcl::Region(tools::Rectangle(0, 20, 9, 29)));
+    checkRectangles({ tools::Rectangle(0, 0, 9, 9), tools::Rectangle(0, 20, 9, 29) }, aRegion);
+
+    aRegion = createRegion({ tools::Rectangle(0, 0, 4, 9), tools::Rectangle(10, 5, 14, 14) });
+    aRegion.XOr(createRegion({ tools::Rectangle(0, 0, 4, 9), tools::Rectangle(10, 5, 14, 14) }));
+    CPPUNIT_ASSERT(aRegion.IsEmpty());
+}
+
+void VclRegionTest::testAgainstRectangles()
+{
+    // The operations with a whole region have to give the same pixels as those done rectangle by
+    // rectangle. The rectangles of a region do not overlap, so that also works for XOr. For
+    // intersecting, the parts of the first region within each rectangle are collected.
+    std::mt19937 aGenerator(42);
+    std::uniform_int_distribution<tools::Long> aPosition(0, nExtent - 1);
+    std::uniform_int_distribution<int> aCount(1, 12);
+    const auto createRandomRegion = [&] {
+        RectangleVector aRectangles;
+        for (int i = aCount(aGenerator); i > 0; --i)
+        {
+            // small extents, so that there are many touching bands and separations
+            const tools::Long nLeft = aPosition(aGenerator) / 2 * 2;
+            const tools::Long nTop = aPosition(aGenerator) / 2 * 2;
+            const tools::Long nRight = std::min(nExtent - 1, nLeft + aPosition(aGenerator) / 4);
+            const tools::Long nBottom = std::min(nExtent - 1, nTop + aPosition(aGenerator) / 4);
+            aRectangles.emplace_back(nLeft, nTop, nRight, nBottom);
+        }
+        return createRegion(aRectangles);
+    };
+
+    for (int nCase = 0; nCase < 500; ++nCase)
+    {
+        const vcl::Region aFirst(createRandomRegion());
+        const vcl::Region aSecond(createRandomRegion());
+        const RectangleVector aSecondRectangles(getRectangles(aSecond));
+        const std::string aMessage("case " + std::to_string(nCase));
+
+        vcl::Region aRegion(aFirst);
+        vcl::Region aExpected(aFirst);
+        aRegion.Union(aSecond);
+        for (const tools::Rectangle& rRectangle : aSecondRectangles)
+            aExpected.Union(rRectangle);
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(aMessage, getPixels(aExpected), getPixels(aRegion));
+
+        aRegion = aFirst;
+        aExpected = vcl::Region();
+        aRegion.Intersect(aSecond);
+        for (const tools::Rectangle& rRectangle : aSecondRectangles)
+        {
+            vcl::Region aPart(aFirst);
+            aPart.Intersect(rRectangle);
+            for (const tools::Rectangle& rPart : getRectangles(aPart))
+                aExpected.Union(rPart);
+        }
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(aMessage, getPixels(aExpected), getPixels(aRegion));
+
+        aRegion = aFirst;
+        aExpected = aFirst;
+        aRegion.Exclude(aSecond);
+        for (const tools::Rectangle& rRectangle : aSecondRectangles)
+            aExpected.Exclude(rRectangle);
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(aMessage, getPixels(aExpected), getPixels(aRegion));
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(aMessage, aExpected.IsEmpty(), aRegion.IsEmpty());
+
+        aRegion = aFirst;
+        aExpected = aFirst;
+        aRegion.XOr(aSecond);
+        for (const tools::Rectangle& rRectangle : aSecondRectangles)
+            aExpected.XOr(rRectangle);
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(aMessage, getPixels(aExpected), getPixels(aRegion));
+    }
+}
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(VclRegionTest);
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab cinoptions=b1,g0,N-s cinkeys+=0=break: */
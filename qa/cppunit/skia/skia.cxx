@@ -9,6 +9,7 @@
 
 #include <test/bootstrapfixture.hxx>
 
+#include <tools/helpers.hxx>
 #include <tools/stream.hxx>
 #include <basegfx/matrix/b2dhommatrix.hxx>
 
@@ -19,6 +20,7 @@
 #include <skia/salbmp.hxx>
 #include <skia/utils.hxx>
 #include <bitmap/BitmapWriteAccess.hxx>
+#include <bitmap/BitmapRegionAccess.hxx>
 
 using namespace SkiaHelper;
 
@@ -48,6 +50,7 @@ public:
     void testTdf137329();
     void testTdf140848();
     void testTdf132367();
+    void testRegionBuffer();
 
     CPPUNIT_TEST_SUITE(SkiaTest);
     CPPUNIT_TEST(testBitmapErase);
@@ -63,6 +66,7 @@ public:
     CPPUNIT_TEST(testTdf137329);
     CPPUNIT_TEST(testTdf140848);
     CPPUNIT_TEST(testTdf132367);
+    CPPUNIT_TEST(testRegionBuffer);
     CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -579,6 +583,37 @@ void SkiaTest::testTdf132367()
     CPPUNIT_ASSERT_EQUAL(BitmapColor(COL_WHITE), access.GetColor(3, 3));
 }
 
+void SkiaTest::testRegionBuffer()
+{
+    if (!SkiaHelper::isVCLSkiaEnabled())
+        return;
+    Bitmap bitmap(Size(10, 10), vcl::PixelFormat::N24_BPP);
+    bitmap.Erase(COL_RED);
+    BitmapWriteAccess(bitmap).SetPixel(4, 3, COL_BLUE);
+    SkiaSalBitmap* skiaBitmap = dynamic_cast<SkiaSalBitmap*>(bitmap.ImplGetSalBitmap().get());
+    CPPUNIT_ASSERT(skiaBitmap);
+    skiaBitmap->unittestResetToImage();
+    CPPUNIT_ASSERT(!skiaBitmap->unittestHasBuffer());
+    // Only the region is converted, into a buffer of its size.
+    const tools::Rectangle region(Point(2, 3), Size(5, 4));
+    BitmapBuffer* buffer = skiaBitmap->AcquireRegionBuffer(BitmapAccessMode::Read, region);
+    CPPUNIT_ASSERT(buffer);
+    CPPUNIT_ASSERT_EQUAL(tools::Long(5), buffer->mnWidth);
+    CPPUNIT_ASSERT_EQUAL(tools::Long(4), buffer->mnHeight);
+    CPPUNIT_ASSERT_EQUAL(sal_uInt32(AlignedWidth4Bytes(5 * 24)), buffer->mnScanlineSize);
+    skiaBitmap->ReleaseBuffer(buffer, BitmapAccessMode::Read);
+    CPPUNIT_ASSERT(!skiaBitmap->unittestHasBuffer());
+    {
+        vcl::bitmap::BitmapRegionAccess access(bitmap, region, BitmapAccessMode::Read);
+        CPPUNIT_ASSERT_EQUAL(tools::Long(5), access.Width());
+        CPPUNIT_ASSERT_EQUAL(tools::Long(4), access.Height());
+        CPPUNIT_ASSERT_EQUAL(BitmapColor(COL_RED), access.GetPixel(0, 0));
+        CPPUNIT_ASSERT_EQUAL(BitmapColor(COL_BLUE), access.GetPixel(1, 1));
+        CPPUNIT_ASSERT_EQUAL(BitmapColor(COL_RED), access.GetPixel(3, 4));
+    }
+    CPPUNIT_ASSERT(!skiaBitmap->unittestHasBuffer());
+}
+
 } // namespace
 
 CPPUNIT_TEST_SUITE_REGISTRATION(SkiaTest);
@@ -28,6 +28,9 @@
 #include <salhelper/simplereferenceobject.hxx>
 
 #include <bitmap/BitmapWriteAccess.hxx>
+#include <filter/SvmCompact.hxx>
+#include <tools/vcompat.hxx>
+#include <vcl/TypeSerializer.hxx>
 
 #include <basegfx/polygon/b2dpolypolygon.hxx>
 
@@ -202,6 +205,8 @@ class SvmTest : public test::BootstrapFixture, public XmlTestTools
     void checkTextLanguage(const GDIMetaFile& rMetaFile);
     void testTextLanguage();
 
+    void testCompactPolygons();
+
 public:
     SvmTest()
         : BootstrapFixture(true, false)
@@ -255,6 +260,7 @@ public:
     CPPUNIT_TEST(testComment);
     CPPUNIT_TEST(testLayoutMode);
     CPPUNIT_TEST(testTextLanguage);
+    CPPUNIT_TEST(testCompactPolygons);
 
     CPPUNIT_TEST_SUITE_END();
 };
@@ -2327,6 +2333,106 @@ void SvmTest::testTextLanguage()
     checkTextLanguage(readFile(u"textlanguage.svm"));
 }
 
+// Returns the versions of the polygon actions in an SVM stream.
+static std::vector<sal_uInt16> getPolygonActionVersions(SvMemoryStream& rStream)
+{
+    std::vector<sal_uInt16> aVersions;
+    rStream.Seek(STREAM_SEEK_TO_BEGIN);
+    rStream.SetEndian(SvStreamEndian::LITTLE);
+    rStream.SeekRel(6); // "VCLMTF"
+
+    sal_uInt32 nActions(0);
+    {
+        VersionCompatRead aCompat(rStream);
+        sal_uInt32 nCompressMode(0);
+        rStream.ReadUInt32(nCompressMode);
+        TypeSerializer aSerializer(rStream);
+        MapMode aMapMode;
+        aSerializer.readMapMode(aMapMode);
+        Size aSize;
+        aSerializer.readSize(aSize);
+        rStream.ReadUInt32(nActions);
+    }
+
+    for (sal_uInt32 i = 0; i < nActions && rStream.good(); ++i)
+    {
+        sal_uInt16 nType(0);
+        rStream.ReadUInt16(nType);
+        VersionCompatRead aCompat(rStream);
+        switch (static_cast<MetaActionType>(nType))
+        {
+            case MetaActionType::POLYLINE:
+            case MetaActionType::POLYGON:
+            case MetaActionType::POLYPOLYGON:
+                aVersions.push_back(aCompat.GetVersion());
+                break;
+            default:
+                break;
+        }
+    }
+    return aVersions;
+}
+
+void SvmTest::testCompactPolygons()
+{
+    GDIMetaFile aGDIMetaFile;
+    ScopedVclPtrInstance<VirtualDevice> pVirtualDev;
+    setupBaseVirtualDevice(*pVirtualDev, aGDIMetaFile);
+
+    tools::Polygon aPolygon(200);
+    for (sal_uInt16 i = 0; i < aPolygon.GetSize(); ++i)
+        aPolygon.SetPoint(Point(1000 + i * 3, -70000 + (i % 7) * 5), i);
+    tools::PolyPolygon aPolyPolygon(aPolygon);
+    aPolyPolygon.Insert(tools::Polygon(tools::Rectangle(Point(-5, -5), Size(10, 20))));
+
+    pVirtualDev->DrawPolyLine(aPolygon);
+    pVirtualDev->DrawPolygon(aPolygon);
+    pVirtualDev->DrawPolyPolygon(aPolyPolygon);
+
+    SvMemoryStream aPlainStream;
+    SvmWriter(aPlainStream).Write(aGDIMetaFile);
+
+    SvMemoryStream aCompactStream;
+    vcl::svm::CompactSvmWriter(aCompactStream).Write(aGDIMetaFile);
+
+    // the plain writer still writes the action versions older readers know
+    const std::vector<sal_uInt16> aPlainVersions = { 3, 2, 2 };
+    CPPUNIT_ASSERT(bool(aPlainVersions == getPolygonActionVersions(aPlainStream)));
+    const std::vector<sal_uInt16> aCompactVersions = { 4, 3, 3 };
+    CPPUNIT_ASSERT(bool(aCompactVersions == getPolygonActionVersions(aCompactStream)));
+
+    CPPUNIT_ASSERT_LESS(aPlainStream.TellEnd() / 2, aCompactStream.TellEnd());
+
+    aCompactStream.Seek(STREAM_SEEK_TO_BEGIN);
+    GDIMetaFile aResultMetafile;
+    SvmReader(aCompactStream).Read(aResultMetafile);
+    CPPUNIT_ASSERT_EQUAL(aGDIMetaFile.GetActionSize(), aResultMetafile.GetActionSize());
+
+    size_t nPolygonActions = 0;
+    for (size_t i = 0; i < aResultMetafile.GetActionSize(); ++i)
+    {
+        const MetaAction* pAction = aResultMetafile.GetAction(i);
+        switch (pAction->GetType())
+        {
+            case MetaActionType::POLYLINE:
+                CPPUNIT_ASSERT(bool(aPolygon == static_cast<const MetaPolyLineAction*>(pAction)->GetPolygon()));
+                ++nPolygonActions;
+                break;
+            case MetaActionType::POLYGON:
+                CPPUNIT_ASSERT(bool(aPolygon == static_cast<const MetaPolygonAction*>(pAction)->GetPolygon()));
+                ++nPolygonActions;
+                break;
+            case MetaActionType::POLYPOLYGON:
+                CPPUNIT_ASSERT(bool(aPolyPolygon == static_cast<const MetaPolyPolygonAction*>(pAction)->GetPolyPolygon()));
+                ++nPolygonActions;
+                break;
+            default:
+                break;
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t(3), nPolygonActions);
+}
+
 CPPUNIT_TEST_SUITE_REGISTRATION(SvmTest);
 
 CPPUNIT_PLUGIN_IMPLEMENT();
@@ -21,12 +21,12 @@
 
 #include <o3tl/safeint.hxx>
 #include <tools/helpers.hxx>
-#include <boost/smart_ptr/make_shared.hpp>
 
 #include <salgdi.hxx>
 #include <salinst.hxx>
 #include <scanlinewriter.hxx>
 #include <svdata.hxx>
+#include <bitmap/BitmapBufferPool.hxx>
 #include <bitmap/bmpfast.hxx>
 #include <vcl/BitmapReadAccess.hxx>
 
@@ -42,6 +42,9 @@
 #include <SkColorMatrix.h>
 #include <skia_opts.hxx>
 
+#include <algorithm>
+#include <new>
+
 #ifdef DBG_UTIL
 #include <fstream>
 #define CANARY "skia-canary"
@@ -52,6 +55,18 @@ using namespace SkiaHelper;
 // As constexpr here, evaluating it directly in code makes Clang warn about unreachable code.
 constexpr bool kN32_SkColorTypeIsBGRA = (kN32_SkColorType == kBGRA_8888_SkColorType);
 
+// Uninitialized pixel memory from the pool, so that temporary bitmaps reuse the memory
+// of the ones released before them.
+static boost::shared_ptr<sal_uInt8[]> allocatePixels(size_t allocate)
+{
+    sal_uInt8* pixels = vcl::bitmap::BitmapBufferPool::get().Allocate(allocate);
+    if (!pixels)
+        throw std::bad_alloc();
+    return boost::shared_ptr<sal_uInt8[]>(pixels, [allocate](sal_uInt8* p) {
+        vcl::bitmap::BitmapBufferPool::get().Release(p, allocate);
+    });
+}
+
 SkiaSalBitmap::SkiaSalBitmap() {}
 
 SkiaSalBitmap::~SkiaSalBitmap() {}
@@ -129,8 +144,9 @@ void SkiaSalBitmap::CreateBitmapData()
 #ifdef DBG_UTIL
     allocate += sizeof(CANARY);
 #endif
-    mBuffer = boost::make_shared_noinit<sal_uInt8[]>(allocate);
+    mBuffer = allocatePixels(allocate);
 #ifdef DBG_UTIL
+    mBufferAdopted = false;
     // fill with random garbage
     sal_uInt8* buffer = mBuffer.get();
     for (size_t i = 0; i < allocate; i++)
@@ -164,6 +180,9 @@ bool SkiaSalBitmap::Create(const SalBitmap& rSalBmp, vcl::PixelFormat eNewPixelF
     mImage = src.mImage;
     mAlphaImage = src.mAlphaImage;
     mBuffer = src.mBuffer;
+#ifdef DBG_UTIL
+    mBufferAdopted = src.mBufferAdopted;
+#endif
     mPalette = src.mPalette;
     mBitCount = src.mBitCount;
     mSize = src.mSize;
@@ -189,6 +208,45 @@ bool SkiaSalBitmap::Create(const css::uno::Reference<css::rendering::XBitmapCanv
     return false;
 }
 
+bool SkiaSalBitmap::CreateFromBuffer(const Size& rSize, vcl::PixelFormat ePixelFormat,
+                                     const BitmapPalette& rPal, ScanlineFormat eFormat,
+                                     sal_uInt8* pData, sal_Int32 nStride,
+                                     const std::function<void(sal_uInt8*)>& rRelease)
+{
+    // The formats AcquireBuffer() hands out, 32bpp would need premultiplied alpha. 24bpp
+    // in the other color order is swapped in place. Rows must be aligned like mBuffer's.
+    bool bSwapRB = false;
+    if (ePixelFormat == vcl::PixelFormat::N24_BPP)
+    {
+        if (eFormat != ScanlineFormat::N24BitTcBgr && eFormat != ScanlineFormat::N24BitTcRgb)
+            return false;
+        bSwapRB = (eFormat == ScanlineFormat::N24BitTcBgr) != kN32_SkColorTypeIsBGRA;
+    }
+    else if (ePixelFormat != vcl::PixelFormat::N8_BPP || eFormat != ScanlineFormat::N8BitPal)
+        return false;
+    if (rSize.IsEmpty()
+        || nStride != sal_Int32(AlignedWidth4Bytes(rSize.Width()
+                                                   * vcl::pixelFormatBitCount(ePixelFormat))))
+        return false;
+    if (!Create(rSize, ePixelFormat, rPal))
+        return false;
+    if (bSwapRB)
+    {
+        for (tools::Long y = 0; y < mSize.Height(); ++y)
+        {
+            sal_uInt8* p = pData + y * nStride;
+            for (tools::Long x = 0; x < mSize.Width(); ++x, p += 3)
+                std::swap(p[0], p[2]);
+        }
+    }
+    mBuffer = boost::shared_ptr<sal_uInt8[]>(pData, rRelease);
+#ifdef DBG_UTIL
+    mBufferAdopted = true;
+#endif
+    SAL_INFO("vcl.skia.trace", "createfrombuffer(" << this << ")");
+    return true;
+}
+
 void SkiaSalBitmap::Destroy()
 {
     SAL_INFO("vcl.skia.trace", "destroy(" << this << ")");
@@ -287,6 +345,60 @@ BitmapBuffer* SkiaSalBitmap::AcquireBuffer(BitmapAccessMode nMode)
     return buffer;
 }
 
+BitmapBuffer* SkiaSalBitmap::AcquireRegionBuffer(BitmapAccessMode nMode,
+                                                 const tools::Rectangle& rRegion)
+{
+    // Only worth it if the pixels are only in mImage (e.g. read back from a VirtualDevice),
+    // and all of it would be converted to mBuffer otherwise. The formats are those
+    // EnsureBitmapData() converts to directly.
+    const tools::Rectangle region = tools::Rectangle(Point(), mSize).GetIntersection(rRegion);
+    if (nMode != BitmapAccessMode::Read || mBuffer || mEraseColorSet || !mImage
+        || imageSize(mImage) != mSize || mPixelsSize != mSize || region.IsEmpty()
+        || region.GetSize() == mSize
+        || !(mBitCount == 32 || mBitCount == 24
+             || (mBitCount == 8 && mPalette.IsGreyPalette8Bit() && !mAlphaImage)))
+    {
+        return AcquireBuffer(nMode);
+    }
+
+    assert(mImage->colorType() == kN32_SkColorType);
+    SkiaZone zone;
+    SkBitmap bitmap;
+    if (!bitmap.tryAllocPixels(
+            SkImageInfo::MakeS32(region.GetWidth(), region.GetHeight(), ReadAlphaType())))
+        return AcquireBuffer(nMode);
+    SkCanvas canvas(bitmap);
+    SkPaint paint;
+    paint.setBlendMode(SkBlendMode::kSrc); // set as is, including alpha
+    canvas.drawImage(mImage, -region.Left(), -region.Top(), SkSamplingOptions(), &paint);
+    canvas.flush();
+
+    // The buffer has only the region, with scanlines aligned like those of mBuffer.
+    const size_t scanlineSize = AlignedWidth4Bytes(region.GetWidth() * mBitCount);
+    boost::shared_ptr<sal_uInt8[]> pixels = allocatePixels(scanlineSize * region.GetHeight());
+    for (tools::Long y = 0; y < region.GetHeight(); ++y)
+    {
+        const uint32_t* src = bitmap.getAddr32(0, y);
+        sal_uInt8* dest = pixels.get() + scanlineSize * y;
+        if (mBitCount == 32)
+            memcpy(dest, src, region.GetWidth() * 4);
+        else if (mBitCount == 24)
+            SkConvertRGBAToRGB(dest, src, region.GetWidth());
+        else
+            SkConvertRGBAToR(dest, src, region.GetWidth());
+    }
+
+    BitmapBuffer* buffer = AcquireBuffer(BitmapAccessMode::Info);
+    buffer->mnWidth = region.GetWidth();
+    buffer->mnHeight = region.GetHeight();
+    buffer->mnScanlineSize = scanlineSize;
+    buffer->mpBits = pixels.get();
+    mRegionBuffers.emplace_back(buffer, std::move(pixels));
+    ++mReadAccessCount;
+    SAL_INFO("vcl.skia.trace", "acquireregionbuffer(" << this << "): " << region);
+    return buffer;
+}
+
 void SkiaSalBitmap::ReleaseBuffer(BitmapBuffer* pBuffer, BitmapAccessMode nMode)
 {
     ReleaseBuffer(pBuffer, nMode, false);
@@ -295,6 +407,18 @@ void SkiaSalBitmap::ReleaseBuffer(BitmapBuffer* pBuffer, BitmapAccessMode nMode)
 void SkiaSalBitmap::ReleaseBuffer(BitmapBuffer* pBuffer, BitmapAccessMode nMode,
                                   bool dontChangeToErase)
 {
+    auto regionBuffer
+        = std::find_if(mRegionBuffers.begin(), mRegionBuffers.end(),
+                       [pBuffer](const auto& rEntry) { return rEntry.first == pBuffer; });
+    if (regionBuffer != mRegionBuffers.end())
+    {
+        assert(nMode == BitmapAccessMode::Read);
+        assert(mReadAccessCount > 0);
+        --mReadAccessCount;
+        mRegionBuffers.erase(regionBuffer);
+        delete pBuffer;
+        return;
+    }
     if (nMode == BitmapAccessMode::Write)
     {
 #ifdef DBG_UTIL
@@ -1072,6 +1196,18 @@ void SkiaSalBitmap::PerformErase()
     ReleaseBuffer(bitmapBuffer, BitmapAccessMode::Write, true);
 }
 
+SkAlphaType SkiaSalBitmap::ReadAlphaType() const
+{
+    SkAlphaType alphaType = kUnpremul_SkAlphaType;
+    if (mImage->imageInfo().alphaType() == kOpaque_SkAlphaType)
+        alphaType = kOpaque_SkAlphaType;
+#if SKIA_USE_BITMAP32
+    if (mBitCount == 32)
+        alphaType = kPremul_SkAlphaType;
+#endif
+    return alphaType;
+}
+
 void SkiaSalBitmap::EnsureBitmapData()
 {
     if (mEraseColorSet)
@@ -1168,13 +1304,7 @@ void SkiaSalBitmap::EnsureBitmapData()
     // from the SkImage (the alpha will be ignored if converting to bpp<32 formats, but
     // the color channels must be unpremultiplied. Unless bpp==32 and SKIA_USE_BITMAP32,
     // in which case use kPremul_SkAlphaType, since SKIA_USE_BITMAP32 implies premultiplied alpha.
-    SkAlphaType alphaType = kUnpremul_SkAlphaType;
-    if (mImage->imageInfo().alphaType() == kOpaque_SkAlphaType)
-        alphaType = kOpaque_SkAlphaType;
-#if SKIA_USE_BITMAP32
-    if (mBitCount == 32)
-        alphaType = kPremul_SkAlphaType;
-#endif
+    SkAlphaType alphaType = ReadAlphaType();
     SkBitmap bitmap;
     SkPixmap pixmap;
     if (imageSize(mImage) == mSize && mImage->imageInfo().alphaType() == alphaType
@@ -1295,10 +1425,13 @@ void SkiaSalBitmap::EnsureBitmapUniqueData()
     {
         sal_uInt32 allocate = mScanlineSize * mSize.Height();
 #ifdef DBG_UTIL
-        assert(memcmp(mBuffer.get() + allocate, CANARY, sizeof(CANARY)) == 0);
-        allocate += sizeof(CANARY);
+        verify();
+        boost::shared_ptr<sal_uInt8[]> newBuffer = allocatePixels(allocate + sizeof(CANARY));
+        memcpy(newBuffer.get() + allocate, CANARY, sizeof(CANARY));
+        mBufferAdopted = false;
+#else
+        boost::shared_ptr<sal_uInt8[]> newBuffer = allocatePixels(allocate);
 #endif
-        boost::shared_ptr<sal_uInt8[]> newBuffer = boost::make_shared_noinit<sal_uInt8[]>(allocate);
         memcpy(newBuffer.get(), mBuffer.get(), allocate);
         mBuffer = newBuffer;
     }
@@ -1403,7 +1536,7 @@ void SkiaSalBitmap::dump(const char* file) const
 #ifdef DBG_UTIL
 void SkiaSalBitmap::verify() const
 {
-    if (!mBuffer)
+    if (!mBuffer || mBufferAdopted)
         return;
     // Use mPixelsSize, that describes the size of the actual data.
     assert(memcmp(mBuffer.get() + mScanlineSize * mPixelsSize.Height(), CANARY, sizeof(CANARY))
@@ -11,6 +11,7 @@
 #include <vcl/bitmapex.hxx>
 #include <vcl/BitmapAlphaClampFilter.hxx>
 
+#include <bitmap/BitmapParallel.hxx>
 #include <bitmap/BitmapWriteAccess.hxx>
 
 BitmapEx BitmapAlphaClampFilter::execute(BitmapEx const& rBitmapEx) const
@@ -23,20 +24,24 @@ BitmapEx BitmapAlphaClampFilter::execute(BitmapEx const& rBitmapEx) const
         AlphaScopedWriteAccess pWriteAlpha(aBitmapAlpha);
         const Size aSize(rBitmapEx.GetSizePixel());
 
-        for (sal_Int32 nY = 0; nY < sal_Int32(aSize.Height()); ++nY)
-        {
-            Scanline pScanAlpha = pWriteAlpha->GetScanline(nY);
-
-            for (sal_Int32 nX = 0; nX < sal_Int32(aSize.Width()); ++nX)
-            {
-                BitmapColor aBitmapAlphaValue(pWriteAlpha->GetPixelFromData(pScanAlpha, nX));
-                if (aBitmapAlphaValue.GetIndex() > mcThreshold)
+        vcl::bitmap::parallelForRows(
+            aSize.Height(), aSize.Width(), [&](sal_Int32 nStartY, sal_Int32 nEndY) {
+                for (sal_Int32 nY = nStartY; nY <= nEndY; ++nY)
                 {
-                    aBitmapAlphaValue.SetIndex(255);
-                    pWriteAlpha->SetPixelOnData(pScanAlpha, nX, aBitmapAlphaValue);
+                    Scanline pScanAlpha = pWriteAlpha->GetScanline(nY);
+
+                    for (sal_Int32 nX = 0; nX < sal_Int32(aSize.Width()); ++nX)
+                    {
+                        BitmapColor aBitmapAlphaValue(
+                            pWriteAlpha->GetPixelFromData(pScanAlpha, nX));
+                        if (aBitmapAlphaValue.GetIndex() > mcThreshold)
+                        {
+                            aBitmapAlphaValue.SetIndex(255);
+                            pWriteAlpha->SetPixelOnData(pScanAlpha, nX, aBitmapAlphaValue);
+                        }
+                    }
                 }
-            }
-        }
+            });
     }
 
     return BitmapEx(rBitmapEx.GetBitmap(), aBitmapAlpha);
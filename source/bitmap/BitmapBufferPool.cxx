@@ -0,0 +1,139 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <bitmap/BitmapBufferPool.hxx>
+
+#include <cstdlib>
+#include <iterator>
+#include <new>
+
+namespace vcl::bitmap
+{
+namespace
+{
+// enough for a few full screen temporaries
+constexpr size_t MaxCachedBytes = 64 * 1024 * 1024;
+}
+
+BitmapBufferPool::BitmapBufferPool(size_t nMaxCachedBytes)
+    : mnMaxCachedBytes(nMaxCachedBytes)
+{
+}
+
+BitmapBufferPool::~BitmapBufferPool() { freeEntries(maFree); }
+
+BitmapBufferPool& BitmapBufferPool::get()
+{
+    // Deliberately leaked: buffers can still be released from static destructors at exit,
+    // e.g. by the last owner of a Skia bitmap, after a static pool would already be gone.
+    static BitmapBufferPool* const pPool
+        = new BitmapBufferPool(std::getenv("VCL_NO_BITMAP_POOL") ? 0 : MaxCachedBytes);
+    return *pPool;
+}
+
+size_t BitmapBufferPool::getSizeClass(size_t nBytes)
+{
+    if (nBytes < MinPooledBytes)
+        return nBytes;
+
+    // a quarter of the highest power of two in nBytes
+    size_t nStep = 1;
+    while (nStep * 8 <= nBytes)
+        nStep <<= 1;
+    return (nBytes + nStep - 1) & ~(nStep - 1);
+}
+
+sal_uInt8* BitmapBufferPool::Allocate(size_t nBytes)
+{
+    const size_t nSize = getSizeClass(nBytes);
+    if (nSize >= MinPooledBytes)
+    {
+        std::scoped_lock aGuard(maMutex);
+        // the most recently released one is the most likely to still be in the caches
+        for (auto it = maFree.rbegin(); it != maFree.rend(); ++it)
+        {
+            if (it->mnSize == nSize)
+            {
+                sal_uInt8* pBuffer = it->mpBuffer;
+                mnCachedBytes -= nSize;
+                maFree.erase(std::next(it).base());
+                return pBuffer;
+            }
+        }
+    }
+
+    sal_uInt8* pBuffer = new (std::nothrow) sal_uInt8[nSize];
+    if (!pBuffer && GetCachedBytes() != 0)
+    {
+        // the cached buffers of other sizes may be in the way
+        Trim();
+        pBuffer = new (std::nothrow) sal_uInt8[nSize];
+    }
+    return pBuffer;
+}
+
+void BitmapBufferPool::Release(sal_uInt8* pBuffer, size_t nBytes)
+{
+    if (!pBuffer)
+        return;
+
+    const size_t nSize = getSizeClass(nBytes);
+    if (nSize < MinPooledBytes || nSize > mnMaxCachedBytes)
+    {
+        delete[] pBuffer;
+        return;
+    }
+
+    std::vector<Entry> aFreed;
+    {
+        std::scoped_lock aGuard(maMutex);
+        maFree.push_back({ nSize, pBuffer });
+        mnCachedBytes += nSize;
+        evict(mnMaxCachedBytes, aFreed);
+    }
+    // unmapping big buffers takes a while, so not holding the lock
+    freeEntries(aFreed);
+}
+
+void BitmapBufferPool::Trim(size_t nKeepBytes)
+{
+    std::vector<Entry> aFreed;
+    {
+        std::scoped_lock aGuard(maMutex);
+        evict(nKeepBytes, aFreed);
+    }
+    freeEntries(aFreed);
+}
+
+size_t BitmapBufferPool::GetCachedBytes() const
+{
+    std::scoped_lock aGuard(maMutex);
+    return mnCachedBytes;
+}
+
+void BitmapBufferPool::freeEntries(const std::vector<Entry>& rEntries)
+{
+    for (const Entry& rEntry : rEntries)
+        delete[] rEntry.mpBuffer;
+}
+
+void BitmapBufferPool::evict(size_t nKeepBytes, std::vector<Entry>& rFreed)
+{
+    auto it = maFree.begin();
+    for (; it != maFree.end() && mnCachedBytes > nKeepBytes; ++it)
+    {
+        mnCachedBytes -= it->mnSize;
+        rFreed.push_back(*it);
+    }
+    maFree.erase(maFree.begin(), it);
+}
+
+} // end vcl::bitmap
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
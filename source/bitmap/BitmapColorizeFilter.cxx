@@ -11,6 +11,7 @@
 #include <tools/color.hxx>
 #include <tools/helpers.hxx>
 
+#include <bitmap/BitmapParallel.hxx>
 #include <bitmap/BitmapWriteAccess.hxx>
 #include <bitmap/BitmapColorizeFilter.hxx>
 
@@ -29,7 +30,6 @@ BitmapEx BitmapColorizeFilter::execute(BitmapEx const& rBitmapEx) const
     std::vector<sal_uInt8> aMapG(256);
     std::vector<sal_uInt8> aMapB(256);
     sal_Int32 nX;
-    sal_Int32 nY;
 
     const sal_uInt8 cR = maColor.GetRed();
     const sal_uInt8 cG = maColor.GetGreen();
@@ -55,35 +55,40 @@ BitmapEx BitmapColorizeFilter::execute(BitmapEx const& rBitmapEx) const
     }
     else if (pWriteAccess->GetScanlineFormat() == ScanlineFormat::N24BitTcBgr)
     {
-        for (nY = 0; nY < nH; ++nY)
-        {
-            Scanline pScan = pWriteAccess->GetScanline(nY);
-
-            for (nX = 0; nX < nW; ++nX)
+        vcl::bitmap::parallelForRows(nH, nW, [&](sal_Int32 nStartY, sal_Int32 nEndY) {
+            for (sal_Int32 nRow = nStartY; nRow <= nEndY; ++nRow)
             {
-                *pScan = aMapB[*pScan];
-                pScan++;
-                *pScan = aMapG[*pScan];
-                pScan++;
-                *pScan = aMapR[*pScan];
-                pScan++;
+                Scanline pScan = pWriteAccess->GetScanline(nRow);
+
+                for (sal_Int32 nCol = 0; nCol < nW; ++nCol)
+                {
+                    *pScan = aMapB[*pScan];
+                    pScan++;
+                    *pScan = aMapG[*pScan];
+                    pScan++;
+                    *pScan = aMapR[*pScan];
+                    pScan++;
+                }
             }
-        }
+        });
     }
     else
     {
-        for (nY = 0; nY < nH; ++nY)
-        {
-            Scanline pScanline = pWriteAccess->GetScanline(nY);
-            for (nX = 0; nX < nW; ++nX)
+        vcl::bitmap::parallelForRows(nH, nW, [&](sal_Int32 nStartY, sal_Int32 nEndY) {
+            BitmapColor aColor;
+            for (sal_Int32 nRow = nStartY; nRow <= nEndY; ++nRow)
             {
-                aBitmapColor = pWriteAccess->GetPixelFromData(pScanline, nX);
-                aBitmapColor.SetRed(aMapR[aBitmapColor.GetRed()]);
-                aBitmapColor.SetGreen(aMapG[aBitmapColor.GetGreen()]);
-                aBitmapColor.SetBlue(aMapB[aBitmapColor.GetBlue()]);
-                pWriteAccess->SetPixelOnData(pScanline, nX, aBitmapColor);
+                Scanline pScanline = pWriteAccess->GetScanline(nRow);
+                for (sal_Int32 nCol = 0; nCol < nW; ++nCol)
+                {
+                    aColor = pWriteAccess->GetPixelFromData(pScanline, nCol);
+                    aColor.SetRed(aMapR[aColor.GetRed()]);
+                    aColor.SetGreen(aMapG[aColor.GetGreen()]);
+                    aColor.SetBlue(aMapB[aColor.GetBlue()]);
+                    pWriteAccess->SetPixelOnData(pScanline, nCol, aColor);
+                }
             }
-        }
+        });
     }
 
     return rBitmapEx;
@@ -15,6 +15,7 @@
 #include <vcl/BitmapConvolutionMatrixFilter.hxx>
 #include <vcl/BitmapSharpenFilter.hxx>
 
+#include <bitmap/BitmapParallel.hxx>
 #include <bitmap/BitmapWriteAccess.hxx>
 
 #include <array>
@@ -38,28 +39,20 @@ BitmapEx BitmapConvolutionMatrixFilter::execute(BitmapEx const& rBitmapEx) const
             const sal_Int32 nHeight = pWriteAcc->Height(), nHeight2 = nHeight + 2;
             std::unique_ptr<sal_Int32[]> pColm(new sal_Int32[nWidth2]);
             std::unique_ptr<sal_Int32[]> pRows(new sal_Int32[nHeight2]);
-            std::unique_ptr<BitmapColor[]> pColRow1(new BitmapColor[nWidth2]);
-            std::unique_ptr<BitmapColor[]> pColRow2(new BitmapColor[nWidth2]);
-            std::unique_ptr<BitmapColor[]> pColRow3(new BitmapColor[nWidth2]);
-            BitmapColor* pRowTmp1 = pColRow1.get();
-            BitmapColor* pRowTmp2 = pColRow2.get();
-            BitmapColor* pRowTmp3 = pColRow3.get();
-            BitmapColor* pColor;
-            sal_Int32 nY, nX, i, nSumR, nSumG, nSumB, nMatrixVal, nTmp;
             std::array<std::array<sal_Int32, 256>, 9> aKoeff;
-            sal_Int32* pTmp;
 
             // create LUT of products of matrix value and possible color component values
-            for (nY = 0; nY < 9; nY++)
+            for (sal_Int32 nY = 0; nY < 9; nY++)
             {
-                for (nX = nTmp = 0, nMatrixVal = mrMatrix[nY]; nX < 256; nX++, nTmp += nMatrixVal)
+                const sal_Int32 nMatrixVal = mrMatrix[nY];
+                for (sal_Int32 nX = 0, nTmp = 0; nX < 256; nX++, nTmp += nMatrixVal)
                 {
                     aKoeff[nY][nX] = nTmp;
                 }
             }
 
             // create column LUT
-            for (i = 0; i < nWidth2; i++)
+            for (sal_Int32 i = 0; i < nWidth2; i++)
             {
                 pColm[i] = (i > 0) ? (i - 1) : 0;
             }
@@ -67,113 +60,125 @@ BitmapEx BitmapConvolutionMatrixFilter::execute(BitmapEx const& rBitmapEx) const
             pColm[nWidth + 1] = pColm[nWidth];
 
             // create row LUT
-            for (i = 0; i < nHeight2; i++)
+            for (sal_Int32 i = 0; i < nHeight2; i++)
             {
                 pRows[i] = (i > 0) ? (i - 1) : 0;
             }
 
             pRows[nHeight + 1] = pRows[nHeight];
 
-            // read first three rows of bitmap color
-            for (i = 0; i < nWidth2; i++)
-            {
-                pColRow1[i] = pReadAcc->GetColor(pRows[0], pColm[i]);
-                pColRow2[i] = pReadAcc->GetColor(pRows[1], pColm[i]);
-                pColRow3[i] = pReadAcc->GetColor(pRows[2], pColm[i]);
-            }
-
-            // do convolution
-            for (nY = 0; nY < nHeight;)
-            {
-                Scanline pScanline = pWriteAcc->GetScanline(nY);
-                for (nX = 0; nX < nWidth; nX++)
+            // do convolution, every strip reads the rows around it on its own
+            vcl::bitmap::parallelForRows(nHeight, nWidth, [&](sal_Int32 nStartY, sal_Int32 nEndY) {
+                std::unique_ptr<BitmapColor[]> pColRow1(new BitmapColor[nWidth2]);
+                std::unique_ptr<BitmapColor[]> pColRow2(new BitmapColor[nWidth2]);
+                std::unique_ptr<BitmapColor[]> pColRow3(new BitmapColor[nWidth2]);
+                BitmapColor* pRowTmp1 = pColRow1.get();
+                BitmapColor* pRowTmp2 = pColRow2.get();
+                BitmapColor* pRowTmp3 = pColRow3.get();
+                BitmapColor* pColor;
+                sal_Int32 nSumR, nSumG, nSumB;
+                sal_Int32* pTmp;
+
+                // read first three rows of bitmap color
+                for (sal_Int32 i = 0; i < nWidth2; i++)
                 {
-                    // first row
-                    pTmp = aKoeff[0].data();
-                    pColor = pRowTmp1 + nX;
-                    nSumR = pTmp[pColor->GetRed()];
-                    nSumG = pTmp[pColor->GetGreen()];
-                    nSumB = pTmp[pColor->GetBlue()];
-
-                    pTmp = aKoeff[1].data();
-                    nSumR += pTmp[(++pColor)->GetRed()];
-                    nSumG += pTmp[pColor->GetGreen()];
-                    nSumB += pTmp[pColor->GetBlue()];
-
-                    pTmp = aKoeff[2].data();
-                    nSumR += pTmp[(++pColor)->GetRed()];
-                    nSumG += pTmp[pColor->GetGreen()];
-                    nSumB += pTmp[pColor->GetBlue()];
-
-                    // second row
-                    pTmp = aKoeff[3].data();
-                    pColor = pRowTmp2 + nX;
-                    nSumR += pTmp[pColor->GetRed()];
-                    nSumG += pTmp[pColor->GetGreen()];
-                    nSumB += pTmp[pColor->GetBlue()];
-
-                    pTmp = aKoeff[4].data();
-                    nSumR += pTmp[(++pColor)->GetRed()];
-                    nSumG += pTmp[pColor->GetGreen()];
-                    nSumB += pTmp[pColor->GetBlue()];
-
-                    pTmp = aKoeff[5].data();
-                    nSumR += pTmp[(++pColor)->GetRed()];
-                    nSumG += pTmp[pColor->GetGreen()];
-                    nSumB += pTmp[pColor->GetBlue()];
-
-                    // third row
-                    pTmp = aKoeff[6].data();
-                    pColor = pRowTmp3 + nX;
-                    nSumR += pTmp[pColor->GetRed()];
-                    nSumG += pTmp[pColor->GetGreen()];
-                    nSumB += pTmp[pColor->GetBlue()];
-
-                    pTmp = aKoeff[7].data();
-                    nSumR += pTmp[(++pColor)->GetRed()];
-                    nSumG += pTmp[pColor->GetGreen()];
-                    nSumB += pTmp[pColor->GetBlue()];
-
-                    pTmp = aKoeff[8].data();
-                    nSumR += pTmp[(++pColor)->GetRed()];
-                    nSumG += pTmp[pColor->GetGreen()];
-                    nSumB += pTmp[pColor->GetBlue()];
-
-                    // calculate destination color
-                    pWriteAcc->SetPixelOnData(
-                        pScanline, nX,
-                        BitmapColor(static_cast<sal_uInt8>(MinMax(nSumR / nDivisor, 0, 255)),
-                                    static_cast<sal_uInt8>(MinMax(nSumG / nDivisor, 0, 255)),
-                                    static_cast<sal_uInt8>(MinMax(nSumB / nDivisor, 0, 255))));
+                    pColRow1[i] = pReadAcc->GetColor(pRows[nStartY], pColm[i]);
+                    pColRow2[i] = pReadAcc->GetColor(pRows[nStartY + 1], pColm[i]);
+                    pColRow3[i] = pReadAcc->GetColor(pRows[nStartY + 2], pColm[i]);
                 }
 
-                if (++nY < nHeight)
+                for (sal_Int32 nY = nStartY; nY <= nEndY;)
                 {
-                    if (pRowTmp1 == pColRow1.get())
+                    Scanline pScanline = pWriteAcc->GetScanline(nY);
+                    for (sal_Int32 nX = 0; nX < nWidth; nX++)
                     {
-                        pRowTmp1 = pColRow2.get();
-                        pRowTmp2 = pColRow3.get();
-                        pRowTmp3 = pColRow1.get();
-                    }
-                    else if (pRowTmp1 == pColRow2.get())
-                    {
-                        pRowTmp1 = pColRow3.get();
-                        pRowTmp2 = pColRow1.get();
-                        pRowTmp3 = pColRow2.get();
-                    }
-                    else
-                    {
-                        pRowTmp1 = pColRow1.get();
-                        pRowTmp2 = pColRow2.get();
-                        pRowTmp3 = pColRow3.get();
+                        // first row
+                        pTmp = aKoeff[0].data();
+                        pColor = pRowTmp1 + nX;
+                        nSumR = pTmp[pColor->GetRed()];
+                        nSumG = pTmp[pColor->GetGreen()];
+                        nSumB = pTmp[pColor->GetBlue()];
+
+                        pTmp = aKoeff[1].data();
+                        nSumR += pTmp[(++pColor)->GetRed()];
+                        nSumG += pTmp[pColor->GetGreen()];
+                        nSumB += pTmp[pColor->GetBlue()];
+
+                        pTmp = aKoeff[2].data();
+                        nSumR += pTmp[(++pColor)->GetRed()];
+                        nSumG += pTmp[pColor->GetGreen()];
+                        nSumB += pTmp[pColor->GetBlue()];
+
+                        // second row
+                        pTmp = aKoeff[3].data();
+                        pColor = pRowTmp2 + nX;
+                        nSumR += pTmp[pColor->GetRed()];
+                        nSumG += pTmp[pColor->GetGreen()];
+                        nSumB += pTmp[pColor->GetBlue()];
+
+                        pTmp = aKoeff[4].data();
+                        nSumR += pTmp[(++pColor)->GetRed()];
+                        nSumG += pTmp[pColor->GetGreen()];
+                        nSumB += pTmp[pColor->GetBlue()];
+
+                        pTmp = aKoeff[5].data();
+                        nSumR += pTmp[(++pColor)->GetRed()];
+                        nSumG += pTmp[pColor->GetGreen()];
+                        nSumB += pTmp[pColor->GetBlue()];
+
+                        // third row
+                        pTmp = aKoeff[6].data();
+                        pColor = pRowTmp3 + nX;
+                        nSumR += pTmp[pColor->GetRed()];
+                        nSumG += pTmp[pColor->GetGreen()];
+                        nSumB += pTmp[pColor->GetBlue()];
+
+                        pTmp = aKoeff[7].data();
+                        nSumR += pTmp[(++pColor)->GetRed()];
+                        nSumG += pTmp[pColor->GetGreen()];
+                        nSumB += pTmp[pColor->GetBlue()];
+
+                        pTmp = aKoeff[8].data();
+                        nSumR += pTmp[(++pColor)->GetRed()];
+                        nSumG += pTmp[pColor->GetGreen()];
+                        nSumB += pTmp[pColor->GetBlue()];
+
+                        // calculate destination color
+                        pWriteAcc->SetPixelOnData(
+                            pScanline, nX,
+                            BitmapColor(static_cast<sal_uInt8>(MinMax(nSumR / nDivisor, 0, 255)),
+                                        static_cast<sal_uInt8>(MinMax(nSumG / nDivisor, 0, 255)),
+                                        static_cast<sal_uInt8>(MinMax(nSumB / nDivisor, 0, 255))));
                     }
 
-                    for (i = 0; i < nWidth2; i++)
+                    if (++nY <= nEndY)
                     {
-                        pRowTmp3[i] = pReadAcc->GetColor(pRows[nY + 2], pColm[i]);
+                        if (pRowTmp1 == pColRow1.get())
+                        {
+                            pRowTmp1 = pColRow2.get();
+                            pRowTmp2 = pColRow3.get();
+                            pRowTmp3 = pColRow1.get();
+                        }
+                        else if (pRowTmp1 == pColRow2.get())
+                        {
+                            pRowTmp1 = pColRow3.get();
+                            pRowTmp2 = pColRow1.get();
+                            pRowTmp3 = pColRow2.get();
+                        }
+                        else
+                        {
+                            pRowTmp1 = pColRow1.get();
+                            pRowTmp2 = pColRow2.get();
+                            pRowTmp3 = pColRow3.get();
+                        }
+
+                        for (sal_Int32 i = 0; i < nWidth2; i++)
+                        {
+                            pRowTmp3[i] = pReadAcc->GetColor(pRows[nY + 2], pColm[i]);
+                        }
                     }
                 }
-            }
+            });
 
             pWriteAcc.reset();
 
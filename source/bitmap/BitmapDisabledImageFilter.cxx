@@ -8,6 +8,7 @@
  *
  */
 
+#include <bitmap/BitmapParallel.hxx>
 #include <bitmap/BitmapWriteAccess.hxx>
 #include <bitmap/BitmapDisabledImageFilter.hxx>
 
@@ -31,20 +32,24 @@ BitmapEx BitmapDisabledImageFilter::execute(BitmapEx const& rBitmapEx) const
     Bitmap::ScopedReadAccess pRead(aReadBitmap);
     if (pRead && pGrey)
     {
-        for (sal_Int32 nY = 0; nY < sal_Int32(aSize.Height()); ++nY)
-        {
-            Scanline pGreyScan = pGrey->GetScanline(nY);
-            Scanline pReadScan = pRead->GetScanline(nY);
-
-            for (sal_Int32 nX = 0; nX < sal_Int32(aSize.Width()); ++nX)
-            {
-                // Get the luminance from RGB color and remap the value from 0-255 to 160-224
-                const BitmapColor aColor = pRead->GetPixelFromData(pReadScan, nX);
-                sal_uInt8 nLum(aColor.GetLuminance() / 4 + 160);
-                BitmapColor aGreyValue(ColorAlpha, nLum, nLum, nLum, aColor.GetAlpha());
-                pGrey->SetPixelOnData(pGreyScan, nX, aGreyValue);
-            }
-        }
+        vcl::bitmap::parallelForRows(
+            aSize.Height(), aSize.Width(), [&](sal_Int32 nStartY, sal_Int32 nEndY) {
+                for (sal_Int32 nY = nStartY; nY <= nEndY; ++nY)
+                {
+                    Scanline pGreyScan = pGrey->GetScanline(nY);
+                    Scanline pReadScan = pRead->GetScanline(nY);
+
+                    for (sal_Int32 nX = 0; nX < sal_Int32(aSize.Width()); ++nX)
+                    {
+                        // Get the luminance from RGB color and remap the value from 0-255
+                        // to 160-224
+                        const BitmapColor aColor = pRead->GetPixelFromData(pReadScan, nX);
+                        sal_uInt8 nLum(aColor.GetLuminance() / 4 + 160);
+                        BitmapColor aGreyValue(ColorAlpha, nLum, nLum, nLum, aColor.GetAlpha());
+                        pGrey->SetPixelOnData(pGreyScan, nX, aGreyValue);
+                    }
+                }
+            });
     }
 
     if (rBitmapEx.IsAlpha())
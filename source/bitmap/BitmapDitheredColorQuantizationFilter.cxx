@@ -0,0 +1,49 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ */
+
+#include <sal/config.h>
+
+#include <vcl/bitmap.hxx>
+#include <vcl/bitmapex.hxx>
+
+#include <bitmap/BitmapDitheredColorQuantizationFilter.hxx>
+#include <bitmap/BitmapWriteAccess.hxx>
+
+#include <algorithm>
+
+BitmapEx BitmapDitheredColorQuantizationFilter::execute(BitmapEx const& aBitmapEx) const
+{
+    Bitmap aBitmap = aBitmapEx.GetBitmap();
+
+    if (vcl::numberOfColors(aBitmap.getPixelFormat()) <= sal_Int64(mnNewColorCount))
+        return BitmapEx(aBitmap);
+
+    Bitmap::ScopedReadAccess pRAcc(aBitmap);
+    if (!pRAcc)
+        return BitmapEx();
+
+    WuQuantizer aQuantizer(*pRAcc, std::min(mnNewColorCount, sal_uInt16(256)));
+    const BitmapPalette& rNewPal = aQuantizer.GetPalette();
+
+    Bitmap aNewBmp(aBitmap.GetSizePixel(), vcl::PixelFormat::N8_BPP, &rNewPal);
+    {
+        BitmapScopedWriteAccess pWAcc(aNewBmp);
+        if (!pWAcc)
+            return BitmapEx();
+        aQuantizer.Map(*pRAcc, *pWAcc, meDither);
+    }
+    pRAcc.reset();
+
+    aNewBmp.SetPrefMapMode(aBitmap.GetPrefMapMode());
+    aNewBmp.SetPrefSize(aBitmap.GetPrefSize());
+    return BitmapEx(aNewBmp);
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
@@ -12,6 +12,7 @@
 #include <vcl/bitmapex.hxx>
 #include <vcl/BitmapDuoToneFilter.hxx>
 
+#include <bitmap/BitmapParallel.hxx>
 #include <bitmap/BitmapWriteAccess.hxx>
 
 static sal_uInt8 lcl_getDuotoneColorComponent(sal_uInt8 base, sal_uInt16 color1, sal_uInt16 color2)
@@ -35,20 +36,25 @@ BitmapEx BitmapDuoToneFilter::execute(BitmapEx const& rBitmapEx) const
     const BitmapColor aColorOne(mnColorOne);
     const BitmapColor aColorTwo(mnColorTwo);
 
-    for (sal_Int32 x = 0; x < nWidth; x++)
-    {
-        for (sal_Int32 y = 0; y < nHeight; y++)
+    // row by row, so that the strips don't share cache lines of the result
+    vcl::bitmap::parallelForRows(nHeight, nWidth, [&](sal_Int32 nStartY, sal_Int32 nEndY) {
+        for (sal_Int32 y = nStartY; y <= nEndY; y++)
         {
-            BitmapColor aColor = pReadAcc->GetColor(y, x);
-            sal_uInt8 nLuminance = aColor.GetLuminance();
-            BitmapColor aResultColor(
-                lcl_getDuotoneColorComponent(nLuminance, aColorOne.GetRed(), aColorTwo.GetRed()),
-                lcl_getDuotoneColorComponent(nLuminance, aColorOne.GetGreen(),
-                                             aColorTwo.GetGreen()),
-                lcl_getDuotoneColorComponent(nLuminance, aColorOne.GetBlue(), aColorTwo.GetBlue()));
-            pWriteAcc->SetPixel(y, x, aResultColor);
+            for (sal_Int32 x = 0; x < nWidth; x++)
+            {
+                BitmapColor aColor = pReadAcc->GetColor(y, x);
+                sal_uInt8 nLuminance = aColor.GetLuminance();
+                BitmapColor aResultColor(
+                    lcl_getDuotoneColorComponent(nLuminance, aColorOne.GetRed(),
+                                                 aColorTwo.GetRed()),
+                    lcl_getDuotoneColorComponent(nLuminance, aColorOne.GetGreen(),
+                                                 aColorTwo.GetGreen()),
+                    lcl_getDuotoneColorComponent(nLuminance, aColorOne.GetBlue(),
+                                                 aColorTwo.GetBlue()));
+                pWriteAcc->SetPixel(y, x, aResultColor);
+            }
         }
-    }
+    });
 
     pWriteAcc.reset();
     pReadAcc.reset();
@@ -19,6 +19,7 @@
 
 #include <sal/log.hxx>
 #include <rtl/math.hxx>
+#include <tools/simdsupport.hxx>
 #include <o3tl/underlyingenumvalue.hxx>
 #include <osl/diagnose.h>
 #include <basegfx/matrix/b2dhommatrixtools.hxx>
@@ -39,12 +40,22 @@
 #include <svdata.hxx>
 #include <bitmap/BitmapWriteAccess.hxx>
 #include <bitmap/BitmapMaskToAlphaFilter.hxx>
+#include <bitmap/BitmapParallel.hxx>
+#include <bitmap/BitmapRegionAccess.hxx>
 
 #include <o3tl/any.hxx>
 
 #include <com/sun/star/beans/XFastPropertySet.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <memory>
+#include <vector>
+
+#ifdef LO_SSE2_AVAILABLE
+#include <emmintrin.h>
+#endif
 
 using namespace ::com::sun::star;
 
@@ -582,11 +593,12 @@ sal_uInt8 BitmapEx::GetAlpha(sal_Int32 nX, sal_Int32 nY) const
     else
     {
         Bitmap aTestBitmap(maAlphaMask);
-        Bitmap::ScopedReadAccess pRead(aTestBitmap);
+        vcl::bitmap::BitmapRegionAccess aRead(aTestBitmap,
+                                              tools::Rectangle(Point(nX, nY), Size(1, 1)));
 
-        if(pRead)
+        if(aRead)
         {
-            const BitmapColor aBitmapColor(pRead->GetPixel(nY, nX));
+            const BitmapColor aBitmapColor(aRead.GetPixel(0, 0));
             nAlpha = 255 - aBitmapColor.GetIndex();
         }
     }
@@ -596,16 +608,18 @@ sal_uInt8 BitmapEx::GetAlpha(sal_Int32 nX, sal_Int32 nY) const
 
 Color BitmapEx::GetPixelColor(sal_Int32 nX, sal_Int32 nY) const
 {
-    Bitmap::ScopedReadAccess pReadAccess( const_cast<Bitmap&>(maBitmap) );
-    assert(pReadAccess);
+    // only this pixel has to be read, not the whole bitmap
+    const tools::Rectangle aPixel(Point(nX, nY), Size(1, 1));
+    vcl::bitmap::BitmapRegionAccess aReadAccess(const_cast<Bitmap&>(maBitmap), aPixel);
+    assert(aReadAccess);
 
-    BitmapColor aColor = pReadAccess->GetColor(nY, nX);
+    BitmapColor aColor = aReadAccess.GetColor(0, 0);
 
     if (IsAlpha())
     {
-        AlphaMask aAlpha = GetAlpha();
-        AlphaMask::ScopedReadAccess pAlphaReadAccess(aAlpha);
-        aColor.SetAlpha(255 - pAlphaReadAccess->GetPixel(nY, nX).GetIndex());
+        Bitmap aAlpha(maAlphaMask.GetBitmap());
+        vcl::bitmap::BitmapRegionAccess aAlphaReadAccess(aAlpha, aPixel);
+        aColor.SetAlpha(255 - aAlphaReadAccess.GetPixel(0, 0).GetIndex());
     }
     else if (maBitmap.getPixelFormat() != vcl::PixelFormat::N32_BPP)
     {
@@ -658,6 +672,265 @@ bool BitmapEx::Create( const css::uno::Reference< css::rendering::XBitmapCanvas
 
 namespace
 {
+#ifdef LO_SSE2_AVAILABLE
+    __m128i loadPixelSSE2(const sal_uInt8* pPixel)
+    {
+        sal_Int32 nPixel;
+        memcpy(&nPixel, pPixel, 4);
+        return _mm_cvtsi32_si128(nPixel);
+    }
+
+    // two 16 bit weights for _mm_madd_epi16
+    __m128i weightPairSSE2(sal_Int16 nWeight0, sal_Int16 nWeight1)
+    {
+        const sal_uInt32 nLow(static_cast<sal_uInt16>(nWeight0));
+        const sal_uInt32 nHigh(static_cast<sal_uInt16>(nWeight1));
+        return _mm_set1_epi32(static_cast<sal_Int32>((nHigh << 16) | nLow));
+    }
+#endif
+
+    // Source coordinates are stepped in fixed point with this many fractional bits ...
+    constexpr int AffineShift = 32;
+    constexpr sal_Int64 AffineOne = sal_Int64(1) << AffineShift;
+    // ... and the bilinear weights of the four pixels around them have 7 bits per axis, so that
+    // their products still fit into the 16 bits of _mm_madd_epi16 and add up to 1 << 14.
+    constexpr int AffineWeightBits = 7;
+    constexpr sal_Int32 AffineWeightOne = 1 << AffineWeightBits;
+
+    // white, like the fallback of impTransformBitmap()
+    const sal_uInt8 aAffineOutside[4] = { 0xff, 0xff, 0xff, 0xff };
+
+    // Narrows [rStart, rEnd) to the x with 0 <= fOrigin + x * fStep < nSize, give or take a
+    // pixel, which the fixed point coordinates then settle.
+    void impClipAffineSpan(double fOrigin, double fStep, sal_Int32 nSize,
+                           double& rStart, double& rEnd)
+    {
+        if(fStep == 0.0)
+        {
+            if(fOrigin < 0.0 || fOrigin >= nSize)
+            {
+                rEnd = rStart;
+            }
+            return;
+        }
+
+        const double fFirst(-fOrigin / fStep);
+        const double fLast((nSize - fOrigin) / fStep);
+        rStart = std::max(rStart, std::min(fFirst, fLast) - 1.0);
+        rEnd = std::min(rEnd, std::max(fFirst, fLast) + 1.0);
+    }
+
+    struct AffineSource
+    {
+        const sal_uInt8* mpPixels; // four bytes per pixel, see impReadAffineSource()
+        sal_Int32 mnWidth;
+        sal_Int32 mnHeight;
+
+        bool isInside(sal_Int64 nU, sal_Int64 nV) const
+        {
+            return nU >= 0 && nV >= 0
+                && (nU >> AffineShift) < mnWidth && (nV >> AffineShift) < mnHeight;
+        }
+
+        // the pixel, or the outside color if it is beyond the borders
+        const sal_uInt8* getPixel(sal_Int32 nX, sal_Int32 nY) const
+        {
+            if(nX < 0 || nY < 0 || nX >= mnWidth || nY >= mnHeight)
+            {
+                return aAffineOutside;
+            }
+            return mpPixels + 4 * (sal_Int64(nY) * mnWidth + nX);
+        }
+    };
+
+    // Bilinear filtering between the centers of the four pixels around (nU, nV), pixels beyond
+    // the borders count as the outside color like in GetInterpolatedColorWithFallback().
+    void impInterpolateAffine(const AffineSource& rSource, sal_Int64 nU, sal_Int64 nV,
+                              sal_uInt8* pResult)
+    {
+        nU -= AffineOne / 2;
+        nV -= AffineOne / 2;
+        const sal_Int32 nX(nU >> AffineShift);
+        const sal_Int32 nY(nV >> AffineShift);
+        const sal_Int32 nFracX((nU >> (AffineShift - AffineWeightBits)) & (AffineWeightOne - 1));
+        const sal_Int32 nFracY((nV >> (AffineShift - AffineWeightBits)) & (AffineWeightOne - 1));
+        const sal_Int16 nWeight00((AffineWeightOne - nFracX) * (AffineWeightOne - nFracY));
+        const sal_Int16 nWeight01(nFracX * (AffineWeightOne - nFracY));
+        const sal_Int16 nWeight10((AffineWeightOne - nFracX) * nFracY);
+        const sal_Int16 nWeight11(nFracX * nFracY);
+        const sal_uInt8* p00(rSource.getPixel(nX, nY));
+        const sal_uInt8* p01(rSource.getPixel(nX + 1, nY));
+        const sal_uInt8* p10(rSource.getPixel(nX, nY + 1));
+        const sal_uInt8* p11(rSource.getPixel(nX + 1, nY + 1));
+
+#ifdef LO_SSE2_AVAILABLE
+        const __m128i aZero(_mm_setzero_si128());
+        // the channels of each pair of pixels interleaved in 16 bits, to weight them in one go
+        const __m128i aTop(_mm_unpacklo_epi8(
+            _mm_unpacklo_epi8(loadPixelSSE2(p00), loadPixelSSE2(p01)), aZero));
+        const __m128i aBottom(_mm_unpacklo_epi8(
+            _mm_unpacklo_epi8(loadPixelSSE2(p10), loadPixelSSE2(p11)), aZero));
+        __m128i aValues(_mm_add_epi32(
+            _mm_madd_epi16(aTop, weightPairSSE2(nWeight00, nWeight01)),
+            _mm_madd_epi16(aBottom, weightPairSSE2(nWeight10, nWeight11))));
+        aValues = _mm_srli_epi32(
+            _mm_add_epi32(aValues, _mm_set1_epi32(1 << (2 * AffineWeightBits - 1))),
+            2 * AffineWeightBits);
+        aValues = _mm_packus_epi16(_mm_packs_epi32(aValues, aZero), aZero);
+        const sal_Int32 nPixel(_mm_cvtsi128_si32(aValues));
+        memcpy(pResult, &nPixel, 3);
+#else
+        for(int i(0); i < 3; i++)
+        {
+            pResult[i] = (p00[i] * nWeight00 + p01[i] * nWeight01 + p10[i] * nWeight10
+                          + p11[i] * nWeight11 + (1 << (2 * AffineWeightBits - 1)))
+                         >> (2 * AffineWeightBits);
+        }
+#endif
+    }
+
+    // Fills the 24 bit row pDestination of nWidth pixels, whose source coordinates start at
+    // rOrigin and go on in steps of rStep.
+    void impTransformAffineRow(const AffineSource& rSource, const basegfx::B2DPoint& rOrigin,
+                               const basegfx::B2DVector& rStep, sal_Int32 nWidth, bool bSmooth,
+                               sal_uInt8* pDestination)
+    {
+        // only the span of the row that lies on the source needs sampling
+        double fStart(0.0);
+        double fEnd(nWidth);
+        impClipAffineSpan(rOrigin.getX(), rStep.getX(), rSource.mnWidth, fStart, fEnd);
+        impClipAffineSpan(rOrigin.getY(), rStep.getY(), rSource.mnHeight, fStart, fEnd);
+        if(!(fStart < fEnd))
+        {
+            memset(pDestination, 0xff, 3 * nWidth);
+            return;
+        }
+        sal_Int32 nStart(static_cast<sal_Int32>(std::max(0.0, std::floor(fStart))));
+        sal_Int32 nEnd(static_cast<sal_Int32>(std::min(double(nWidth), std::ceil(fEnd))));
+
+        const sal_Int64 nStepU(std::llround(rStep.getX() * AffineOne));
+        const sal_Int64 nStepV(std::llround(rStep.getY() * AffineOne));
+        sal_Int64 nU(std::llround((rOrigin.getX() + nStart * rStep.getX()) * AffineOne));
+        sal_Int64 nV(std::llround((rOrigin.getY() + nStart * rStep.getY()) * AffineOne));
+
+        while(nStart < nEnd && !rSource.isInside(nU, nV))
+        {
+            nStart++;
+            nU += nStepU;
+            nV += nStepV;
+        }
+        while(nEnd > nStart
+              && !rSource.isInside(nU + (nEnd - 1 - nStart) * nStepU,
+                                   nV + (nEnd - 1 - nStart) * nStepV))
+        {
+            nEnd--;
+        }
+
+        memset(pDestination, 0xff, 3 * nStart);
+        memset(pDestination + 3 * nEnd, 0xff, 3 * (nWidth - nEnd));
+
+        sal_uInt8* pResult(pDestination + 3 * nStart);
+        if(bSmooth)
+        {
+            for(sal_Int32 x(nStart); x < nEnd; x++, pResult += 3, nU += nStepU, nV += nStepV)
+            {
+                impInterpolateAffine(rSource, nU, nV, pResult);
+            }
+        }
+        else
+        {
+            for(sal_Int32 x(nStart); x < nEnd; x++, pResult += 3, nU += nStepU, nV += nStepV)
+            {
+                memcpy(pResult, rSource.getPixel(nU >> AffineShift, nV >> AffineShift), 3);
+            }
+        }
+    }
+
+    // Reads the source with four bytes per pixel, the colors in the order of the 24 bit
+    // destination and the fourth byte unused, so that every pixel is a single 32 bit load.
+    std::vector<sal_uInt8> impReadAffineSource(const BitmapReadAccess& rRead, bool bBgr)
+    {
+        const sal_Int32 nWidth(rRead.Width());
+        const sal_Int32 nHeight(rRead.Height());
+        std::vector<sal_uInt8> aPixels(sal_Int64(4) * nWidth * nHeight);
+
+        vcl::bitmap::parallelForRows(nHeight, nWidth, [&](sal_Int32 nStartY, sal_Int32 nEndY) {
+            for(sal_Int32 y(nStartY); y <= nEndY; y++)
+            {
+                const Scanline pScanline(rRead.GetScanline(y));
+                sal_uInt8* pPixel(aPixels.data() + sal_Int64(4) * nWidth * y);
+
+                for(sal_Int32 x(0); x < nWidth; x++, pPixel += 4)
+                {
+                    const BitmapColor aColor(rRead.HasPalette()
+                        ? rRead.GetPaletteColor(rRead.GetIndexFromData(pScanline, x))
+                        : rRead.GetPixelFromData(pScanline, x));
+                    pPixel[0] = bBgr ? aColor.GetBlue() : aColor.GetRed();
+                    pPixel[1] = aColor.GetGreen();
+                    pPixel[2] = bBgr ? aColor.GetRed() : aColor.GetBlue();
+                    pPixel[3] = 0;
+                }
+            }
+        });
+
+        return aPixels;
+    }
+
+    /** Resamples rRead into the 24 bit rWrite a row at a time.
+
+        Instead of transforming every destination pixel on its own, the source coordinates of
+        a row are stepped incrementally in fixed point, the parts of the row that map outside
+        of the source are just filled with the outside color, and the rows are done in
+        parallel. Gives false if the destination format or the transformation do not suit it.
+    */
+    bool impTransformBitmapAffine(
+        const BitmapReadAccess& rRead,
+        BitmapWriteAccess& rWrite,
+        const basegfx::B2DHomMatrix& rTransform,
+        bool bSmooth)
+    {
+        const ScanlineFormat eFormat(rWrite.GetScanlineFormat());
+        if(eFormat != ScanlineFormat::N24BitTcBgr && eFormat != ScanlineFormat::N24BitTcRgb)
+        {
+            return false;
+        }
+
+        // the fixed point coordinates need a sane step and leave 31 bits for the pixel position
+        constexpr double fMaxStep(1 << 20);
+        for(sal_uInt16 nRow(0); nRow < 2; nRow++)
+        {
+            for(sal_uInt16 nColumn(0); nColumn < 3; nColumn++)
+            {
+                if(!std::isfinite(rTransform.get(nRow, nColumn)))
+                {
+                    return false;
+                }
+            }
+            if(std::fabs(rTransform.get(nRow, 0)) > fMaxStep)
+            {
+                return false;
+            }
+        }
+
+        const std::vector<sal_uInt8> aPixels(
+            impReadAffineSource(rRead, eFormat == ScanlineFormat::N24BitTcBgr));
+        const AffineSource aSource{ aPixels.data(), sal_Int32(rRead.Width()),
+                                    sal_Int32(rRead.Height()) };
+        const basegfx::B2DVector aStep(rTransform.get(0, 0), rTransform.get(1, 0));
+        const sal_Int32 nWidth(rWrite.Width());
+
+        vcl::bitmap::parallelForRows(
+            rWrite.Height(), nWidth, [&](sal_Int32 nStartY, sal_Int32 nEndY) {
+                for(sal_Int32 y(nStartY); y <= nEndY; y++)
+                {
+                    impTransformAffineRow(aSource, rTransform * basegfx::B2DPoint(0, y), aStep,
+                                          nWidth, bSmooth, rWrite.GetScanline(y));
+                }
+            });
+
+        return true;
+    }
+
     Bitmap impTransformBitmap(
         const Bitmap& rSource,
         const Size& rDestinationSize,
@@ -671,7 +944,7 @@ namespace
         {
             Bitmap::ScopedReadAccess xRead(const_cast< Bitmap& >(rSource));
 
-            if (xRead)
+            if (xRead && !impTransformBitmapAffine(*xRead, *xWrite, rTransform, bSmooth))
             {
                 const Size aDestinationSizePixel(aDestination.GetSizePixel());
                 const BitmapColor aOutside(BitmapColor(0xff, 0xff, 0xff));
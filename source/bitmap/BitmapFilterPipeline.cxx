@@ -0,0 +1,261 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <bitmap/BitmapFilterPipeline.hxx>
+
+#include <bitmap/BitmapParallel.hxx>
+#include <bitmap/BitmapWriteAccess.hxx>
+#include <sal/log.hxx>
+#include <tools/helpers.hxx>
+#include <vcl/bitmap.hxx>
+#include <vcl/bitmapex.hxx>
+
+#include <algorithm>
+#include <utility>
+
+namespace vcl::bitmap
+{
+BitmapFilterPipeline& BitmapFilterPipeline::Lookup(const ChannelTable& rRed,
+                                                   const ChannelTable& rGreen,
+                                                   const ChannelTable& rBlue)
+{
+    if (!maStages.empty() && maStages.back().meType == StageType::Lookup)
+    {
+        // one table after the other is the same as one table of the two
+        std::array<ChannelTable, 3>& rTables = maStages.back().maTables;
+        for (int i = 0; i < 256; i++)
+        {
+            rTables[0][i] = rRed[rTables[0][i]];
+            rTables[1][i] = rGreen[rTables[1][i]];
+            rTables[2][i] = rBlue[rTables[2][i]];
+        }
+        return *this;
+    }
+
+    maStages.push_back({ StageType::Lookup, { rRed, rGreen, rBlue }, nullptr });
+    return *this;
+}
+
+BitmapFilterPipeline& BitmapFilterPipeline::Grey()
+{
+    // the luminance of a grey pixel is that grey again
+    if (maStages.empty() || maStages.back().meType != StageType::Grey)
+        maStages.push_back({ StageType::Grey, {}, nullptr });
+    return *this;
+}
+
+BitmapFilterPipeline& BitmapFilterPipeline::Adjust(short nLuminancePercent,
+                                                   short nContrastPercent,
+                                                   short nChannelRPercent,
+                                                   short nChannelGPercent,
+                                                   short nChannelBPercent, double fGamma,
+                                                   bool bInvert, bool msoBrightness)
+{
+    ChannelTable aMapR, aMapG, aMapB;
+    double fM, fROff, fGOff, fBOff, fOff;
+
+    // calculate slope
+    if (nContrastPercent >= 0)
+        fM = 128.0 / (128.0 - 1.27 * MinMax(nContrastPercent, 0, 100));
+    else
+        fM = (128.0 + 1.27 * MinMax(nContrastPercent, -100, 0)) / 128.0;
+
+    if (!msoBrightness)
+        // total offset = luminance offset + contrast offset
+        fOff = MinMax(nLuminancePercent, -100, 100) * 2.55 + 128.0 - fM * 128.0;
+    else
+        fOff = MinMax(nLuminancePercent, -100, 100) * 2.55;
+
+    // channel offset = channel offset + total offset
+    fROff = nChannelRPercent * 2.55 + fOff;
+    fGOff = nChannelGPercent * 2.55 + fOff;
+    fBOff = nChannelBPercent * 2.55 + fOff;
+
+    // calculate gamma value
+    fGamma = (fGamma <= 0.0 || fGamma > 10.0) ? 1.0 : (1.0 / fGamma);
+    const bool bGamma = (fGamma != 1.0);
+
+    // create mapping table
+    for (tools::Long nX = 0; nX < 256; nX++)
+    {
+        if (!msoBrightness)
+        {
+            aMapR[nX] = static_cast<sal_uInt8>(MinMax(FRound(nX * fM + fROff), 0, 255));
+            aMapG[nX] = static_cast<sal_uInt8>(MinMax(FRound(nX * fM + fGOff), 0, 255));
+            aMapB[nX] = static_cast<sal_uInt8>(MinMax(FRound(nX * fM + fBOff), 0, 255));
+        }
+        else
+        {
+            // LO simply uses (in a somewhat optimized form) "newcolor = (oldcolor-128)*contrast+brightness+128"
+            // as the formula, i.e. contrast first, brightness afterwards. MSOffice, for whatever weird reason,
+            // use neither first, but apparently it applies half of brightness before contrast and half afterwards.
+            aMapR[nX] = static_cast<sal_uInt8>(
+                MinMax(FRound((nX + fROff / 2 - 128) * fM + 128 + fROff / 2), 0, 255));
+            aMapG[nX] = static_cast<sal_uInt8>(
+                MinMax(FRound((nX + fGOff / 2 - 128) * fM + 128 + fGOff / 2), 0, 255));
+            aMapB[nX] = static_cast<sal_uInt8>(
+                MinMax(FRound((nX + fBOff / 2 - 128) * fM + 128 + fBOff / 2), 0, 255));
+        }
+        if (bGamma)
+        {
+            aMapR[nX] = GAMMA(aMapR[nX], fGamma);
+            aMapG[nX] = GAMMA(aMapG[nX], fGamma);
+            aMapB[nX] = GAMMA(aMapB[nX], fGamma);
+        }
+
+        if (bInvert)
+        {
+            aMapR[nX] = ~aMapR[nX];
+            aMapG[nX] = ~aMapG[nX];
+            aMapB[nX] = ~aMapB[nX];
+        }
+    }
+
+    return Lookup(aMapR, aMapG, aMapB);
+}
+
+BitmapFilterPipeline& BitmapFilterPipeline::Filter(std::shared_ptr<const BitmapFilter> pFilter)
+{
+    if (pFilter)
+        maStages.push_back({ StageType::Filter, {}, std::move(pFilter) });
+    return *this;
+}
+
+bool BitmapFilterPipeline::IsPointwise() const
+{
+    return std::none_of(maStages.begin(), maStages.end(),
+                        [](const Stage& rStage) { return rStage.meType == StageType::Filter; });
+}
+
+void BitmapFilterPipeline::applyKernel(StageIterator aBegin, StageIterator aEnd, sal_uInt8& rR,
+                                       sal_uInt8& rG, sal_uInt8& rB)
+{
+    for (StageIterator it = aBegin; it != aEnd; ++it)
+    {
+        if (it->meType == StageType::Lookup)
+        {
+            rR = it->maTables[0][rR];
+            rG = it->maTables[1][rG];
+            rB = it->maTables[2][rB];
+        }
+        else
+        {
+            rR = rG = rB = (rB * 29 + rG * 151 + rR * 76) >> 8;
+        }
+    }
+}
+
+void BitmapFilterPipeline::applyPointwise(StageIterator aBegin, StageIterator aEnd,
+                                          BitmapWriteAccess& rAcc)
+{
+    if (rAcc.HasPalette())
+    {
+        for (sal_uInt16 i = 0, nCount = rAcc.GetPaletteEntryCount(); i < nCount; i++)
+        {
+            const BitmapColor& rCol = rAcc.GetPaletteColor(i);
+            sal_uInt8 nR = rCol.GetRed(), nG = rCol.GetGreen(), nB = rCol.GetBlue();
+            applyKernel(aBegin, aEnd, nR, nG, nB);
+            rAcc.SetPaletteColor(i, BitmapColor(nR, nG, nB));
+        }
+        return;
+    }
+
+    const tools::Long nWidth = rAcc.Width();
+    const ScanlineFormat nFormat = rAcc.GetScanlineFormat();
+
+    if (nFormat == ScanlineFormat::N24BitTcBgr || nFormat == ScanlineFormat::N24BitTcRgb)
+    {
+        const int nRed = nFormat == ScanlineFormat::N24BitTcBgr ? 2 : 0;
+        const int nBlue = 2 - nRed;
+        parallelForRows(rAcc.Height(), nWidth, [&](sal_Int32 nStart, sal_Int32 nEnd) {
+            for (sal_Int32 nY = nStart; nY <= nEnd; nY++)
+            {
+                Scanline pScan = rAcc.GetScanline(nY);
+                for (tools::Long nX = 0; nX < nWidth; nX++, pScan += 3)
+                    applyKernel(aBegin, aEnd, pScan[nRed], pScan[1], pScan[nBlue]);
+            }
+        });
+        return;
+    }
+
+    parallelForRows(rAcc.Height(), nWidth, [&](sal_Int32 nStart, sal_Int32 nEnd) {
+        for (sal_Int32 nY = nStart; nY <= nEnd; nY++)
+        {
+            Scanline pScanline = rAcc.GetScanline(nY);
+            for (tools::Long nX = 0; nX < nWidth; nX++)
+            {
+                BitmapColor aCol = rAcc.GetPixelFromData(pScanline, nX);
+                sal_uInt8 nR = aCol.GetRed(), nG = aCol.GetGreen(), nB = aCol.GetBlue();
+                applyKernel(aBegin, aEnd, nR, nG, nB);
+                aCol.SetRed(nR);
+                aCol.SetGreen(nG);
+                aCol.SetBlue(nB);
+                rAcc.SetPixelOnData(pScanline, nX, aCol);
+            }
+        }
+    });
+}
+
+bool BitmapFilterPipeline::Apply(Bitmap& rBitmap) const
+{
+    if (!IsPointwise())
+    {
+        SAL_WARN("vcl.gdi", "BitmapFilterPipeline::Apply: not pointwise, use execute()");
+        return false;
+    }
+    if (maStages.empty())
+        return true;
+
+    BitmapScopedWriteAccess pAcc(rBitmap);
+    if (!pAcc)
+        return false;
+
+    applyPointwise(maStages.begin(), maStages.end(), *pAcc);
+    return true;
+}
+
+BitmapEx BitmapFilterPipeline::execute(BitmapEx const& rBitmapEx) const
+{
+    BitmapEx aResult(rBitmapEx);
+
+    auto it = maStages.begin();
+    while (it != maStages.end())
+    {
+        if (it->meType == StageType::Filter)
+        {
+            if (!BitmapFilter::Filter(aResult, *it->mpFilter))
+                return BitmapEx();
+            ++it;
+            continue;
+        }
+
+        // all the pointwise stages up to the next filter in one pass
+        auto itEnd = std::find_if(it, maStages.end(), [](const Stage& rStage) {
+            return rStage.meType == StageType::Filter;
+        });
+        Bitmap aBitmap(aResult.GetBitmap());
+        {
+            BitmapScopedWriteAccess pAcc(aBitmap);
+            if (!pAcc)
+                return BitmapEx();
+            applyPointwise(it, itEnd, *pAcc);
+        }
+        if (aResult.IsAlpha())
+            aResult = BitmapEx(aBitmap, aResult.GetAlpha());
+        else
+            aResult = BitmapEx(aBitmap);
+        it = itEnd;
+    }
+
+    return aResult;
+}
+
+} // end vcl::bitmap
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
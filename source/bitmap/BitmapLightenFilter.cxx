@@ -10,6 +10,7 @@
 
 #include <basegfx/color/bcolortools.hxx>
 
+#include <bitmap/BitmapParallel.hxx>
 #include <bitmap/BitmapWriteAccess.hxx>
 #include <bitmap/BitmapLightenFilter.hxx>
 
@@ -25,38 +26,42 @@ BitmapEx BitmapLightenFilter::execute(BitmapEx const& rBitmapEx) const
 
     if (pRead && pWrite)
     {
-        for (sal_Int32 nY = 0; nY < sal_Int32(aSize.Height()); ++nY)
-        {
-            Scanline pScanline = pWrite->GetScanline(nY);
-            Scanline pScanlineRead = pRead->GetScanline(nY);
-            for (sal_Int32 nX = 0; nX < sal_Int32(aSize.Width()); ++nX)
-            {
-                BitmapColor aBmpColor
-                    = pRead->HasPalette()
-                          ? pRead->GetPaletteColor(pRead->GetIndexFromData(pScanlineRead, nX))
-                          : pRead->GetPixelFromData(pScanlineRead, nX);
-                aBmpColor.Invert();
-                basegfx::BColor aBColor(aBmpColor.getBColor());
-                aBColor = basegfx::utils::rgb2hsl(aBColor);
+        vcl::bitmap::parallelForRows(
+            aSize.Height(), aSize.Width(), [&](sal_Int32 nStartY, sal_Int32 nEndY) {
+                for (sal_Int32 nY = nStartY; nY <= nEndY; ++nY)
+                {
+                    Scanline pScanline = pWrite->GetScanline(nY);
+                    Scanline pScanlineRead = pRead->GetScanline(nY);
+                    for (sal_Int32 nX = 0; nX < sal_Int32(aSize.Width()); ++nX)
+                    {
+                        BitmapColor aBmpColor
+                            = pRead->HasPalette()
+                                  ? pRead->GetPaletteColor(
+                                        pRead->GetIndexFromData(pScanlineRead, nX))
+                                  : pRead->GetPixelFromData(pScanlineRead, nX);
+                        aBmpColor.Invert();
+                        basegfx::BColor aBColor(aBmpColor.getBColor());
+                        aBColor = basegfx::utils::rgb2hsl(aBColor);
 
-                double fHue = aBColor.getRed();
-                fHue += 180.0;
+                        double fHue = aBColor.getRed();
+                        fHue += 180.0;
 
-                while (fHue > 360.0)
-                {
-                    fHue -= 360.0;
-                }
+                        while (fHue > 360.0)
+                        {
+                            fHue -= 360.0;
+                        }
 
-                aBColor.setRed(fHue);
+                        aBColor.setRed(fHue);
 
-                aBColor = basegfx::utils::hsl2rgb(aBColor);
-                aBmpColor.SetRed((aBColor.getRed() * 255.0) + 0.5);
-                aBmpColor.SetGreen((aBColor.getGreen() * 255.0) + 0.5);
-                aBmpColor.SetBlue((aBColor.getBlue() * 255.0) + 0.5);
+                        aBColor = basegfx::utils::hsl2rgb(aBColor);
+                        aBmpColor.SetRed((aBColor.getRed() * 255.0) + 0.5);
+                        aBmpColor.SetGreen((aBColor.getGreen() * 255.0) + 0.5);
+                        aBmpColor.SetBlue((aBColor.getBlue() * 255.0) + 0.5);
 
-                pWrite->SetPixelOnData(pScanline, nX, aBmpColor);
-            }
-        }
+                        pWrite->SetPixelOnData(pScanline, nX, aBmpColor);
+                    }
+                }
+            });
     }
     pWrite.reset();
     pRead.reset();
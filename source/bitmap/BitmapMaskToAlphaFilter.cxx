@@ -10,6 +10,7 @@
 
 #include <basegfx/color/bcolortools.hxx>
 
+#include <bitmap/BitmapParallel.hxx>
 #include <bitmap/BitmapWriteAccess.hxx>
 #include <bitmap/BitmapMaskToAlphaFilter.hxx>
 
@@ -30,24 +31,27 @@ BitmapEx BitmapMaskToAlphaFilter::execute(BitmapEx const& rBitmapEx) const
     {
         assert(pRead->HasPalette() && "only supposed to be called with 1-bit mask");
         assert(pRead->GetPaletteEntryCount() == 2);
-        for (sal_Int32 nY = 0; nY < sal_Int32(aSize.Height()); ++nY)
-        {
-            Scanline pScanline = pWrite->GetScanline(nY);
-            Scanline pScanlineRead = pRead->GetScanline(nY);
-            for (sal_Int32 nX = 0; nX < sal_Int32(aSize.Width()); ++nX)
-            {
-                BitmapColor aBmpColor = pRead->GetPixelFromData(pScanlineRead, nX);
-                if (aBmpColor == COL_BLACK)
-                    aBmpColor = COL_BLACK;
-                else if (aBmpColor == COL_WHITE)
-                    aBmpColor = COL_WHITE;
-                else if (aBmpColor == Color(0, 0, 1))
-                    aBmpColor = COL_WHITE;
-                else
-                    assert(false);
-                pWrite->SetPixelOnData(pScanline, nX, aBmpColor);
-            }
-        }
+        vcl::bitmap::parallelForRows(
+            aSize.Height(), aSize.Width(), [&](sal_Int32 nStartY, sal_Int32 nEndY) {
+                for (sal_Int32 nY = nStartY; nY <= nEndY; ++nY)
+                {
+                    Scanline pScanline = pWrite->GetScanline(nY);
+                    Scanline pScanlineRead = pRead->GetScanline(nY);
+                    for (sal_Int32 nX = 0; nX < sal_Int32(aSize.Width()); ++nX)
+                    {
+                        BitmapColor aBmpColor = pRead->GetPixelFromData(pScanlineRead, nX);
+                        if (aBmpColor == COL_BLACK)
+                            aBmpColor = COL_BLACK;
+                        else if (aBmpColor == COL_WHITE)
+                            aBmpColor = COL_WHITE;
+                        else if (aBmpColor == Color(0, 0, 1))
+                            aBmpColor = COL_WHITE;
+                        else
+                            assert(false);
+                        pWrite->SetPixelOnData(pScanline, nX, aBmpColor);
+                    }
+                }
+            });
     }
     pWrite.reset();
     pRead.reset();
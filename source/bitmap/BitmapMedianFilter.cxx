@@ -12,8 +12,13 @@
 #include <vcl/bitmapex.hxx>
 #include <vcl/BitmapMedianFilter.hxx>
 
+#include <bitmap/BitmapMedian.hxx>
+#include <bitmap/BitmapParallel.hxx>
 #include <bitmap/BitmapWriteAccess.hxx>
 
+#include <algorithm>
+#include <vector>
+
 #define S2(a, b)                                                                                   \
     {                                                                                              \
         sal_Int32 t;                                                                               \
@@ -49,169 +54,385 @@
     MN3(a, b, c);                                                                                  \
     MX3(d, e, f);
 
-BitmapEx BitmapMedianFilter::execute(BitmapEx const& rBitmapEx) const
+namespace
 {
-    Bitmap aBitmap(rBitmapEx.GetBitmap());
+void medianNetwork3x3(BitmapReadAccess& rReadAcc, BitmapWriteAccess& rWriteAcc)
+{
+    const sal_Int32 nWidth = rWriteAcc.Width(), nWidth2 = nWidth + 2;
+    const sal_Int32 nHeight = rWriteAcc.Height(), nHeight2 = nHeight + 2;
+    std::unique_ptr<sal_Int32[]> pColm(new sal_Int32[nWidth2]);
+    std::unique_ptr<sal_Int32[]> pRows(new sal_Int32[nHeight2]);
 
-    Bitmap::ScopedReadAccess pReadAcc(aBitmap);
-    bool bRet = false;
+    // create column LUT
+    for (sal_Int32 i = 0; i < nWidth2; i++)
+        pColm[i] = (i > 0) ? (i - 1) : 0;
 
-    if (pReadAcc)
-    {
-        Bitmap aNewBmp(aBitmap.GetSizePixel(), vcl::PixelFormat::N24_BPP);
-        BitmapScopedWriteAccess pWriteAcc(aNewBmp);
+    pColm[nWidth + 1] = pColm[nWidth];
+
+    // create row LUT
+    for (sal_Int32 i = 0; i < nHeight2; i++)
+        pRows[i] = (i > 0) ? (i - 1) : 0;
+
+    pRows[nHeight + 1] = pRows[nHeight];
+
+    // do median filtering, every strip reads the rows around it on its own
+    vcl::bitmap::parallelForRows(nHeight, nWidth, [&](sal_Int32 nStartY, sal_Int32 nEndY) {
+        std::unique_ptr<BitmapColor[]> pColRow1(new BitmapColor[nWidth2]);
+        std::unique_ptr<BitmapColor[]> pColRow2(new BitmapColor[nWidth2]);
+        std::unique_ptr<BitmapColor[]> pColRow3(new BitmapColor[nWidth2]);
+        BitmapColor* pRowTmp1 = pColRow1.get();
+        BitmapColor* pRowTmp2 = pColRow2.get();
+        BitmapColor* pRowTmp3 = pColRow3.get();
+        BitmapColor* pColor;
+        sal_Int32 nR1, nR2, nR3, nR4, nR5, nR6, nR7, nR8, nR9;
+        sal_Int32 nG1, nG2, nG3, nG4, nG5, nG6, nG7, nG8, nG9;
+        sal_Int32 nB1, nB2, nB3, nB4, nB5, nB6, nB7, nB8, nB9;
+
+        // read first three rows of bitmap color
+        for (sal_Int32 i = 0; i < nWidth2; i++)
+        {
+            pColRow1[i] = rReadAcc.GetColor(pRows[nStartY], pColm[i]);
+            pColRow2[i] = rReadAcc.GetColor(pRows[nStartY + 1], pColm[i]);
+            pColRow3[i] = rReadAcc.GetColor(pRows[nStartY + 2], pColm[i]);
+        }
 
-        if (pWriteAcc)
+        for (sal_Int32 nY = nStartY; nY <= nEndY;)
         {
-            const sal_Int32 nWidth = pWriteAcc->Width(), nWidth2 = nWidth + 2;
-            const sal_Int32 nHeight = pWriteAcc->Height(), nHeight2 = nHeight + 2;
-            std::unique_ptr<sal_Int32[]> pColm(new sal_Int32[nWidth2]);
-            std::unique_ptr<sal_Int32[]> pRows(new sal_Int32[nHeight2]);
-            std::unique_ptr<BitmapColor[]> pColRow1(new BitmapColor[nWidth2]);
-            std::unique_ptr<BitmapColor[]> pColRow2(new BitmapColor[nWidth2]);
-            std::unique_ptr<BitmapColor[]> pColRow3(new BitmapColor[nWidth2]);
-            BitmapColor* pRowTmp1 = pColRow1.get();
-            BitmapColor* pRowTmp2 = pColRow2.get();
-            BitmapColor* pRowTmp3 = pColRow3.get();
-            BitmapColor* pColor;
-            sal_Int32 nY, nX, i;
-            sal_Int32 nR1, nR2, nR3, nR4, nR5, nR6, nR7, nR8, nR9;
-            sal_Int32 nG1, nG2, nG3, nG4, nG5, nG6, nG7, nG8, nG9;
-            sal_Int32 nB1, nB2, nB3, nB4, nB5, nB6, nB7, nB8, nB9;
-
-            // create column LUT
-            for (i = 0; i < nWidth2; i++)
-                pColm[i] = (i > 0) ? (i - 1) : 0;
-
-            pColm[nWidth + 1] = pColm[nWidth];
-
-            // create row LUT
-            for (i = 0; i < nHeight2; i++)
-                pRows[i] = (i > 0) ? (i - 1) : 0;
-
-            pRows[nHeight + 1] = pRows[nHeight];
-
-            // read first three rows of bitmap color
-            if (nHeight2 > 2)
+            Scanline pScanline = rWriteAcc.GetScanline(nY);
+            for (sal_Int32 nX = 0; nX < nWidth; nX++)
             {
-                for (i = 0; i < nWidth2; i++)
-                {
-                    pColRow1[i] = pReadAcc->GetColor(pRows[0], pColm[i]);
-                    pColRow2[i] = pReadAcc->GetColor(pRows[1], pColm[i]);
-                    pColRow3[i] = pReadAcc->GetColor(pRows[2], pColm[i]);
-                }
+                pColor = pRowTmp1 + nX;
+                nR1 = pColor->GetRed();
+                nG1 = pColor->GetGreen();
+                nB1 = pColor->GetBlue();
+                nR2 = (++pColor)->GetRed();
+                nG2 = pColor->GetGreen();
+                nB2 = pColor->GetBlue();
+                nR3 = (++pColor)->GetRed();
+                nG3 = pColor->GetGreen();
+                nB3 = pColor->GetBlue();
+
+                pColor = pRowTmp2 + nX;
+                nR4 = pColor->GetRed();
+                nG4 = pColor->GetGreen();
+                nB4 = pColor->GetBlue();
+                nR5 = (++pColor)->GetRed();
+                nG5 = pColor->GetGreen();
+                nB5 = pColor->GetBlue();
+                nR6 = (++pColor)->GetRed();
+                nG6 = pColor->GetGreen();
+                nB6 = pColor->GetBlue();
+
+                pColor = pRowTmp3 + nX;
+                nR7 = pColor->GetRed();
+                nG7 = pColor->GetGreen();
+                nB7 = pColor->GetBlue();
+                nR8 = (++pColor)->GetRed();
+                nG8 = pColor->GetGreen();
+                nB8 = pColor->GetBlue();
+                nR9 = (++pColor)->GetRed();
+                nG9 = pColor->GetGreen();
+                nB9 = pColor->GetBlue();
+
+                MNMX6(nR1, nR2, nR3, nR4, nR5, nR6);
+                MNMX5(nR7, nR2, nR3, nR4, nR5);
+                MNMX4(nR8, nR2, nR3, nR4);
+                MNMX3(nR9, nR2, nR3);
+
+                MNMX6(nG1, nG2, nG3, nG4, nG5, nG6);
+                MNMX5(nG7, nG2, nG3, nG4, nG5);
+                MNMX4(nG8, nG2, nG3, nG4);
+                MNMX3(nG9, nG2, nG3);
+
+                MNMX6(nB1, nB2, nB3, nB4, nB5, nB6);
+                MNMX5(nB7, nB2, nB3, nB4, nB5);
+                MNMX4(nB8, nB2, nB3, nB4);
+                MNMX3(nB9, nB2, nB3);
+
+                // set destination color
+                rWriteAcc.SetPixelOnData(pScanline, nX,
+                                          BitmapColor(static_cast<sal_uInt8>(nR2),
+                                                      static_cast<sal_uInt8>(nG2),
+                                                      static_cast<sal_uInt8>(nB2)));
             }
 
-            // do median filtering
-            for (nY = 0; nY < nHeight;)
+            if (++nY <= nEndY)
             {
-                Scanline pScanline = pWriteAcc->GetScanline(nY);
-                for (nX = 0; nX < nWidth; nX++)
+                if (pRowTmp1 == pColRow1.get())
+                {
+                    pRowTmp1 = pColRow2.get();
+                    pRowTmp2 = pColRow3.get();
+                    pRowTmp3 = pColRow1.get();
+                }
+                else if (pRowTmp1 == pColRow2.get())
+                {
+                    pRowTmp1 = pColRow3.get();
+                    pRowTmp2 = pColRow1.get();
+                    pRowTmp3 = pColRow2.get();
+                }
+                else
                 {
-                    pColor = pRowTmp1 + nX;
-                    nR1 = pColor->GetRed();
-                    nG1 = pColor->GetGreen();
-                    nB1 = pColor->GetBlue();
-                    nR2 = (++pColor)->GetRed();
-                    nG2 = pColor->GetGreen();
-                    nB2 = pColor->GetBlue();
-                    nR3 = (++pColor)->GetRed();
-                    nG3 = pColor->GetGreen();
-                    nB3 = pColor->GetBlue();
-
-                    pColor = pRowTmp2 + nX;
-                    nR4 = pColor->GetRed();
-                    nG4 = pColor->GetGreen();
-                    nB4 = pColor->GetBlue();
-                    nR5 = (++pColor)->GetRed();
-                    nG5 = pColor->GetGreen();
-                    nB5 = pColor->GetBlue();
-                    nR6 = (++pColor)->GetRed();
-                    nG6 = pColor->GetGreen();
-                    nB6 = pColor->GetBlue();
-
-                    pColor = pRowTmp3 + nX;
-                    nR7 = pColor->GetRed();
-                    nG7 = pColor->GetGreen();
-                    nB7 = pColor->GetBlue();
-                    nR8 = (++pColor)->GetRed();
-                    nG8 = pColor->GetGreen();
-                    nB8 = pColor->GetBlue();
-                    nR9 = (++pColor)->GetRed();
-                    nG9 = pColor->GetGreen();
-                    nB9 = pColor->GetBlue();
-
-                    MNMX6(nR1, nR2, nR3, nR4, nR5, nR6);
-                    MNMX5(nR7, nR2, nR3, nR4, nR5);
-                    MNMX4(nR8, nR2, nR3, nR4);
-                    MNMX3(nR9, nR2, nR3);
-
-                    MNMX6(nG1, nG2, nG3, nG4, nG5, nG6);
-                    MNMX5(nG7, nG2, nG3, nG4, nG5);
-                    MNMX4(nG8, nG2, nG3, nG4);
-                    MNMX3(nG9, nG2, nG3);
-
-                    MNMX6(nB1, nB2, nB3, nB4, nB5, nB6);
-                    MNMX5(nB7, nB2, nB3, nB4, nB5);
-                    MNMX4(nB8, nB2, nB3, nB4);
-                    MNMX3(nB9, nB2, nB3);
-
-                    // set destination color
-                    pWriteAcc->SetPixelOnData(pScanline, nX,
-                                              BitmapColor(static_cast<sal_uInt8>(nR2),
-                                                          static_cast<sal_uInt8>(nG2),
-                                                          static_cast<sal_uInt8>(nB2)));
+                    pRowTmp1 = pColRow1.get();
+                    pRowTmp2 = pColRow2.get();
+                    pRowTmp3 = pColRow3.get();
                 }
 
-                if (++nY < nHeight)
+                for (sal_Int32 i = 0; i < nWidth2; i++)
+                    pRowTmp3[i] = rReadAcc.GetColor(pRows[nY + 2], pColm[i]);
+            }
+        }
+    });
+}
+
+void readChannels(BitmapReadAccess& rReadAcc, sal_Int32 nY, sal_Int32 nStartX, sal_Int32 nEndX,
+                  sal_Int32 nChannels, sal_uInt8* pRow)
+{
+    Scanline pScanline = rReadAcc.GetScanline(nY);
+
+    if (nChannels == 1)
+    {
+        // the 8 bit grey palette maps every index to the grey value of the same number
+        for (sal_Int32 nX = nStartX; nX <= nEndX; nX++)
+            *pRow++ = rReadAcc.GetIndexFromData(pScanline, nX);
+        return;
+    }
+
+    for (sal_Int32 nX = nStartX; nX <= nEndX; nX++)
+    {
+        const BitmapColor aColor
+            = rReadAcc.HasPalette()
+                  ? rReadAcc.GetPaletteColor(rReadAcc.GetIndexFromData(pScanline, nX))
+                  : rReadAcc.GetPixelFromData(pScanline, nX);
+        *pRow++ = aColor.GetRed();
+        *pRow++ = aColor.GetGreen();
+        *pRow++ = aColor.GetBlue();
+    }
+}
+
+// fine histogram bins per coarse bin
+constexpr sal_Int32 constFineBins = 16;
+constexpr sal_Int32 constCoarseBins = 256 / constFineBins;
+
+/* Constant time median filtering, see Perreault and Hebert, "Median Filtering in Constant Time".
+
+   Every column keeps a histogram of its 2 * nRadius + 1 rows of the window, which is moved down
+   by one row by removing the row leaving the window and adding the one entering it. The kernel
+   histogram of the window is moved right by adding the column histogram entering the window
+   and removing the one leaving it. Both are split into 16 coarse bins of 16 fine bins each:
+   the coarse kernel bins are updated for every pixel, while the fine bins of a coarse bin are
+   only brought up to date when the median falls into it.
+
+   This does the pixels nStartX .. nEndX of the rows nStartY .. nEndY.
+*/
+void medianHistogramTile(BitmapReadAccess& rReadAcc, BitmapWriteAccess& rWriteAcc,
+                         sal_Int32 nRadius, sal_Int32 nChannels, sal_Int32 nStartX,
+                         sal_Int32 nEndX, sal_Int32 nStartY, sal_Int32 nEndY)
+{
+    const sal_Int32 nWidth = rWriteAcc.Width();
+    const sal_Int32 nHeight = rWriteAcc.Height();
+    const sal_uInt32 nRank = (sal_uInt32(2 * nRadius + 1) * (2 * nRadius + 1)) / 2;
+
+    // the columns the windows of the tile cover, columns beyond the borders repeat the border
+    const sal_Int32 nFirstColumn = std::max<sal_Int32>(nStartX - nRadius, 0);
+    const sal_Int32 nLastColumn = std::min<sal_Int32>(nEndX + nRadius, nWidth - 1);
+    const sal_Int32 nColumns = (nLastColumn - nFirstColumn + 1) * nChannels;
+    auto column = [=](sal_Int32 nX) {
+        return std::clamp<sal_Int32>(nX, nFirstColumn, nLastColumn) - nFirstColumn;
+    };
+
+    std::vector<sal_uInt16> aColumnFine(nColumns * 256);
+    std::vector<sal_uInt16> aColumnCoarse(nColumns * constCoarseBins);
+    std::vector<sal_uInt8> aRow(nColumns);
+
+    auto addRow = [&](sal_Int32 nY, sal_uInt16 nDelta) {
+        readChannels(rReadAcc, std::clamp<sal_Int32>(nY, 0, nHeight - 1), nFirstColumn,
+                     nLastColumn, nChannels, aRow.data());
+        for (sal_Int32 i = 0; i < nColumns; i++)
+        {
+            const sal_uInt8 nValue = aRow[i];
+            aColumnFine[i * 256 + nValue] += nDelta;
+            aColumnCoarse[i * constCoarseBins + nValue / constFineBins] += nDelta;
+        }
+    };
+
+    for (sal_Int32 nY = nStartY - nRadius; nY <= nStartY + nRadius; nY++)
+        addRow(nY, 1);
+
+    // the kernel of every channel, with the column its fine bins were last updated for
+    const sal_Int32 nCoarseStride = nChannels * constCoarseBins;
+    const sal_Int32 nFineStride = nChannels * 256;
+    std::vector<sal_uInt32> aKernelFine(nFineStride);
+    std::vector<sal_uInt32> aKernelCoarse(nCoarseStride);
+    std::vector<sal_Int32> aKernelColumn(nCoarseStride);
+    std::vector<sal_uInt8> aMedian(nChannels);
+
+    for (sal_Int32 nY = nStartY; nY <= nEndY; nY++)
+    {
+        if (nY > nStartY)
+        {
+            // unsigned wrap around subtracts
+            addRow(nY - nRadius - 1, sal_uInt16(-1));
+            addRow(nY + nRadius, 1);
+        }
+
+        std::fill(aKernelCoarse.begin(), aKernelCoarse.end(), 0);
+        // far enough left to make the first use of every fine bin start from scratch
+        std::fill(aKernelColumn.begin(), aKernelColumn.end(), nStartX - 2 * nRadius - 2);
+
+        for (sal_Int32 nDX = -nRadius; nDX <= nRadius; nDX++)
+        {
+            const sal_uInt16* pColumn
+                = aColumnCoarse.data() + column(nStartX + nDX) * nCoarseStride;
+            for (sal_Int32 i = 0; i < nCoarseStride; i++)
+                aKernelCoarse[i] += pColumn[i];
+        }
+
+        Scanline pScanline = rWriteAcc.GetScanline(nY);
+        for (sal_Int32 nX = nStartX; nX <= nEndX; nX++)
+        {
+            if (nX > nStartX)
+            {
+                const sal_uInt16* pAdd
+                    = aColumnCoarse.data() + column(nX + nRadius) * nCoarseStride;
+                const sal_uInt16* pSub
+                    = aColumnCoarse.data() + column(nX - nRadius - 1) * nCoarseStride;
+                for (sal_Int32 i = 0; i < nCoarseStride; i++)
+                    aKernelCoarse[i] += pAdd[i] - pSub[i];
+            }
+
+            for (sal_Int32 nChannel = 0; nChannel < nChannels; nChannel++)
+            {
+                const sal_uInt32* pCoarse = aKernelCoarse.data() + nChannel * constCoarseBins;
+                sal_uInt32 nCount = 0;
+                sal_Int32 nBin = 0;
+                while (nCount + pCoarse[nBin] <= nRank)
+                    nCount += pCoarse[nBin++];
+
+                // bring the fine bins of the coarse bin of the median up to date, either from
+                // scratch or by sliding them, whatever touches fewer column histograms
+                const sal_Int32 nOffset = nChannel * 256 + nBin * constFineBins;
+                sal_uInt32* pFine = aKernelFine.data() + nOffset;
+                sal_Int32& rColumn = aKernelColumn[nChannel * constCoarseBins + nBin];
+                if (2 * (nX - rColumn) > 2 * nRadius + 1)
                 {
-                    if (pRowTmp1 == pColRow1.get())
+                    std::fill(pFine, pFine + constFineBins, 0);
+                    for (sal_Int32 nDX = -nRadius; nDX <= nRadius; nDX++)
                     {
-                        pRowTmp1 = pColRow2.get();
-                        pRowTmp2 = pColRow3.get();
-                        pRowTmp3 = pColRow1.get();
+                        const sal_uInt16* pColumn
+                            = aColumnFine.data() + column(nX + nDX) * nFineStride + nOffset;
+                        for (sal_Int32 i = 0; i < constFineBins; i++)
+                            pFine[i] += pColumn[i];
                     }
-                    else if (pRowTmp1 == pColRow2.get())
-                    {
-                        pRowTmp1 = pColRow3.get();
-                        pRowTmp2 = pColRow1.get();
-                        pRowTmp3 = pColRow2.get();
-                    }
-                    else
+                }
+                else
+                {
+                    for (sal_Int32 nColumnX = rColumn + 1; nColumnX <= nX; nColumnX++)
                     {
-                        pRowTmp1 = pColRow1.get();
-                        pRowTmp2 = pColRow2.get();
-                        pRowTmp3 = pColRow3.get();
+                        const sal_uInt16* pAdd
+                            = aColumnFine.data() + column(nColumnX + nRadius) * nFineStride
+                              + nOffset;
+                        const sal_uInt16* pSub
+                            = aColumnFine.data() + column(nColumnX - nRadius - 1) * nFineStride
+                              + nOffset;
+                        for (sal_Int32 i = 0; i < constFineBins; i++)
+                            pFine[i] += pAdd[i] - pSub[i];
                     }
-
-                    for (i = 0; i < nWidth2; i++)
-                        pRowTmp3[i] = pReadAcc->GetColor(pRows[nY + 2], pColm[i]);
                 }
-            }
+                rColumn = nX;
 
-            pWriteAcc.reset();
+                sal_Int32 nValue = 0;
+                while (nCount + pFine[nValue] <= nRank)
+                    nCount += pFine[nValue++];
+                aMedian[nChannel] = nBin * constFineBins + nValue;
+            }
 
-            bRet = true;
+            if (nChannels == 1)
+                rWriteAcc.SetPixelOnData(pScanline, nX, BitmapColor(aMedian[0]));
+            else
+                rWriteAcc.SetPixelOnData(pScanline, nX,
+                                         BitmapColor(aMedian[0], aMedian[1], aMedian[2]));
         }
+    }
+}
 
-        pReadAcc.reset();
+void medianHistogram(BitmapReadAccess& rReadAcc, BitmapWriteAccess& rWriteAcc, sal_Int32 nRadius,
+                     sal_Int32 nChannels)
+{
+    const sal_Int32 nWidth = rWriteAcc.Width();
+    const sal_Int32 nHeight = rWriteAcc.Height();
 
-        if (bRet)
-        {
-            const MapMode aMap(aBitmap.GetPrefMapMode());
-            const Size aPrefSize(aBitmap.GetPrefSize());
+    // Every tile sets up its column histograms once, so it has to be a good deal higher than
+    // the window to keep that cheap compared to sliding them down. The tiles are as narrow as
+    // possible without wasting too much on the columns of the windows beyond their sides, to
+    // keep the 512 bytes of histogram per column and channel in the cache.
+    const sal_Int32 nTileRows = std::max<sal_Int32>(64, 4 * (2 * nRadius + 1));
+    const sal_Int32 nTileColumns
+        = std::max<sal_Int32>(1024 / nChannels - 2 * nRadius, 2 * nRadius + 1);
+    const sal_Int32 nTilesY = (nHeight + nTileRows - 1) / nTileRows;
 
-            aBitmap = aNewBmp;
+    vcl::bitmap::parallelForRows(
+        nTilesY, sal_Int64(nWidth) * nTileRows, [&](sal_Int32 nStartTile, sal_Int32 nEndTile) {
+            const sal_Int32 nStartY = nStartTile * nTileRows;
+            const sal_Int32 nEndY = std::min(nHeight, (nEndTile + 1) * nTileRows) - 1;
+            for (sal_Int32 nStartX = 0; nStartX < nWidth; nStartX += nTileColumns)
+            {
+                medianHistogramTile(rReadAcc, rWriteAcc, nRadius, nChannels, nStartX,
+                                    std::min(nWidth, nStartX + nTileColumns) - 1, nStartY, nEndY);
+            }
+        });
+}
 
-            aBitmap.SetPrefMapMode(aMap);
-            aBitmap.SetPrefSize(aPrefSize);
-        }
-    }
+} // end anonymous namespace
+
+namespace vcl::bitmap
+{
+Bitmap medianFilter(const Bitmap& rBitmap, sal_Int32 nRadius)
+{
+    nRadius = std::clamp<sal_Int32>(nRadius, 0, MedianMaxRadius);
+
+    Bitmap aBitmap(rBitmap);
+    Bitmap::ScopedReadAccess pReadAcc(aBitmap);
+    if (!pReadAcc)
+        return Bitmap();
+
+    const bool bGrey = aBitmap.getPixelFormat() == vcl::PixelFormat::N8_BPP
+                       && pReadAcc->HasPalette() && pReadAcc->GetPalette().IsGreyPalette8Bit();
+
+    Bitmap aNewBmp(aBitmap.GetSizePixel(),
+                   bGrey ? vcl::PixelFormat::N8_BPP : vcl::PixelFormat::N24_BPP,
+                   bGrey ? &Bitmap::GetGreyPalette(256) : nullptr);
+    BitmapScopedWriteAccess pWriteAcc(aNewBmp);
+    if (!pWriteAcc)
+        return Bitmap();
+
+    if (nRadius == 1 && !bGrey)
+        medianNetwork3x3(*pReadAcc, *pWriteAcc);
+    else
+        medianHistogram(*pReadAcc, *pWriteAcc, nRadius, bGrey ? 1 : 3);
+
+    pWriteAcc.reset();
+    return aNewBmp;
+}
+
+} // end vcl::bitmap
+
+BitmapEx BitmapMedianFilter::execute(BitmapEx const& rBitmapEx) const
+{
+    Bitmap aBitmap(rBitmapEx.GetBitmap());
+    Bitmap aNewBmp(vcl::bitmap::medianFilter(aBitmap, 1));
+
+    if (aNewBmp.IsEmpty())
+        return BitmapEx();
+
+    // medianFilter() keeps grey bitmaps at 8 bit, but this filter always gave 24 bit
+    if (aNewBmp.getPixelFormat() != vcl::PixelFormat::N24_BPP
+        && !aNewBmp.Convert(BmpConversion::N24Bit))
+        return BitmapEx();
 
-    if (bRet)
-        return BitmapEx(aBitmap);
+    aNewBmp.SetPrefMapMode(aBitmap.GetPrefMapMode());
+    aNewBmp.SetPrefSize(aBitmap.GetPrefSize());
 
-    return BitmapEx();
+    return BitmapEx(aNewBmp);
 }
 
 /* vim:set shiftwidth=4 softtabstop=4 expandtab: */
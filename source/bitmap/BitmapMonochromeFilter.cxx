@@ -12,6 +12,7 @@
 #include <vcl/bitmapex.hxx>
 #include <vcl/BitmapMonochromeFilter.hxx>
 
+#include <bitmap/BitmapParallel.hxx>
 #include <bitmap/BitmapWriteAccess.hxx>
 
 BitmapEx BitmapMonochromeFilter::execute(BitmapEx const& aBitmapEx) const
@@ -34,43 +35,51 @@ BitmapEx BitmapMonochromeFilter::execute(BitmapEx const& aBitmapEx) const
 
             if (pReadAcc->HasPalette())
             {
-                for (sal_Int32 nY = 0; nY < nHeight; nY++)
-                {
-                    Scanline pScanline = pWriteAcc->GetScanline(nY);
-                    Scanline pScanlineRead = pReadAcc->GetScanline(nY);
-                    for (sal_Int32 nX = 0; nX < nWidth; nX++)
-                    {
-                        const sal_uInt8 cIndex = pReadAcc->GetIndexFromData(pScanlineRead, nX);
-                        if (pReadAcc->GetPaletteColor(cIndex).GetLuminance() >= mcThreshold)
+                vcl::bitmap::parallelForRows(
+                    nHeight, nWidth, [&](sal_Int32 nStartY, sal_Int32 nEndY) {
+                        for (sal_Int32 nY = nStartY; nY <= nEndY; nY++)
                         {
-                            pWriteAcc->SetPixelOnData(pScanline, nX, aWhite);
+                            Scanline pScanline = pWriteAcc->GetScanline(nY);
+                            Scanline pScanlineRead = pReadAcc->GetScanline(nY);
+                            for (sal_Int32 nX = 0; nX < nWidth; nX++)
+                            {
+                                const sal_uInt8 cIndex
+                                    = pReadAcc->GetIndexFromData(pScanlineRead, nX);
+                                if (pReadAcc->GetPaletteColor(cIndex).GetLuminance()
+                                    >= mcThreshold)
+                                {
+                                    pWriteAcc->SetPixelOnData(pScanline, nX, aWhite);
+                                }
+                                else
+                                {
+                                    pWriteAcc->SetPixelOnData(pScanline, nX, aBlack);
+                                }
+                            }
                         }
-                        else
-                        {
-                            pWriteAcc->SetPixelOnData(pScanline, nX, aBlack);
-                        }
-                    }
-                }
+                    });
             }
             else
             {
-                for (sal_Int32 nY = 0; nY < nHeight; nY++)
-                {
-                    Scanline pScanline = pWriteAcc->GetScanline(nY);
-                    Scanline pScanlineRead = pReadAcc->GetScanline(nY);
-                    for (sal_Int32 nX = 0; nX < nWidth; nX++)
-                    {
-                        if (pReadAcc->GetPixelFromData(pScanlineRead, nX).GetLuminance()
-                            >= mcThreshold)
-                        {
-                            pWriteAcc->SetPixelOnData(pScanline, nX, aWhite);
-                        }
-                        else
+                vcl::bitmap::parallelForRows(
+                    nHeight, nWidth, [&](sal_Int32 nStartY, sal_Int32 nEndY) {
+                        for (sal_Int32 nY = nStartY; nY <= nEndY; nY++)
                         {
-                            pWriteAcc->SetPixelOnData(pScanline, nX, aBlack);
+                            Scanline pScanline = pWriteAcc->GetScanline(nY);
+                            Scanline pScanlineRead = pReadAcc->GetScanline(nY);
+                            for (sal_Int32 nX = 0; nX < nWidth; nX++)
+                            {
+                                if (pReadAcc->GetPixelFromData(pScanlineRead, nX).GetLuminance()
+                                    >= mcThreshold)
+                                {
+                                    pWriteAcc->SetPixelOnData(pScanline, nX, aWhite);
+                                }
+                                else
+                                {
+                                    pWriteAcc->SetPixelOnData(pScanline, nX, aBlack);
+                                }
+                            }
                         }
-                    }
-                }
+                    });
             }
 
             pWriteAcc.reset();
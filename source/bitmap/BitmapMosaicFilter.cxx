@@ -12,8 +12,11 @@
 #include <vcl/bitmapex.hxx>
 #include <vcl/BitmapMosaicFilter.hxx>
 
+#include <bitmap/BitmapParallel.hxx>
 #include <bitmap/BitmapWriteAccess.hxx>
 
+#include <algorithm>
+
 BitmapEx BitmapMosaicFilter::execute(BitmapEx const& rBitmapEx) const
 {
     Bitmap aBitmap(rBitmapEx.GetBitmap());
@@ -49,109 +52,106 @@ BitmapEx BitmapMosaicFilter::execute(BitmapEx const& rBitmapEx) const
 
         if (bConditionsMet)
         {
-            BitmapColor aCol;
-            sal_Int32 nX, nY, nX1, nX2, nY1, nY2, nSumR, nSumG, nSumB;
-            double fArea_1;
-
-            nY1 = 0;
-            nY2 = mnTileHeight - 1;
+            // the rows of tiles are independent, even when filtering in place
+            const sal_Int32 nTileRows = (nHeight + mnTileHeight - 1) / mnTileHeight;
 
-            if (nY2 >= nHeight)
-                nY2 = nHeight - 1;
-
-            do
-            {
-                nX1 = 0;
-                nX2 = mnTileWidth - 1;
+            vcl::bitmap::parallelForRows(
+                nTileRows, sal_Int64(nWidth) * mnTileHeight,
+                [&](sal_Int32 nStartTileRow, sal_Int32 nEndTileRow) {
+                    BitmapColor aCol;
+                    sal_Int32 nX, nY, nX1, nX2, nY1, nY2, nSumR, nSumG, nSumB;
+                    double fArea_1;
 
-                if (nX2 >= nWidth)
-                    nX2 = nWidth - 1;
-
-                fArea_1 = 1.0 / ((nX2 - nX1 + 1) * (nY2 - nY1 + 1));
-
-                if (!pNewBmp)
-                {
-                    do
+                    for (sal_Int32 nTileRow = nStartTileRow; nTileRow <= nEndTileRow; nTileRow++)
                     {
-                        for (nY = nY1, nSumR = nSumG = nSumB = 0; nY <= nY2; nY++)
-                        {
-                            Scanline pScanlineRead = pReadAcc->GetScanline(nY);
-                            for (nX = nX1; nX <= nX2; nX++)
-                            {
-                                aCol = pReadAcc->GetPixelFromData(pScanlineRead, nX);
-                                nSumR += aCol.GetRed();
-                                nSumG += aCol.GetGreen();
-                                nSumB += aCol.GetBlue();
-                            }
-                        }
+                        nY1 = nTileRow * mnTileHeight;
+                        nY2 = std::min(nY1 + mnTileHeight - 1, nHeight - 1);
 
-                        aCol.SetRed(static_cast<sal_uInt8>(nSumR * fArea_1));
-                        aCol.SetGreen(static_cast<sal_uInt8>(nSumG * fArea_1));
-                        aCol.SetBlue(static_cast<sal_uInt8>(nSumB * fArea_1));
-
-                        for (nY = nY1; nY <= nY2; nY++)
-                        {
-                            Scanline pScanline = pWriteAcc->GetScanline(nY);
-                            for (nX = nX1; nX <= nX2; nX++)
-                                pWriteAcc->SetPixelOnData(pScanline, nX, aCol);
-                        }
-
-                        nX1 += mnTileWidth;
-                        nX2 += mnTileWidth;
+                        nX1 = 0;
+                        nX2 = mnTileWidth - 1;
 
                         if (nX2 >= nWidth)
-                        {
                             nX2 = nWidth - 1;
-                            fArea_1 = 1.0 / ((nX2 - nX1 + 1) * (nY2 - nY1 + 1));
-                        }
-                    } while (nX1 < nWidth);
-                }
-                else
-                {
-                    do
-                    {
-                        for (nY = nY1, nSumR = nSumG = nSumB = 0; nY <= nY2; nY++)
-                        {
-                            Scanline pScanlineRead = pReadAcc->GetScanline(nY);
-                            for (nX = nX1; nX <= nX2; nX++)
-                            {
-                                const BitmapColor& rCol = pReadAcc->GetPaletteColor(
-                                    pReadAcc->GetIndexFromData(pScanlineRead, nX));
-                                nSumR += rCol.GetRed();
-                                nSumG += rCol.GetGreen();
-                                nSumB += rCol.GetBlue();
-                            }
-                        }
 
-                        aCol.SetRed(static_cast<sal_uInt8>(nSumR * fArea_1));
-                        aCol.SetGreen(static_cast<sal_uInt8>(nSumG * fArea_1));
-                        aCol.SetBlue(static_cast<sal_uInt8>(nSumB * fArea_1));
+                        fArea_1 = 1.0 / ((nX2 - nX1 + 1) * (nY2 - nY1 + 1));
 
-                        for (nY = nY1; nY <= nY2; nY++)
+                        if (!pNewBmp)
                         {
-                            Scanline pScanline = pWriteAcc->GetScanline(nY);
-                            for (nX = nX1; nX <= nX2; nX++)
-                                pWriteAcc->SetPixelOnData(pScanline, nX, aCol);
+                            do
+                            {
+                                for (nY = nY1, nSumR = nSumG = nSumB = 0; nY <= nY2; nY++)
+                                {
+                                    Scanline pScanlineRead = pReadAcc->GetScanline(nY);
+                                    for (nX = nX1; nX <= nX2; nX++)
+                                    {
+                                        aCol = pReadAcc->GetPixelFromData(pScanlineRead, nX);
+                                        nSumR += aCol.GetRed();
+                                        nSumG += aCol.GetGreen();
+                                        nSumB += aCol.GetBlue();
+                                    }
+                                }
+
+                                aCol.SetRed(static_cast<sal_uInt8>(nSumR * fArea_1));
+                                aCol.SetGreen(static_cast<sal_uInt8>(nSumG * fArea_1));
+                                aCol.SetBlue(static_cast<sal_uInt8>(nSumB * fArea_1));
+
+                                for (nY = nY1; nY <= nY2; nY++)
+                                {
+                                    Scanline pScanline = pWriteAcc->GetScanline(nY);
+                                    for (nX = nX1; nX <= nX2; nX++)
+                                        pWriteAcc->SetPixelOnData(pScanline, nX, aCol);
+                                }
+
+                                nX1 += mnTileWidth;
+                                nX2 += mnTileWidth;
+
+                                if (nX2 >= nWidth)
+                                {
+                                    nX2 = nWidth - 1;
+                                    fArea_1 = 1.0 / ((nX2 - nX1 + 1) * (nY2 - nY1 + 1));
+                                }
+                            } while (nX1 < nWidth);
                         }
-
-                        nX1 += mnTileWidth;
-                        nX2 += mnTileWidth;
-
-                        if (nX2 >= nWidth)
+                        else
                         {
-                            nX2 = nWidth - 1;
-                            fArea_1 = 1.0 / ((nX2 - nX1 + 1) * (nY2 - nY1 + 1));
+                            do
+                            {
+                                for (nY = nY1, nSumR = nSumG = nSumB = 0; nY <= nY2; nY++)
+                                {
+                                    Scanline pScanlineRead = pReadAcc->GetScanline(nY);
+                                    for (nX = nX1; nX <= nX2; nX++)
+                                    {
+                                        const BitmapColor& rCol = pReadAcc->GetPaletteColor(
+                                            pReadAcc->GetIndexFromData(pScanlineRead, nX));
+                                        nSumR += rCol.GetRed();
+                                        nSumG += rCol.GetGreen();
+                                        nSumB += rCol.GetBlue();
+                                    }
+                                }
+
+                                aCol.SetRed(static_cast<sal_uInt8>(nSumR * fArea_1));
+                                aCol.SetGreen(static_cast<sal_uInt8>(nSumG * fArea_1));
+                                aCol.SetBlue(static_cast<sal_uInt8>(nSumB * fArea_1));
+
+                                for (nY = nY1; nY <= nY2; nY++)
+                                {
+                                    Scanline pScanline = pWriteAcc->GetScanline(nY);
+                                    for (nX = nX1; nX <= nX2; nX++)
+                                        pWriteAcc->SetPixelOnData(pScanline, nX, aCol);
+                                }
+
+                                nX1 += mnTileWidth;
+                                nX2 += mnTileWidth;
+
+                                if (nX2 >= nWidth)
+                                {
+                                    nX2 = nWidth - 1;
+                                    fArea_1 = 1.0 / ((nX2 - nX1 + 1) * (nY2 - nY1 + 1));
+                                }
+                            } while (nX1 < nWidth);
                         }
-                    } while (nX1 < nWidth);
-                }
-
-                nY1 += mnTileHeight;
-                nY2 += mnTileHeight;
-
-                if (nY2 >= nHeight)
-                    nY2 = nHeight - 1;
-
-            } while (nY1 < nHeight);
+                    }
+                });
 
             bRet = true;
         }
@@ -0,0 +1,102 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <bitmap/BitmapParallel.hxx>
+
+#include <comphelper/threadpool.hxx>
+#include <sal/log.hxx>
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+
+namespace vcl::bitmap
+{
+namespace
+{
+// pixels per strip, small enough to balance the load but large enough to amortize the task
+constexpr sal_Int64 constStripPixels = 32 * 1024;
+
+class RowsTask : public comphelper::ThreadTask
+{
+    const std::function<void(sal_Int32, sal_Int32)>& mrFunction;
+    sal_Int32 mnStart;
+    sal_Int32 mnEnd;
+
+public:
+    explicit RowsTask(const std::shared_ptr<comphelper::ThreadTaskTag>& pTag,
+                      const std::function<void(sal_Int32, sal_Int32)>& rFunction,
+                      sal_Int32 nStart, sal_Int32 nEnd)
+        : comphelper::ThreadTask(pTag)
+        , mrFunction(rFunction)
+        , mnStart(nStart)
+        , mnEnd(nEnd)
+    {
+    }
+
+    virtual void doWork() override { mrFunction(mnStart, mnEnd); }
+};
+
+} // end anonymous namespace
+
+void parallelForRows(sal_Int32 nRows, sal_Int64 nPixelsPerRow,
+                     const std::function<void(sal_Int32, sal_Int32)>& rFunction,
+                     sal_Int64 nMinPixels)
+{
+    if (nRows <= 0)
+        return;
+
+    nPixelsPerRow = std::max<sal_Int64>(nPixelsPerRow, 1);
+
+    static bool bDisableThreadedFilters = getenv("VCL_NO_THREAD_FILTER");
+    if (bDisableThreadedFilters || nRows < 2 || nRows * nPixelsPerRow < nMinPixels)
+    {
+        rFunction(0, nRows - 1);
+        return;
+    }
+
+    const sal_Int32 nStripRows
+        = std::clamp<sal_Int64>(constStripPixels / nPixelsPerRow, 1, nRows);
+
+    comphelper::ThreadPool& rShared = comphelper::ThreadPool::getSharedOptimalPool();
+    auto pTag = comphelper::ThreadPool::createThreadTaskTag();
+
+    sal_Int32 nStart = 0;
+    try
+    {
+        for (; nRows - nStart > nStripRows; nStart += nStripRows)
+        {
+            auto pTask(std::make_unique<RowsTask>(pTag, rFunction, nStart,
+                                                  nStart + nStripRows - 1));
+            rShared.pushTask(std::move(pTask));
+        }
+    }
+    catch (...)
+    {
+        // the strips that were not queued are done below
+        SAL_WARN("vcl.gdi", "threaded bitmap filtering failed");
+    }
+
+    // Do the last (or the remaining) strip in main thread without threading overhead
+    try
+    {
+        rFunction(nStart, nRows - 1);
+    }
+    catch (...)
+    {
+        // the queued tasks still reference rFunction
+        rShared.waitUntilDone(pTag);
+        throw;
+    }
+    rShared.waitUntilDone(pTag);
+}
+
+} // end vcl::bitmap
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
@@ -0,0 +1,83 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <bitmap/BitmapRegionAccess.hxx>
+
+#include <salbmp.hxx>
+#include <salinst.hxx>
+#include <svdata.hxx>
+
+namespace vcl::bitmap
+{
+BitmapRegionAccess::BitmapRegionAccess(Bitmap& rBitmap, const tools::Rectangle& rRegion,
+                                       BitmapAccessMode nMode)
+    : maRegion(tools::Rectangle(Point(), rBitmap.GetSizePixel()).GetIntersection(rRegion))
+    , mnAccessMode(nMode)
+{
+    assert(nMode != BitmapAccessMode::Info && "Use BitmapInfoAccess");
+
+    mxSalBitmap = rBitmap.ImplGetSalBitmap();
+    if (!mxSalBitmap || maRegion.IsEmpty())
+        return;
+
+    // the same as BitmapInfoAccess does
+    if (mnAccessMode == BitmapAccessMode::Write)
+    {
+        mxSalBitmap->DropScaledCache();
+
+        if (mxSalBitmap.use_count() > 2)
+        {
+            mxSalBitmap.reset();
+            rBitmap.ImplMakeUnique();
+            mxSalBitmap = rBitmap.ImplGetSalBitmap();
+        }
+    }
+
+    mpBuffer = mxSalBitmap->AcquireRegionBuffer(mnAccessMode, maRegion);
+
+    if (!mpBuffer)
+    {
+        std::shared_ptr<SalBitmap> xNewSalBitmap(ImplGetSVData()->mpDefInst->CreateSalBitmap());
+        if (xNewSalBitmap->Create(*mxSalBitmap, rBitmap.getPixelFormat()))
+        {
+            mxSalBitmap = xNewSalBitmap;
+            rBitmap.ImplSetSalBitmap(mxSalBitmap);
+            mpBuffer = mxSalBitmap->AcquireRegionBuffer(mnAccessMode, maRegion);
+        }
+    }
+
+    if (!mpBuffer)
+        return;
+
+    if (mpBuffer->mnWidth == rBitmap.GetSizePixel().Width()
+        && mpBuffer->mnHeight == rBitmap.GetSizePixel().Height())
+        maBufferPos = maRegion.TopLeft();
+    else
+        assert(mpBuffer->mnWidth == maRegion.GetWidth()
+               && mpBuffer->mnHeight == maRegion.GetHeight());
+
+    mFncGetPixel = BitmapReadAccess::GetPixelFunction(mpBuffer->mnFormat);
+    mFncSetPixel = BitmapReadAccess::SetPixelFunction(mpBuffer->mnFormat);
+
+    if (!mFncGetPixel || !mFncSetPixel)
+    {
+        mxSalBitmap->ReleaseBuffer(mpBuffer, mnAccessMode);
+        mpBuffer = nullptr;
+    }
+}
+
+BitmapRegionAccess::~BitmapRegionAccess()
+{
+    if (mpBuffer)
+        mxSalBitmap->ReleaseBuffer(mpBuffer, mnAccessMode);
+}
+
+} // end vcl::bitmap
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
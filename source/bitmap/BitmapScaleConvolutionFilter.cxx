@@ -19,12 +19,23 @@
 
 #include <osl/diagnose.h>
 #include <tools/helpers.hxx>
+#include <tools/simdsupport.hxx>
 
+#include <bitmap/BitmapParallel.hxx>
 #include <bitmap/BitmapWriteAccess.hxx>
 #include <bitmap/BitmapScaleConvolutionFilter.hxx>
 
 #include <algorithm>
+#include <cstring>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <typeindex>
+#include <typeinfo>
+
+#ifdef LO_SSE2_AVAILABLE
+#include <emmintrin.h>
+#endif
 
 namespace vcl
 {
@@ -32,25 +43,46 @@ namespace vcl
 namespace
 {
 
-void ImplCalculateContributions(
-    const sal_Int32 aSourceSize,
-    const sal_Int32 aDestinationSize,
-    sal_Int32& aNumberOfContributions,
-    std::vector<sal_Int16>& rWeights,
-    std::vector<sal_Int32>& rPixels,
-    std::vector<sal_Int32>& rCounts,
-    const Kernel& aKernel)
+// The source pixels contributing to each destination pixel along one axis, and their weights
+struct Contributions
+{
+    Contributions(sal_Int32 nSourceSize, sal_Int32 nDestinationSize, const Kernel& rKernel)
+        : mnSourceSize(nSourceSize)
+        , mnDestinationSize(nDestinationSize)
+        , maKernelType(typeid(rKernel))
+    {
+    }
+
+    sal_Int32 mnSourceSize;
+    sal_Int32 mnDestinationSize;
+    std::type_index maKernelType;
+    sal_Int32 mnNumberOfContributions = 0;
+    std::vector<sal_Int16> maWeights;
+    std::vector<sal_Int32> maPixels;
+    std::vector<sal_Int32> maCounts;
+    std::vector<sal_Int32> maSums;
+    // all sums are in 1..65536, so that dividing by them in float is exact, see divideSSE2()
+    bool mbSmallSums = true;
+};
+
+void ImplCalculateContributions(Contributions& rContributions, const Kernel& aKernel)
 {
+    const sal_Int32 aSourceSize(rContributions.mnSourceSize);
+    const sal_Int32 aDestinationSize(rContributions.mnDestinationSize);
     const double fSamplingRadius(aKernel.GetWidth());
     const double fScale(aDestinationSize / static_cast< double >(aSourceSize));
     const double fScaledRadius((fScale < 1.0) ? fSamplingRadius / fScale : fSamplingRadius);
     const double fFilterFactor(std::min(fScale, 1.0));
 
-    aNumberOfContributions = (sal_Int32(fabs(ceil(fScaledRadius))) * 2) + 1;
+    const sal_Int32 aNumberOfContributions((sal_Int32(fabs(ceil(fScaledRadius))) * 2) + 1);
     const sal_Int32 nAllocSize(aDestinationSize * aNumberOfContributions);
+    std::vector<sal_Int16>& rWeights(rContributions.maWeights);
+    std::vector<sal_Int32>& rPixels(rContributions.maPixels);
+    rContributions.mnNumberOfContributions = aNumberOfContributions;
     rWeights.resize(nAllocSize);
     rPixels.resize(nAllocSize);
-    rCounts.resize(aDestinationSize);
+    rContributions.maCounts.resize(aDestinationSize);
+    rContributions.maSums.resize(aDestinationSize);
 
     for(sal_Int32 i(0); i < aDestinationSize; i++)
     {
@@ -59,6 +91,7 @@ void ImplCalculateContributions(
         const sal_Int32 aLeft(static_cast< sal_Int32 >(floor(aCenter - fScaledRadius)));
         const sal_Int32 aRight(static_cast< sal_Int32 >(ceil(aCenter + fScaledRadius)));
         sal_Int32 aCurrentCount(0);
+        sal_Int32 aSum(0);
 
         for(sal_Int32 j(aLeft); j <= aRight; j++)
         {
@@ -77,14 +110,315 @@ void ImplCalculateContributions(
             // scale the weight by 255 since we're converting from float to int
             rWeights[nIndex] = aWeight * 255;
             rPixels[nIndex] = aPixelIndex;
+            aSum += rWeights[nIndex];
 
             aCurrentCount++;
         }
 
-        rCounts[i] = aCurrentCount;
+        assert(aSum != 0);
+
+        rContributions.maCounts[i] = aCurrentCount;
+        rContributions.maSums[i] = aSum;
+        if(aSum < 1 || aSum > 65536)
+        {
+            rContributions.mbSmallSums = false;
+        }
+    }
+}
+
+// Images are often scaled to the same size repeatedly (e.g. when repainting), so keep the
+// tables of the last few scalings around.
+std::shared_ptr<const Contributions> ImplGetContributions(
+    const sal_Int32 nSourceSize,
+    const sal_Int32 nDestinationSize,
+    const Kernel& rKernel)
+{
+    static std::mutex aMutex;
+    static std::list<std::shared_ptr<const Contributions>> aCache;
+    constexpr size_t nMaxCached = 8;
+
+    const std::type_index aKernelType(typeid(rKernel));
+    {
+        std::scoped_lock aGuard(aMutex);
+        for (auto it = aCache.begin(); it != aCache.end(); ++it)
+        {
+            if ((*it)->mnSourceSize == nSourceSize && (*it)->mnDestinationSize == nDestinationSize
+                && (*it)->maKernelType == aKernelType)
+            {
+                aCache.splice(aCache.begin(), aCache, it);
+                return aCache.front();
+            }
+        }
+    }
+
+    auto pContributions = std::make_shared<Contributions>(nSourceSize, nDestinationSize, rKernel);
+    ImplCalculateContributions(*pContributions, rKernel);
+
+    std::scoped_lock aGuard(aMutex);
+    aCache.push_front(pContributions);
+    if (aCache.size() > nMaxCached)
+        aCache.pop_back();
+    return pContributions;
+}
+
+sal_uInt8 ImplDivide(sal_Int32 nValue, sal_Int32 nSum)
+{
+    return static_cast< sal_uInt8 >(MinMax(static_cast< sal_Int32 >(nValue / nSum), 0, 255));
+}
+
+#ifdef LO_SSE2_AVAILABLE
+
+struct DivisorSSE2
+{
+    explicit DivisorSSE2(sal_Int32 nSum)
+        : maSum(_mm_set1_ps(static_cast<float>(nSum)))
+        , maInverse(_mm_set1_ps(1.0f / nSum))
+        , maMax(_mm_set1_epi32(256 * nSum - 1))
+    {
+    }
+
+    __m128 maSum;
+    __m128 maInverse;
+    __m128i maMax;
+};
+
+// Gives the same as ImplDivide() for four values at once, as long as the sum is in 1..65536
+__m128i divideSSE2(__m128i aValues, const DivisorSSE2& rDivisor)
+{
+    // Negative values give 0 and values of 256 * sum or more give 255 anyway, and in between
+    // all values and products are below 2^24 and so exact in float.
+    aValues = _mm_and_si128(aValues, _mm_cmpgt_epi32(aValues, _mm_setzero_si128()));
+    const __m128i aTooLarge = _mm_cmpgt_epi32(aValues, rDivisor.maMax);
+    aValues = _mm_or_si128(_mm_andnot_si128(aTooLarge, aValues),
+                           _mm_and_si128(aTooLarge, rDivisor.maMax));
+
+    // multiplying with the rounded reciprocal may be one off, fix that using the remainder
+    const __m128 aValuesF = _mm_cvtepi32_ps(aValues);
+    __m128i aQuotient = _mm_cvttps_epi32(_mm_mul_ps(aValuesF, rDivisor.maInverse));
+    const __m128 aRemainder
+        = _mm_sub_ps(aValuesF, _mm_mul_ps(_mm_cvtepi32_ps(aQuotient), rDivisor.maSum));
+    aQuotient = _mm_sub_epi32(aQuotient, _mm_castps_si128(_mm_cmpge_ps(aRemainder, rDivisor.maSum)));
+    aQuotient = _mm_add_epi32(aQuotient,
+                              _mm_castps_si128(_mm_cmplt_ps(aRemainder, _mm_setzero_ps())));
+    return aQuotient;
+}
+
+__m128i loadPixelSSE2(const sal_uInt8* pPixel)
+{
+    sal_Int32 nPixel;
+    memcpy(&nPixel, pPixel, 4);
+    return _mm_cvtsi32_si128(nPixel);
+}
+
+// two 16 bit weights for _mm_madd_epi16
+__m128i weightPairSSE2(sal_Int16 nWeight0, sal_Int16 nWeight1)
+{
+    const sal_uInt32 nLow(static_cast<sal_uInt16>(nWeight0));
+    const sal_uInt32 nHigh(static_cast<sal_uInt16>(nWeight1));
+    return _mm_set1_epi32(static_cast<sal_Int32>((nHigh << 16) | nLow));
+}
+
+#endif
+
+// Scales one row with four bytes per pixel (three colors in the destination order and one
+// unused) into a row of the 24 bit destination.
+void ImplScaleRowHor(const Contributions& rContributions, const sal_uInt8* pSource, sal_uInt8* pDestination)
+{
+    const sal_Int32 nStride(rContributions.mnNumberOfContributions);
+
+    for(sal_Int32 x(0); x < rContributions.mnDestinationSize; x++)
+    {
+        const sal_Int16* pWeights(&rContributions.maWeights[x * nStride]);
+        const sal_Int32* pPixels(&rContributions.maPixels[x * nStride]);
+        const sal_Int32 nCount(rContributions.maCounts[x]);
+        const sal_Int32 nSum(rContributions.maSums[x]);
+        sal_uInt8* pResult(pDestination + 3 * x);
+
+#ifdef LO_SSE2_AVAILABLE
+        if(rContributions.mbSmallSums)
+        {
+            const __m128i aZero(_mm_setzero_si128());
+            __m128i aValues(_mm_setzero_si128());
+            sal_Int32 j(0);
+
+            // two source pixels per multiply-add
+            for(; j + 1 < nCount; j += 2)
+            {
+                const __m128i aPixel0(loadPixelSSE2(pSource + 4 * pPixels[j]));
+                const __m128i aPixel1(loadPixelSSE2(pSource + 4 * pPixels[j + 1]));
+                const __m128i aPair(_mm_unpacklo_epi8(_mm_unpacklo_epi8(aPixel0, aPixel1), aZero));
+                aValues = _mm_add_epi32(aValues, _mm_madd_epi16(aPair, weightPairSSE2(pWeights[j], pWeights[j + 1])));
+            }
+
+            if(j < nCount)
+            {
+                const __m128i aPixel(_mm_unpacklo_epi8(loadPixelSSE2(pSource + 4 * pPixels[j]), aZero));
+                const __m128i aPair(_mm_unpacklo_epi16(aPixel, aZero));
+                aValues = _mm_add_epi32(aValues, _mm_madd_epi16(aPair, weightPairSSE2(pWeights[j], 0)));
+            }
+
+            __m128i aResult(divideSSE2(aValues, DivisorSSE2(nSum)));
+            aResult = _mm_packs_epi32(aResult, aResult);
+            aResult = _mm_packus_epi16(aResult, aResult);
+            const sal_Int32 nResult(_mm_cvtsi128_si32(aResult));
+            memcpy(pResult, &nResult, 3);
+            continue;
+        }
+#endif
+
+        sal_Int32 aValue0(0);
+        sal_Int32 aValue1(0);
+        sal_Int32 aValue2(0);
+
+        for(sal_Int32 j(0); j < nCount; j++)
+        {
+            const sal_Int16 aWeight(pWeights[j]);
+            const sal_uInt8* pPixel(pSource + 4 * pPixels[j]);
+
+            aValue0 += aWeight * pPixel[0];
+            aValue1 += aWeight * pPixel[1];
+            aValue2 += aWeight * pPixel[2];
+        }
+
+        pResult[0] = ImplDivide(aValue0, nSum);
+        pResult[1] = ImplDivide(aValue1, nSum);
+        pResult[2] = ImplDivide(aValue2, nSum);
     }
 }
 
+// Scales the rows of the source into row y of the destination. Every byte is handled on its
+// own, so the rows only need to have the same layout as the destination.
+void ImplScaleRowVer(const Contributions& rContributions, sal_Int32 y,
+                     const std::vector<const sal_uInt8*>& rRows, sal_Int32 nBytes, sal_uInt8* pDestination)
+{
+    const sal_Int32 nStride(rContributions.mnNumberOfContributions);
+    const sal_Int16* pWeights(&rContributions.maWeights[y * nStride]);
+    const sal_Int32* pPixels(&rContributions.maPixels[y * nStride]);
+    const sal_Int32 nCount(rContributions.maCounts[y]);
+    const sal_Int32 nSum(rContributions.maSums[y]);
+    sal_Int32 i(0);
+
+#ifdef LO_SSE2_AVAILABLE
+    if(rContributions.mbSmallSums)
+    {
+        const __m128i aZero(_mm_setzero_si128());
+        const DivisorSSE2 aDivisor(nSum);
+
+        for(; i + 16 <= nBytes; i += 16)
+        {
+            __m128i aValues[4] = { aZero, aZero, aZero, aZero };
+
+            // two source rows per multiply-add
+            for(sal_Int32 j(0); j < nCount; j += 2)
+            {
+                const bool bPair(j + 1 < nCount);
+                const sal_uInt8* pRow0(rRows[pPixels[j]] + i);
+                const sal_uInt8* pRow1(bPair ? rRows[pPixels[j + 1]] + i : nullptr);
+                const __m128i aRow0(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow0)));
+                const __m128i aRow1(pRow1 ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow1)) : aZero);
+                const __m128i aWeights(weightPairSSE2(pWeights[j], bPair ? pWeights[j + 1] : 0));
+                const __m128i aLow(_mm_unpacklo_epi8(aRow0, aRow1));
+                const __m128i aHigh(_mm_unpackhi_epi8(aRow0, aRow1));
+
+                aValues[0] = _mm_add_epi32(aValues[0], _mm_madd_epi16(_mm_unpacklo_epi8(aLow, aZero), aWeights));
+                aValues[1] = _mm_add_epi32(aValues[1], _mm_madd_epi16(_mm_unpackhi_epi8(aLow, aZero), aWeights));
+                aValues[2] = _mm_add_epi32(aValues[2], _mm_madd_epi16(_mm_unpacklo_epi8(aHigh, aZero), aWeights));
+                aValues[3] = _mm_add_epi32(aValues[3], _mm_madd_epi16(_mm_unpackhi_epi8(aHigh, aZero), aWeights));
+            }
+
+            const __m128i aResultLow(_mm_packs_epi32(divideSSE2(aValues[0], aDivisor),
+                                                     divideSSE2(aValues[1], aDivisor)));
+            const __m128i aResultHigh(_mm_packs_epi32(divideSSE2(aValues[2], aDivisor),
+                                                      divideSSE2(aValues[3], aDivisor)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDestination + i),
+                             _mm_packus_epi16(aResultLow, aResultHigh));
+        }
+    }
+#endif
+
+    for(; i < nBytes; i++)
+    {
+        sal_Int32 aValue(0);
+
+        for(sal_Int32 j(0); j < nCount; j++)
+        {
+            aValue += pWeights[j] * rRows[pPixels[j]][i];
+        }
+
+        pDestination[i] = ImplDivide(aValue, nSum);
+    }
+}
+
+// Reads row y of the source with nPixelBytes (3 or 4) per pixel and the colors in the order
+// of the 24 bit destination.
+void ImplReadRow(const BitmapReadAccess& rReadAcc, sal_Int32 y, ScanlineFormat eDestinationFormat,
+                 sal_Int32 nPixelBytes, sal_uInt8* pRow)
+{
+    const sal_Int32 nWidth(rReadAcc.Width());
+    const Scanline pScanlineRead(rReadAcc.GetScanline(y));
+
+    if(rReadAcc.GetScanlineFormat() == eDestinationFormat)
+    {
+        if(nPixelBytes == 3)
+        {
+            memcpy(pRow, pScanlineRead, 3 * nWidth);
+            return;
+        }
+
+        for(sal_Int32 x(0); x < nWidth; x++)
+        {
+            memcpy(pRow + 4 * x, pScanlineRead + 3 * x, 3);
+            pRow[4 * x + 3] = 0;
+        }
+        return;
+    }
+
+    const bool bBgr(eDestinationFormat == ScanlineFormat::N24BitTcBgr);
+
+    for(sal_Int32 x(0); x < nWidth; x++)
+    {
+        const BitmapColor aColor(rReadAcc.HasPalette()
+            ? rReadAcc.GetPaletteColor(rReadAcc.GetIndexFromData(pScanlineRead, x))
+            : rReadAcc.GetPixelFromData(pScanlineRead, x));
+        sal_uInt8* pPixel(pRow + nPixelBytes * x);
+
+        pPixel[0] = bBgr ? aColor.GetBlue() : aColor.GetRed();
+        pPixel[1] = aColor.GetGreen();
+        pPixel[2] = bBgr ? aColor.GetRed() : aColor.GetBlue();
+        if(nPixelBytes == 4)
+        {
+            pPixel[3] = 0;
+        }
+    }
+}
+
+// Stores a row with three bytes per pixel in RGB order into row y of a destination whose
+// scanlines are not packed 24 bit, one pixel at a time.
+void ImplWriteRow(BitmapWriteAccess& rWriteAcc, sal_Int32 y, const sal_uInt8* pRow)
+{
+    const sal_Int32 nWidth(rWriteAcc.Width());
+    Scanline pScanline(rWriteAcc.GetScanline(y));
+
+    for(sal_Int32 x(0); x < nWidth; x++)
+    {
+        const BitmapColor aColor(pRow[3 * x], pRow[3 * x + 1], pRow[3 * x + 2]);
+
+        if(rWriteAcc.HasPalette())
+        {
+            rWriteAcc.SetPixelOnData(pScanline, x, BitmapColor(static_cast< sal_uInt8 >(rWriteAcc.GetBestPaletteIndex(aColor))));
+        }
+        else
+        {
+            rWriteAcc.SetPixelOnData(pScanline, x, aColor);
+        }
+    }
+}
+
+bool ImplIsPacked24Bit(ScanlineFormat eFormat)
+{
+    return eFormat == ScanlineFormat::N24BitTcBgr || eFormat == ScanlineFormat::N24BitTcRgb;
+}
+
 bool ImplScaleConvolutionHor(Bitmap& rSource, Bitmap& rTarget, const double& rScaleX, const Kernel& aKernel)
 {
     // Do horizontal filtering
@@ -101,73 +435,37 @@ bool ImplScaleConvolutionHor(Bitmap& rSource, Bitmap& rTarget, const double& rSc
 
     if(pReadAcc)
     {
-        std::vector<sal_Int16> aWeights;
-        std::vector<sal_Int32> aPixels;
-        std::vector<sal_Int32> aCounts;
-        sal_Int32 aNumberOfContributions(0);
-
+        const std::shared_ptr<const Contributions> pContributions(ImplGetContributions(nWidth, nNewWidth, aKernel));
         const sal_Int32 nHeight(rSource.GetSizePixel().Height());
-        ImplCalculateContributions(nWidth, nNewWidth, aNumberOfContributions, aWeights, aPixels, aCounts, aKernel);
         rTarget = Bitmap(Size(nNewWidth, nHeight), vcl::PixelFormat::N24_BPP);
         BitmapScopedWriteAccess pWriteAcc(rTarget);
-        bool bResult(pWriteAcc);
 
-        if(bResult)
+        if(pWriteAcc)
         {
-            for(sal_Int32 y(0); y < nHeight; y++)
-            {
-                Scanline pScanline = pWriteAcc->GetScanline( y );
-                Scanline pScanlineRead = pReadAcc->GetScanline( y );
-                for(sal_Int32 x(0); x < nNewWidth; x++)
-                {
-                    const sal_Int32 aBaseIndex(x * aNumberOfContributions);
-                    sal_Int32 aSum(0);
-                    sal_Int32 aValueRed(0);
-                    sal_Int32 aValueGreen(0);
-                    sal_Int32 aValueBlue(0);
-
-                    for(sal_Int32 j(0); j < aCounts[x]; j++)
-                    {
-                        const sal_Int32 aIndex(aBaseIndex + j);
-                        const sal_Int16 aWeight(aWeights[aIndex]);
-                        BitmapColor aColor;
+            const bool bPacked(ImplIsPacked24Bit(pWriteAcc->GetScanlineFormat()));
+            const ScanlineFormat eFormat(bPacked ? pWriteAcc->GetScanlineFormat() : ScanlineFormat::N24BitTcRgb);
 
-                        aSum += aWeight;
+            vcl::bitmap::parallelForRows(
+                nHeight, sal_Int64(nNewWidth) * pContributions->mnNumberOfContributions,
+                [&](sal_Int32 nStartY, sal_Int32 nEndY) {
+                    std::vector<sal_uInt8> aRow(4 * nWidth);
+                    std::vector<sal_uInt8> aResult(bPacked ? 0 : 3 * nNewWidth);
 
-                        if(pReadAcc->HasPalette())
+                    for(sal_Int32 y(nStartY); y <= nEndY; y++)
+                    {
+                        ImplReadRow(*pReadAcc, y, eFormat, 4, aRow.data());
+                        if(bPacked)
                         {
-                            aColor = pReadAcc->GetPaletteColor(pReadAcc->GetIndexFromData(pScanlineRead, aPixels[aIndex]));
+                            ImplScaleRowHor(*pContributions, aRow.data(), pWriteAcc->GetScanline(y));
                         }
                         else
                         {
-                            aColor = pReadAcc->GetPixelFromData(pScanlineRead, aPixels[aIndex]);
+                            ImplScaleRowHor(*pContributions, aRow.data(), aResult.data());
+                            ImplWriteRow(*pWriteAcc, y, aResult.data());
                         }
-
-                        aValueRed += aWeight * aColor.GetRed();
-                        aValueGreen += aWeight * aColor.GetGreen();
-                        aValueBlue += aWeight * aColor.GetBlue();
                     }
+                });
 
-                    assert(aSum != 0);
-
-                    const BitmapColor aResultColor(
-                        static_cast< sal_uInt8 >(MinMax(static_cast< sal_Int32 >(aValueRed / aSum), 0, 255)),
-                        static_cast< sal_uInt8 >(MinMax(static_cast< sal_Int32 >(aValueGreen / aSum), 0, 255)),
-                        static_cast< sal_uInt8 >(MinMax(static_cast< sal_Int32 >(aValueBlue / aSum), 0, 255)));
-
-                    pWriteAcc->SetPixelOnData(pScanline, x, aResultColor);
-                }
-            }
-
-            pWriteAcc.reset();
-        }
-
-        aWeights.clear();
-        aCounts.clear();
-        aPixels.clear();
-
-        if(bResult)
-        {
             return true;
         }
     }
@@ -191,71 +489,62 @@ bool ImplScaleConvolutionVer(Bitmap& rSource, Bitmap& rTarget, const double& rSc
 
     if(pReadAcc)
     {
-        std::vector<sal_Int16> aWeights;
-        std::vector<sal_Int32> aPixels;
-        std::vector<sal_Int32> aCounts;
-        sal_Int32 aNumberOfContributions(0);
-
+        const std::shared_ptr<const Contributions> pContributions(ImplGetContributions(nHeight, nNewHeight, aKernel));
         const sal_Int32 nWidth(rSource.GetSizePixel().Width());
-        ImplCalculateContributions(nHeight, nNewHeight, aNumberOfContributions, aWeights, aPixels, aCounts, aKernel);
         rTarget = Bitmap(Size(nWidth, nNewHeight), vcl::PixelFormat::N24_BPP);
         BitmapScopedWriteAccess pWriteAcc(rTarget);
-        bool bResult(pWriteAcc);
 
         if(pWriteAcc)
         {
-            std::vector<BitmapColor> aScanline(nHeight);
-            for(sal_Int32 x(0); x < nWidth; x++)
+            const bool bPacked(ImplIsPacked24Bit(pWriteAcc->GetScanlineFormat()));
+            const ScanlineFormat eFormat(bPacked ? pWriteAcc->GetScanlineFormat() : ScanlineFormat::N24BitTcRgb);
+            const sal_Int32 nBytes(3 * nWidth);
+            std::vector<const sal_uInt8*> aRows(nHeight);
+            std::vector<sal_uInt8> aConverted;
+
+            if(pReadAcc->GetScanlineFormat() == eFormat)
             {
                 for(sal_Int32 y(0); y < nHeight; y++)
-                        if(pReadAcc->HasPalette())
-                            aScanline[y] = pReadAcc->GetPaletteColor(pReadAcc->GetPixelIndex(y, x));
-                        else
-                            aScanline[y] = pReadAcc->GetPixel(y, x);
-                for(sal_Int32 y(0); y < nNewHeight; y++)
                 {
-                    const sal_Int32 aBaseIndex(y * aNumberOfContributions);
-                    sal_Int32 aSum(0);
-                    sal_Int32 aValueRed(0);
-                    sal_Int32 aValueGreen(0);
-                    sal_Int32 aValueBlue(0);
+                    aRows[y] = pReadAcc->GetScanline(y);
+                }
+            }
+            else
+            {
+                // every source row is needed for several destination rows, convert them once
+                aConverted.resize(sal_Int64(nBytes) * nHeight);
+                for(sal_Int32 y(0); y < nHeight; y++)
+                {
+                    aRows[y] = aConverted.data() + sal_Int64(nBytes) * y;
+                }
 
-                    for(sal_Int32 j(0); j < aCounts[y]; j++)
+                vcl::bitmap::parallelForRows(nHeight, nWidth, [&](sal_Int32 nStartY, sal_Int32 nEndY) {
+                    for(sal_Int32 y(nStartY); y <= nEndY; y++)
                     {
-                        const sal_Int32 aIndex(aBaseIndex + j);
-                        const sal_Int16 aWeight(aWeights[aIndex]);
-                        aSum += aWeight;
-                        const BitmapColor & aColor = aScanline[aPixels[aIndex]];
-                        aValueRed += aWeight * aColor.GetRed();
-                        aValueGreen += aWeight * aColor.GetGreen();
-                        aValueBlue += aWeight * aColor.GetBlue();
+                        ImplReadRow(*pReadAcc, y, eFormat, 3, aConverted.data() + sal_Int64(nBytes) * y);
                     }
+                });
+            }
 
-                    assert(aSum != 0);
-
-                    const BitmapColor aResultColor(
-                        static_cast< sal_uInt8 >(MinMax(static_cast< sal_Int32 >(aValueRed / aSum), 0, 255)),
-                        static_cast< sal_uInt8 >(MinMax(static_cast< sal_Int32 >(aValueGreen / aSum), 0, 255)),
-                        static_cast< sal_uInt8 >(MinMax(static_cast< sal_Int32 >(aValueBlue / aSum), 0, 255)));
+            vcl::bitmap::parallelForRows(
+                nNewHeight, sal_Int64(nWidth) * pContributions->mnNumberOfContributions,
+                [&](sal_Int32 nStartY, sal_Int32 nEndY) {
+                    std::vector<sal_uInt8> aResult(bPacked ? 0 : nBytes);
 
-                    if(pWriteAcc->HasPalette())
-                    {
-                        pWriteAcc->SetPixelIndex(y, x, static_cast< sal_uInt8 >(pWriteAcc->GetBestPaletteIndex(aResultColor)));
-                    }
-                    else
+                    for(sal_Int32 y(nStartY); y <= nEndY; y++)
                     {
-                        pWriteAcc->SetPixel(y, x, aResultColor);
+                        if(bPacked)
+                        {
+                            ImplScaleRowVer(*pContributions, y, aRows, nBytes, pWriteAcc->GetScanline(y));
+                        }
+                        else
+                        {
+                            ImplScaleRowVer(*pContributions, y, aRows, nBytes, aResult.data());
+                            ImplWriteRow(*pWriteAcc, y, aResult.data());
+                        }
                     }
-                }
-            }
-        }
+                });
 
-        aWeights.clear();
-        aCounts.clear();
-        aPixels.clear();
-
-        if(bResult)
-        {
             return true;
         }
     }
@@ -14,6 +14,7 @@
 #include <vcl/bitmapex.hxx>
 #include <vcl/BitmapSepiaFilter.hxx>
 
+#include <bitmap/BitmapParallel.hxx>
 #include <bitmap/BitmapWriteAccess.hxx>
 
 #include <algorithm>
@@ -45,7 +46,6 @@ BitmapEx BitmapSepiaFilter::execute(BitmapEx const& rBitmapEx) const
 
         if (pWriteAcc)
         {
-            BitmapColor aCol(sal_uInt8(0));
             const sal_Int32 nWidth = pWriteAcc->Width();
             const sal_Int32 nHeight = pWriteAcc->Height();
 
@@ -58,29 +58,39 @@ BitmapEx BitmapSepiaFilter::execute(BitmapEx const& rBitmapEx) const
                     pIndexMap[i] = pReadAcc->GetPaletteColor(i).GetLuminance();
                 }
 
-                for (sal_Int32 nY = 0; nY < nHeight; nY++)
-                {
-                    Scanline pScanline = pWriteAcc->GetScanline(nY);
-                    Scanline pScanlineRead = pReadAcc->GetScanline(nY);
-                    for (sal_Int32 nX = 0; nX < nWidth; nX++)
-                    {
-                        aCol.SetIndex(pIndexMap[pReadAcc->GetIndexFromData(pScanlineRead, nX)]);
-                        pWriteAcc->SetPixelOnData(pScanline, nX, aCol);
-                    }
-                }
+                vcl::bitmap::parallelForRows(
+                    nHeight, nWidth, [&](sal_Int32 nStartY, sal_Int32 nEndY) {
+                        BitmapColor aCol(sal_uInt8(0));
+                        for (sal_Int32 nY = nStartY; nY <= nEndY; nY++)
+                        {
+                            Scanline pScanline = pWriteAcc->GetScanline(nY);
+                            Scanline pScanlineRead = pReadAcc->GetScanline(nY);
+                            for (sal_Int32 nX = 0; nX < nWidth; nX++)
+                            {
+                                aCol.SetIndex(
+                                    pIndexMap[pReadAcc->GetIndexFromData(pScanlineRead, nX)]);
+                                pWriteAcc->SetPixelOnData(pScanline, nX, aCol);
+                            }
+                        }
+                    });
             }
             else
             {
-                for (sal_Int32 nY = 0; nY < nHeight; nY++)
-                {
-                    Scanline pScanline = pWriteAcc->GetScanline(nY);
-                    Scanline pScanlineRead = pReadAcc->GetScanline(nY);
-                    for (sal_Int32 nX = 0; nX < nWidth; nX++)
-                    {
-                        aCol.SetIndex(pReadAcc->GetPixelFromData(pScanlineRead, nX).GetLuminance());
-                        pWriteAcc->SetPixelOnData(pScanline, nX, aCol);
-                    }
-                }
+                vcl::bitmap::parallelForRows(
+                    nHeight, nWidth, [&](sal_Int32 nStartY, sal_Int32 nEndY) {
+                        BitmapColor aCol(sal_uInt8(0));
+                        for (sal_Int32 nY = nStartY; nY <= nEndY; nY++)
+                        {
+                            Scanline pScanline = pWriteAcc->GetScanline(nY);
+                            Scanline pScanlineRead = pReadAcc->GetScanline(nY);
+                            for (sal_Int32 nX = 0; nX < nWidth; nX++)
+                            {
+                                aCol.SetIndex(
+                                    pReadAcc->GetPixelFromData(pScanlineRead, nX).GetLuminance());
+                                pWriteAcc->SetPixelOnData(pScanline, nX, aCol);
+                            }
+                        }
+                    });
             }
 
             pWriteAcc.reset();
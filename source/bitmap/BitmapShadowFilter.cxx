@@ -12,6 +12,7 @@
 #include <vcl/BitmapColor.hxx>
 #include <vcl/BitmapShadowFilter.hxx>
 
+#include <bitmap/BitmapParallel.hxx>
 #include <bitmap/BitmapWriteAccess.hxx>
 
 BitmapEx BitmapShadowFilter::execute(BitmapEx const& rBitmapEx) const
@@ -22,25 +23,28 @@ BitmapEx BitmapShadowFilter::execute(BitmapEx const& rBitmapEx) const
     if (!pWriteAccess)
         return rBitmapEx;
 
-    for (sal_Int32 y(0); y < sal_Int32(pWriteAccess->Height()); y++)
-    {
-        Scanline pScanline = pWriteAccess->GetScanline(y);
-
-        for (sal_Int32 x(0); x < sal_Int32(pWriteAccess->Width()); x++)
-        {
-            const BitmapColor aColor = pWriteAccess->GetColor(y, x);
-            sal_uInt16 nLuminance(static_cast<sal_uInt16>(aColor.GetLuminance()) + 1);
-            const BitmapColor aDestColor(
-                static_cast<sal_uInt8>(
-                    (nLuminance * static_cast<sal_uInt16>(maShadowColor.GetRed())) >> 8),
-                static_cast<sal_uInt8>(
-                    (nLuminance * static_cast<sal_uInt16>(maShadowColor.GetGreen())) >> 8),
-                static_cast<sal_uInt8>(
-                    (nLuminance * static_cast<sal_uInt16>(maShadowColor.GetBlue())) >> 8));
-
-            pWriteAccess->SetPixelOnData(pScanline, x, aDestColor);
-        }
-    }
+    vcl::bitmap::parallelForRows(
+        pWriteAccess->Height(), pWriteAccess->Width(), [&](sal_Int32 nStartY, sal_Int32 nEndY) {
+            for (sal_Int32 y(nStartY); y <= nEndY; y++)
+            {
+                Scanline pScanline = pWriteAccess->GetScanline(y);
+
+                for (sal_Int32 x(0); x < sal_Int32(pWriteAccess->Width()); x++)
+                {
+                    const BitmapColor aColor = pWriteAccess->GetColor(y, x);
+                    sal_uInt16 nLuminance(static_cast<sal_uInt16>(aColor.GetLuminance()) + 1);
+                    const BitmapColor aDestColor(
+                        static_cast<sal_uInt8>(
+                            (nLuminance * static_cast<sal_uInt16>(maShadowColor.GetRed())) >> 8),
+                        static_cast<sal_uInt8>(
+                            (nLuminance * static_cast<sal_uInt16>(maShadowColor.GetGreen())) >> 8),
+                        static_cast<sal_uInt8>(
+                            (nLuminance * static_cast<sal_uInt16>(maShadowColor.GetBlue())) >> 8));
+
+                    pWriteAccess->SetPixelOnData(pScanline, x, aDestColor);
+                }
+            }
+        });
 
     return aBitmapEx;
 }
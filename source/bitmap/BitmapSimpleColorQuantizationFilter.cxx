@@ -13,7 +13,7 @@
 #include <vcl/BitmapSimpleColorQuantizationFilter.hxx>
 
 #include <bitmap/BitmapWriteAccess.hxx>
-#include <bitmap/Octree.hxx>
+#include <bitmap/WuQuantizer.hxx>
 
 BitmapEx BitmapSimpleColorQuantizationFilter::execute(BitmapEx const& aBitmapEx) const
 {
@@ -39,48 +39,15 @@ BitmapEx BitmapSimpleColorQuantizationFilter::execute(BitmapEx const& aBitmapEx)
 
         if (pRAcc)
         {
-            Octree aOct(*pRAcc, nColorCount);
-            const BitmapPalette& rPal = aOct.GetPalette();
+            WuQuantizer aQuantizer(*pRAcc, nColorCount);
+            const BitmapPalette& rPal = aQuantizer.GetPalette();
 
             aNewBmp = Bitmap(aBitmap.GetSizePixel(), ePixelFormat, &rPal);
             BitmapScopedWriteAccess pWAcc(aNewBmp);
 
             if (pWAcc)
             {
-                const sal_Int32 nWidth = pRAcc->Width();
-                const sal_Int32 nHeight = pRAcc->Height();
-
-                if (pRAcc->HasPalette())
-                {
-                    for (sal_Int32 nY = 0; nY < nHeight; nY++)
-                    {
-                        Scanline pScanline = pWAcc->GetScanline(nY);
-                        Scanline pScanlineRead = pRAcc->GetScanline(nY);
-                        for (sal_Int32 nX = 0; nX < nWidth; nX++)
-                        {
-                            auto c = pRAcc->GetPaletteColor(
-                                pRAcc->GetIndexFromData(pScanlineRead, nX));
-                            pWAcc->SetPixelOnData(
-                                pScanline, nX,
-                                BitmapColor(static_cast<sal_uInt8>(aOct.GetBestPaletteIndex(c))));
-                        }
-                    }
-                }
-                else
-                {
-                    for (sal_Int32 nY = 0; nY < nHeight; nY++)
-                    {
-                        Scanline pScanline = pWAcc->GetScanline(nY);
-                        Scanline pScanlineRead = pRAcc->GetScanline(nY);
-                        for (sal_Int32 nX = 0; nX < nWidth; nX++)
-                        {
-                            auto c = pRAcc->GetPixelFromData(pScanlineRead, nX);
-                            pWAcc->SetPixelOnData(
-                                pScanline, nX,
-                                BitmapColor(static_cast<sal_uInt8>(aOct.GetBestPaletteIndex(c))));
-                        }
-                    }
-                }
+                aQuantizer.Map(*pRAcc, *pWAcc, QuantizationDither::None);
 
                 pWAcc.reset();
                 bRet = true;
@@ -12,6 +12,7 @@
 #include <vcl/bitmapex.hxx>
 #include <vcl/BitmapSolarizeFilter.hxx>
 
+#include <bitmap/BitmapParallel.hxx>
 #include <bitmap/BitmapWriteAccess.hxx>
 
 BitmapEx BitmapSolarizeFilter::execute(BitmapEx const& rBitmapEx) const
@@ -38,24 +39,27 @@ BitmapEx BitmapSolarizeFilter::execute(BitmapEx const& rBitmapEx) const
         }
         else
         {
-            BitmapColor aCol;
             const sal_Int32 nWidth = pWriteAcc->Width();
             const sal_Int32 nHeight = pWriteAcc->Height();
 
-            for (sal_Int32 nY = 0; nY < nHeight; nY++)
-            {
-                Scanline pScanline = pWriteAcc->GetScanline(nY);
-                for (sal_Int32 nX = 0; nX < nWidth; nX++)
-                {
-                    aCol = pWriteAcc->GetPixelFromData(pScanline, nX);
-
-                    if (aCol.GetLuminance() >= mcSolarGreyThreshold)
+            vcl::bitmap::parallelForRows(
+                nHeight, nWidth, [&](sal_Int32 nStartY, sal_Int32 nEndY) {
+                    BitmapColor aCol;
+                    for (sal_Int32 nY = nStartY; nY <= nEndY; nY++)
                     {
-                        aCol.Invert();
-                        pWriteAcc->SetPixelOnData(pScanline, nX, aCol);
+                        Scanline pScanline = pWriteAcc->GetScanline(nY);
+                        for (sal_Int32 nX = 0; nX < nWidth; nX++)
+                        {
+                            aCol = pWriteAcc->GetPixelFromData(pScanline, nX);
+
+                            if (aCol.GetLuminance() >= mcSolarGreyThreshold)
+                            {
+                                aCol.Invert();
+                                pWriteAcc->SetPixelOnData(pScanline, nX, aCol);
+                            }
+                        }
                     }
-                }
-            }
+                });
         }
 
         pWriteAcc.reset();
@@ -11,6 +11,7 @@
 #include <sal/config.h>
 
 #include <array>
+#include <cstring>
 #include <utility>
 
 #include <tools/helpers.hxx>
@@ -39,7 +40,11 @@
 #include <comphelper/diagnose_ex.hxx>
 #include <tools/fract.hxx>
 #include <tools/stream.hxx>
+#include <bitmap/BitmapFromBuffer.hxx>
 #include <bitmap/BitmapWriteAccess.hxx>
+#include <salbmp.hxx>
+#include <salinst.hxx>
+#include <svdata.hxx>
 
 using namespace css;
 
@@ -200,65 +205,142 @@ BitmapEx CreateFromData(sal_uInt8 const *pData, sal_Int32 nWidth, sal_Int32 nHei
         return BitmapEx(aBmp);
 }
 
-/** Copy block of image data into the bitmap.
-    Assumes that the Bitmap has been constructed with the desired size.
+/** Make a BitmapEx from the RGB or RGBA pixels of rawBitmap.
+    24 bit pixels are handed to CreateFromBuffer(), which can keep them without copying if the
+    width makes the rows 4 byte aligned; for 32 bit ones the colors are copied into the bitmap
+    and the alpha into its AlphaMask.
 */
 BitmapEx CreateFromData( RawBitmap&& rawBitmap )
 {
     auto nBitCount = rawBitmap.GetBitCount();
     assert( nBitCount == 24 || nBitCount == 32);
 
-    auto ePixelFormat = vcl::PixelFormat::INVALID;
-
     if (nBitCount == 24)
-        ePixelFormat = vcl::PixelFormat::N24_BPP;
-    else if (nBitCount == 32)
-        ePixelFormat = vcl::PixelFormat::N32_BPP;
-
-    assert(ePixelFormat != vcl::PixelFormat::INVALID);
+    {
+        // the backend may be able to keep the pixels as they are
+        const Size aSize(rawBitmap.maSize);
+        return CreateFromBuffer(rawBitmap.mpData.release(), aSize.Width(), aSize.Height(),
+                                aSize.Width() * 3, ScanlineFormat::N24BitTcRgb,
+                                [](sal_uInt8* pData) { delete[] pData; });
+    }
 
-    Bitmap aBmp(rawBitmap.maSize, ePixelFormat);
+    Bitmap aBmp(rawBitmap.maSize, vcl::PixelFormat::N32_BPP);
 
     BitmapScopedWriteAccess pWrite(aBmp);
     assert(pWrite.get());
     if( !pWrite )
         return BitmapEx();
-    std::unique_ptr<AlphaMask> pAlphaMask;
-    AlphaScopedWriteAccess xMaskAcc;
-    if (nBitCount == 32)
-    {
-        pAlphaMask.reset( new AlphaMask( rawBitmap.maSize ) );
-        xMaskAcc = AlphaScopedWriteAccess(*pAlphaMask);
-    }
+    AlphaMask aAlphaMask(rawBitmap.maSize);
+    AlphaScopedWriteAccess xMaskAcc(aAlphaMask);
 
     auto nHeight = rawBitmap.maSize.getHeight();
     auto nWidth = rawBitmap.maSize.getWidth();
-    auto nStride = nWidth * nBitCount / 8;
+    auto nStride = nWidth * 4;
     for( tools::Long y = 0; y < nHeight; ++y )
     {
         sal_uInt8 const *p = rawBitmap.mpData.get() + (y * nStride);
         Scanline pScanline = pWrite->GetScanline(y);
+        Scanline pMaskScanLine = xMaskAcc->GetScanline(y);
         for (tools::Long x = 0; x < nWidth; ++x)
         {
-            BitmapColor col(p[0], p[1], p[2]);
-            pWrite->SetPixelOnData(pScanline, x, col);
-            p += nBitCount/8;
+            pWrite->SetPixelOnData(pScanline, x, BitmapColor(p[0], p[1], p[2]));
+            xMaskAcc->SetPixelOnData(pMaskScanLine, x, BitmapColor(255 - p[3]));
+            p += 4;
         }
-        if (nBitCount == 32)
+    }
+    pWrite.reset();
+    xMaskAcc.reset();
+    return BitmapEx(aBmp, aAlphaMask);
+}
+
+namespace
+{
+Bitmap copyFromBuffer(const sal_uInt8* pData, sal_Int32 nWidth, sal_Int32 nHeight,
+                      sal_Int32 nStride, ScanlineFormat eFormat)
+{
+    const bool bGrey = eFormat == ScanlineFormat::N8BitPal;
+    Bitmap aBitmap(Size(nWidth, nHeight),
+                   bGrey ? vcl::PixelFormat::N8_BPP : vcl::PixelFormat::N24_BPP,
+                   bGrey ? &Bitmap::GetGreyPalette(256) : nullptr);
+    BitmapScopedWriteAccess pWrite(aBitmap);
+    if (!pWrite)
+        return Bitmap();
+
+    const sal_uInt32 nRowBytes = nWidth * (bGrey ? 1 : 3);
+    const bool bSameFormat = pWrite->GetScanlineFormat() == eFormat;
+    const int nRed = eFormat == ScanlineFormat::N24BitTcBgr ? 2 : 0;
+    for (tools::Long y = 0; y < nHeight; ++y)
+    {
+        const sal_uInt8* p = pData + y * nStride;
+        Scanline pScanline = pWrite->GetScanline(y);
+        if (bSameFormat)
+            memcpy(pScanline, p, nRowBytes);
+        else if (bGrey)
         {
-            p = rawBitmap.mpData.get() + (y * nStride) + 3;
-            Scanline pMaskScanLine = xMaskAcc->GetScanline(y);
             for (tools::Long x = 0; x < nWidth; ++x)
-            {
-                xMaskAcc->SetPixelOnData(pMaskScanLine, x, BitmapColor(255 - *p));
-                p += 4;
-            }
+                pWrite->SetPixelOnData(pScanline, x, BitmapColor(p[x]));
+        }
+        else
+        {
+            for (tools::Long x = 0; x < nWidth; ++x, p += 3)
+                pWrite->SetPixelOnData(pScanline, x, BitmapColor(p[nRed], p[1], p[2 - nRed]));
         }
     }
-    if (nBitCount == 32)
-        return BitmapEx(aBmp, *pAlphaMask);
+    return aBitmap;
+}
+}
+
+BitmapEx CreateFromBuffer(sal_uInt8* pData, sal_Int32 nWidth, sal_Int32 nHeight,
+                          sal_Int32 nStride, ScanlineFormat eFormat,
+                          const BufferReleaseFunction& rRelease)
+{
+    vcl::PixelFormat ePixelFormat = vcl::PixelFormat::INVALID;
+    switch (eFormat)
+    {
+        case ScanlineFormat::N8BitPal:
+            ePixelFormat = vcl::PixelFormat::N8_BPP;
+            break;
+        case ScanlineFormat::N24BitTcBgr:
+        case ScanlineFormat::N24BitTcRgb:
+            ePixelFormat = vcl::PixelFormat::N24_BPP;
+            break;
+        case ScanlineFormat::N32BitTcBgra:
+        case ScanlineFormat::N32BitTcRgba:
+            ePixelFormat = vcl::PixelFormat::N32_BPP;
+            break;
+        default:
+            break;
+    }
+    assert(ePixelFormat != vcl::PixelFormat::INVALID && "unsupported format");
+    assert(nStride >= nWidth * vcl::pixelFormatBitCount(ePixelFormat) / 8);
+    if (ePixelFormat == vcl::PixelFormat::INVALID || !pData || nWidth <= 0 || nHeight <= 0)
+    {
+        rRelease(pData);
+        return BitmapEx();
+    }
+
+    // backends keep their rows 4 byte aligned, so other strides can only be copied
+    const sal_Int32 nAlignedStride
+        = AlignedWidth4Bytes(nWidth * vcl::pixelFormatBitCount(ePixelFormat));
+    if (ePixelFormat != vcl::PixelFormat::N32_BPP && nStride == nAlignedStride)
+    {
+        std::shared_ptr<SalBitmap> xSalBitmap(ImplGetSVData()->mpDefInst->CreateSalBitmap());
+        const BitmapPalette& rPalette = ePixelFormat == vcl::PixelFormat::N8_BPP
+                                            ? Bitmap::GetGreyPalette(256)
+                                            : BitmapPalette();
+        if (xSalBitmap->CreateFromBuffer(Size(nWidth, nHeight), ePixelFormat, rPalette, eFormat,
+                                         pData, nStride, rRelease))
+            return BitmapEx(Bitmap(xSalBitmap));
+    }
+
+    BitmapEx aBitmapEx;
+    if (ePixelFormat == vcl::PixelFormat::N32_BPP)
+        aBitmapEx = CreateFromData(pData, nWidth, nHeight, nStride, ePixelFormat,
+                                   eFormat == ScanlineFormat::N32BitTcBgra, true);
     else
-        return BitmapEx(aBmp);
+        aBitmapEx = BitmapEx(copyFromBuffer(pData, nWidth, nHeight, nStride, eFormat));
+    rRelease(pData);
+    return aBitmapEx;
 }
 
 #if ENABLE_CAIRO_CANVAS
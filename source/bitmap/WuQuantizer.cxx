@@ -0,0 +1,520 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vcl/BitmapReadAccess.hxx>
+
+#include <bitmap/BitmapParallel.hxx>
+#include <bitmap/BitmapWriteAccess.hxx>
+#include <bitmap/Octree.hxx>
+#include <bitmap/WuQuantizer.hxx>
+
+#include <algorithm>
+#include <cstdlib>
+#include <optional>
+
+namespace
+{
+// 32 levels per channel, index 0 is left empty so that the moments need no special case
+// for the lower edge of the cube
+constexpr sal_Int32 constLevels = 33;
+constexpr sal_Int32 constShift = 3;
+
+constexpr sal_Int32 cellIndex(sal_Int32 nRed, sal_Int32 nGreen, sal_Int32 nBlue)
+{
+    return (nRed * constLevels + nGreen) * constLevels + nBlue;
+}
+
+sal_Int32 colorCell(const BitmapColor& rColor)
+{
+    return cellIndex((rColor.GetRed() >> constShift) + 1, (rColor.GetGreen() >> constShift) + 1,
+                     (rColor.GetBlue() >> constShift) + 1);
+}
+
+/// Cumulative moments: every cell holds the sums over all cells with lower or equal indices.
+struct Moments
+{
+    std::vector<sal_Int64> maWeight;
+    std::vector<sal_Int64> maRed;
+    std::vector<sal_Int64> maGreen;
+    std::vector<sal_Int64> maBlue;
+    std::vector<double> maSquares;
+
+    Moments()
+        : maWeight(constLevels * constLevels * constLevels)
+        , maRed(maWeight.size())
+        , maGreen(maWeight.size())
+        , maBlue(maWeight.size())
+        , maSquares(maWeight.size())
+    {
+    }
+};
+
+/// A box of cells, the lower bounds are exclusive and the upper ones inclusive.
+struct Box
+{
+    sal_Int32 mnRed0 = 0;
+    sal_Int32 mnRed1 = constLevels - 1;
+    sal_Int32 mnGreen0 = 0;
+    sal_Int32 mnGreen1 = constLevels - 1;
+    sal_Int32 mnBlue0 = 0;
+    sal_Int32 mnBlue1 = constLevels - 1;
+
+    sal_Int32 volume() const
+    {
+        return (mnRed1 - mnRed0) * (mnGreen1 - mnGreen0) * (mnBlue1 - mnBlue0);
+    }
+};
+
+enum class Axis
+{
+    Red,
+    Green,
+    Blue
+};
+
+template <typename T> T volume(const Box& rBox, const std::vector<T>& rMoment)
+{
+    return rMoment[cellIndex(rBox.mnRed1, rBox.mnGreen1, rBox.mnBlue1)]
+           - rMoment[cellIndex(rBox.mnRed1, rBox.mnGreen1, rBox.mnBlue0)]
+           - rMoment[cellIndex(rBox.mnRed1, rBox.mnGreen0, rBox.mnBlue1)]
+           + rMoment[cellIndex(rBox.mnRed1, rBox.mnGreen0, rBox.mnBlue0)]
+           - rMoment[cellIndex(rBox.mnRed0, rBox.mnGreen1, rBox.mnBlue1)]
+           + rMoment[cellIndex(rBox.mnRed0, rBox.mnGreen1, rBox.mnBlue0)]
+           + rMoment[cellIndex(rBox.mnRed0, rBox.mnGreen0, rBox.mnBlue1)]
+           - rMoment[cellIndex(rBox.mnRed0, rBox.mnGreen0, rBox.mnBlue0)];
+}
+
+/// The part of volume() that does not depend on the upper bound along eAxis.
+sal_Int64 bottom(const Box& rBox, Axis eAxis, const std::vector<sal_Int64>& rMoment)
+{
+    switch (eAxis)
+    {
+        case Axis::Red:
+            return -rMoment[cellIndex(rBox.mnRed0, rBox.mnGreen1, rBox.mnBlue1)]
+                   + rMoment[cellIndex(rBox.mnRed0, rBox.mnGreen1, rBox.mnBlue0)]
+                   + rMoment[cellIndex(rBox.mnRed0, rBox.mnGreen0, rBox.mnBlue1)]
+                   - rMoment[cellIndex(rBox.mnRed0, rBox.mnGreen0, rBox.mnBlue0)];
+        case Axis::Green:
+            return -rMoment[cellIndex(rBox.mnRed1, rBox.mnGreen0, rBox.mnBlue1)]
+                   + rMoment[cellIndex(rBox.mnRed1, rBox.mnGreen0, rBox.mnBlue0)]
+                   + rMoment[cellIndex(rBox.mnRed0, rBox.mnGreen0, rBox.mnBlue1)]
+                   - rMoment[cellIndex(rBox.mnRed0, rBox.mnGreen0, rBox.mnBlue0)];
+        case Axis::Blue:
+            return -rMoment[cellIndex(rBox.mnRed1, rBox.mnGreen1, rBox.mnBlue0)]
+                   + rMoment[cellIndex(rBox.mnRed1, rBox.mnGreen0, rBox.mnBlue0)]
+                   + rMoment[cellIndex(rBox.mnRed0, rBox.mnGreen1, rBox.mnBlue0)]
+                   - rMoment[cellIndex(rBox.mnRed0, rBox.mnGreen0, rBox.mnBlue0)];
+    }
+    return 0;
+}
+
+/// The rest of volume() with the upper bound along eAxis replaced by nPosition.
+sal_Int64 top(const Box& rBox, Axis eAxis, sal_Int32 nPosition,
+              const std::vector<sal_Int64>& rMoment)
+{
+    switch (eAxis)
+    {
+        case Axis::Red:
+            return rMoment[cellIndex(nPosition, rBox.mnGreen1, rBox.mnBlue1)]
+                   - rMoment[cellIndex(nPosition, rBox.mnGreen1, rBox.mnBlue0)]
+                   - rMoment[cellIndex(nPosition, rBox.mnGreen0, rBox.mnBlue1)]
+                   + rMoment[cellIndex(nPosition, rBox.mnGreen0, rBox.mnBlue0)];
+        case Axis::Green:
+            return rMoment[cellIndex(rBox.mnRed1, nPosition, rBox.mnBlue1)]
+                   - rMoment[cellIndex(rBox.mnRed1, nPosition, rBox.mnBlue0)]
+                   - rMoment[cellIndex(rBox.mnRed0, nPosition, rBox.mnBlue1)]
+                   + rMoment[cellIndex(rBox.mnRed0, nPosition, rBox.mnBlue0)];
+        case Axis::Blue:
+            return rMoment[cellIndex(rBox.mnRed1, rBox.mnGreen1, nPosition)]
+                   - rMoment[cellIndex(rBox.mnRed1, rBox.mnGreen0, nPosition)]
+                   - rMoment[cellIndex(rBox.mnRed0, rBox.mnGreen1, nPosition)]
+                   + rMoment[cellIndex(rBox.mnRed0, rBox.mnGreen0, nPosition)];
+    }
+    return 0;
+}
+
+/// The sum of the squared distances of the colors in the box from their mean, times its weight.
+double variance(const Box& rBox, const Moments& rMoments)
+{
+    const double fRed = volume(rBox, rMoments.maRed);
+    const double fGreen = volume(rBox, rMoments.maGreen);
+    const double fBlue = volume(rBox, rMoments.maBlue);
+    const double fSquares = volume(rBox, rMoments.maSquares);
+    const double fWeight = volume(rBox, rMoments.maWeight);
+    return fSquares - (fRed * fRed + fGreen * fGreen + fBlue * fBlue) / fWeight;
+}
+
+/** Finds the cut along eAxis that gives the smallest sum of the variances of both halves.
+
+    As the sum of squares of both halves is the same for every cut, that is the one with the
+    largest sum of squared color sums per weight. Returns that sum, rCut is -1 if no cut leaves
+    pixels on both sides.
+*/
+double maximize(const Box& rBox, Axis eAxis, sal_Int32 nFirst, sal_Int32 nLast, sal_Int32& rCut,
+                const Moments& rMoments, sal_Int64 nWholeRed, sal_Int64 nWholeGreen,
+                sal_Int64 nWholeBlue, sal_Int64 nWholeWeight)
+{
+    const sal_Int64 nBaseRed = bottom(rBox, eAxis, rMoments.maRed);
+    const sal_Int64 nBaseGreen = bottom(rBox, eAxis, rMoments.maGreen);
+    const sal_Int64 nBaseBlue = bottom(rBox, eAxis, rMoments.maBlue);
+    const sal_Int64 nBaseWeight = bottom(rBox, eAxis, rMoments.maWeight);
+
+    double fMax = 0.0;
+    rCut = -1;
+    for (sal_Int32 i = nFirst; i < nLast; ++i)
+    {
+        sal_Int64 nHalfRed = nBaseRed + top(rBox, eAxis, i, rMoments.maRed);
+        sal_Int64 nHalfGreen = nBaseGreen + top(rBox, eAxis, i, rMoments.maGreen);
+        sal_Int64 nHalfBlue = nBaseBlue + top(rBox, eAxis, i, rMoments.maBlue);
+        sal_Int64 nHalfWeight = nBaseWeight + top(rBox, eAxis, i, rMoments.maWeight);
+        // the box can't be cut here if either half has no pixels
+        if (nHalfWeight == 0 || nHalfWeight == nWholeWeight)
+            continue;
+
+        double fTemp = (double(nHalfRed) * nHalfRed + double(nHalfGreen) * nHalfGreen
+                        + double(nHalfBlue) * nHalfBlue)
+                       / nHalfWeight;
+
+        nHalfRed = nWholeRed - nHalfRed;
+        nHalfGreen = nWholeGreen - nHalfGreen;
+        nHalfBlue = nWholeBlue - nHalfBlue;
+        nHalfWeight = nWholeWeight - nHalfWeight;
+        fTemp += (double(nHalfRed) * nHalfRed + double(nHalfGreen) * nHalfGreen
+                  + double(nHalfBlue) * nHalfBlue)
+                 / nHalfWeight;
+
+        if (fTemp > fMax)
+        {
+            fMax = fTemp;
+            rCut = i;
+        }
+    }
+    return fMax;
+}
+
+/// Cuts rBox in two along its best axis, leaving one half in rBox and the other in rNew.
+bool cut(Box& rBox, Box& rNew, const Moments& rMoments)
+{
+    const sal_Int64 nWholeRed = volume(rBox, rMoments.maRed);
+    const sal_Int64 nWholeGreen = volume(rBox, rMoments.maGreen);
+    const sal_Int64 nWholeBlue = volume(rBox, rMoments.maBlue);
+    const sal_Int64 nWholeWeight = volume(rBox, rMoments.maWeight);
+
+    sal_Int32 nCutRed, nCutGreen, nCutBlue;
+    const double fMaxRed
+        = maximize(rBox, Axis::Red, rBox.mnRed0 + 1, rBox.mnRed1, nCutRed, rMoments, nWholeRed,
+                   nWholeGreen, nWholeBlue, nWholeWeight);
+    const double fMaxGreen
+        = maximize(rBox, Axis::Green, rBox.mnGreen0 + 1, rBox.mnGreen1, nCutGreen, rMoments,
+                   nWholeRed, nWholeGreen, nWholeBlue, nWholeWeight);
+    const double fMaxBlue
+        = maximize(rBox, Axis::Blue, rBox.mnBlue0 + 1, rBox.mnBlue1, nCutBlue, rMoments,
+                   nWholeRed, nWholeGreen, nWholeBlue, nWholeWeight);
+
+    rNew = rBox;
+    if (fMaxRed >= fMaxGreen && fMaxRed >= fMaxBlue)
+    {
+        if (nCutRed < 0)
+            return false;
+        rBox.mnRed1 = rNew.mnRed0 = nCutRed;
+    }
+    else if (fMaxGreen >= fMaxRed && fMaxGreen >= fMaxBlue)
+    {
+        rBox.mnGreen1 = rNew.mnGreen0 = nCutGreen;
+    }
+    else
+    {
+        rBox.mnBlue1 = rNew.mnBlue0 = nCutBlue;
+    }
+    return true;
+}
+
+// 8x8 Bayer matrix, the thresholds 0 .. 63 spread as evenly as possible
+constexpr sal_uInt8 constBayer[8][8] = { { 0, 32, 8, 40, 2, 34, 10, 42 },
+                                         { 48, 16, 56, 24, 50, 18, 58, 26 },
+                                         { 12, 44, 4, 36, 14, 46, 6, 38 },
+                                         { 60, 28, 52, 20, 62, 30, 54, 22 },
+                                         { 3, 35, 11, 43, 1, 33, 9, 41 },
+                                         { 51, 19, 59, 27, 49, 17, 57, 25 },
+                                         { 15, 47, 7, 39, 13, 45, 5, 37 },
+                                         { 63, 31, 55, 23, 61, 29, 53, 21 } };
+
+BitmapColor readColor(const BitmapReadAccess& rReadAcc, ConstScanline pScanline, sal_Int32 nX)
+{
+    if (rReadAcc.HasPalette())
+        return rReadAcc.GetPaletteColor(rReadAcc.GetIndexFromData(pScanline, nX));
+    return rReadAcc.GetPixelFromData(pScanline, nX);
+}
+
+} // end anonymous namespace
+
+WuQuantizer::WuQuantizer(const BitmapReadAccess& rReadAcc, sal_uInt16 nColors)
+    : maTags(constLevels * constLevels * constLevels, 0)
+{
+    nColors = std::clamp<sal_uInt16>(nColors, 1, 256);
+
+    const sal_Int32 nWidth = rReadAcc.Width();
+    const sal_Int32 nHeight = rReadAcc.Height();
+    Moments aMoments;
+
+    // count the colors, one palette lookup per palette entry is enough
+    std::vector<sal_Int64> aPaletteCounts;
+    if (rReadAcc.HasPalette())
+        aPaletteCounts.resize(rReadAcc.GetPaletteEntryCount());
+
+    for (sal_Int32 nY = 0; nY < nHeight; nY++)
+    {
+        Scanline pScanline = rReadAcc.GetScanline(nY);
+        if (rReadAcc.HasPalette())
+        {
+            for (sal_Int32 nX = 0; nX < nWidth; nX++)
+            {
+                const sal_uInt8 nIndex = rReadAcc.GetIndexFromData(pScanline, nX);
+                if (nIndex < aPaletteCounts.size())
+                    aPaletteCounts[nIndex]++;
+            }
+        }
+        else
+        {
+            for (sal_Int32 nX = 0; nX < nWidth; nX++)
+            {
+                const BitmapColor aColor = rReadAcc.GetPixelFromData(pScanline, nX);
+                const sal_Int32 nCell = colorCell(aColor);
+                aMoments.maWeight[nCell]++;
+                aMoments.maRed[nCell] += aColor.GetRed();
+                aMoments.maGreen[nCell] += aColor.GetGreen();
+                aMoments.maBlue[nCell] += aColor.GetBlue();
+                aMoments.maSquares[nCell] += double(aColor.GetRed()) * aColor.GetRed()
+                                             + double(aColor.GetGreen()) * aColor.GetGreen()
+                                             + double(aColor.GetBlue()) * aColor.GetBlue();
+            }
+        }
+    }
+
+    for (size_t nIndex = 0; nIndex < aPaletteCounts.size(); nIndex++)
+    {
+        const sal_Int64 nCount = aPaletteCounts[nIndex];
+        if (!nCount)
+            continue;
+        const BitmapColor& rColor = rReadAcc.GetPaletteColor(nIndex);
+        const sal_Int32 nCell = colorCell(rColor);
+        aMoments.maWeight[nCell] += nCount;
+        aMoments.maRed[nCell] += nCount * rColor.GetRed();
+        aMoments.maGreen[nCell] += nCount * rColor.GetGreen();
+        aMoments.maBlue[nCell] += nCount * rColor.GetBlue();
+        aMoments.maSquares[nCell] += nCount
+                                     * (double(rColor.GetRed()) * rColor.GetRed()
+                                        + double(rColor.GetGreen()) * rColor.GetGreen()
+                                        + double(rColor.GetBlue()) * rColor.GetBlue());
+    }
+
+    // make the moments cumulative
+    for (sal_Int32 nRed = 1; nRed < constLevels; nRed++)
+    {
+        sal_Int64 aAreaWeight[constLevels] = {};
+        sal_Int64 aAreaRed[constLevels] = {};
+        sal_Int64 aAreaGreen[constLevels] = {};
+        sal_Int64 aAreaBlue[constLevels] = {};
+        double aAreaSquares[constLevels] = {};
+
+        for (sal_Int32 nGreen = 1; nGreen < constLevels; nGreen++)
+        {
+            sal_Int64 nLineWeight = 0, nLineRed = 0, nLineGreen = 0, nLineBlue = 0;
+            double fLineSquares = 0.0;
+            for (sal_Int32 nBlue = 1; nBlue < constLevels; nBlue++)
+            {
+                const sal_Int32 nCell = cellIndex(nRed, nGreen, nBlue);
+                const sal_Int32 nPrevious = cellIndex(nRed - 1, nGreen, nBlue);
+
+                nLineWeight += aMoments.maWeight[nCell];
+                nLineRed += aMoments.maRed[nCell];
+                nLineGreen += aMoments.maGreen[nCell];
+                nLineBlue += aMoments.maBlue[nCell];
+                fLineSquares += aMoments.maSquares[nCell];
+
+                aAreaWeight[nBlue] += nLineWeight;
+                aAreaRed[nBlue] += nLineRed;
+                aAreaGreen[nBlue] += nLineGreen;
+                aAreaBlue[nBlue] += nLineBlue;
+                aAreaSquares[nBlue] += fLineSquares;
+
+                aMoments.maWeight[nCell] = aMoments.maWeight[nPrevious] + aAreaWeight[nBlue];
+                aMoments.maRed[nCell] = aMoments.maRed[nPrevious] + aAreaRed[nBlue];
+                aMoments.maGreen[nCell] = aMoments.maGreen[nPrevious] + aAreaGreen[nBlue];
+                aMoments.maBlue[nCell] = aMoments.maBlue[nPrevious] + aAreaBlue[nBlue];
+                aMoments.maSquares[nCell] = aMoments.maSquares[nPrevious] + aAreaSquares[nBlue];
+            }
+        }
+    }
+
+    if (aMoments.maWeight[cellIndex(constLevels - 1, constLevels - 1, constLevels - 1)] == 0)
+        return;
+
+    // cut the box with the largest variance until there are enough boxes
+    std::vector<Box> aBoxes(nColors);
+    std::vector<double> aVariances(nColors, 0.0);
+    sal_uInt16 nBoxes = 1;
+    sal_uInt16 nNext = 0;
+    aVariances[0] = aBoxes[0].volume() > 1 ? variance(aBoxes[0], aMoments) : 0.0;
+    while (nBoxes < nColors)
+    {
+        if (aVariances[nNext] <= 0.0)
+            break;
+
+        if (cut(aBoxes[nNext], aBoxes[nBoxes], aMoments))
+        {
+            aVariances[nNext]
+                = aBoxes[nNext].volume() > 1 ? variance(aBoxes[nNext], aMoments) : 0.0;
+            aVariances[nBoxes]
+                = aBoxes[nBoxes].volume() > 1 ? variance(aBoxes[nBoxes], aMoments) : 0.0;
+            nBoxes++;
+        }
+        else
+            aVariances[nNext] = 0.0;
+
+        nNext = std::max_element(aVariances.begin(), aVariances.begin() + nBoxes)
+                - aVariances.begin();
+    }
+
+    // the boxes without pixels only come from cutting empty space and get no palette entry
+    maPalette.SetEntryCount(nBoxes);
+    sal_uInt16 nEntries = 0;
+    for (sal_uInt16 nBox = 0; nBox < nBoxes; nBox++)
+    {
+        const Box& rBox = aBoxes[nBox];
+        const sal_Int64 nWeight = volume(rBox, aMoments.maWeight);
+        if (!nWeight)
+            continue;
+
+        auto mean = [nWeight](sal_Int64 nSum) {
+            return static_cast<sal_uInt8>(std::clamp<sal_Int64>(
+                (nSum + nWeight / 2) / nWeight, 0, 255));
+        };
+        maPalette[nEntries] = BitmapColor(mean(volume(rBox, aMoments.maRed)),
+                                          mean(volume(rBox, aMoments.maGreen)),
+                                          mean(volume(rBox, aMoments.maBlue)));
+
+        for (sal_Int32 nRed = rBox.mnRed0 + 1; nRed <= rBox.mnRed1; nRed++)
+            for (sal_Int32 nGreen = rBox.mnGreen0 + 1; nGreen <= rBox.mnGreen1; nGreen++)
+                for (sal_Int32 nBlue = rBox.mnBlue0 + 1; nBlue <= rBox.mnBlue1; nBlue++)
+                    maTags[cellIndex(nRed, nGreen, nBlue)] = nEntries;
+        nEntries++;
+    }
+    maPalette.SetEntryCount(nEntries);
+}
+
+sal_uInt16 WuQuantizer::GetBestPaletteIndex(const BitmapColor& rColor) const
+{
+    return maTags[colorCell(rColor)];
+}
+
+void WuQuantizer::Map(const BitmapReadAccess& rReadAcc, BitmapWriteAccess& rWriteAcc,
+                      QuantizationDither eDither) const
+{
+    const sal_Int32 nWidth = rWriteAcc.Width();
+    const sal_Int32 nHeight = rWriteAcc.Height();
+
+    // Dithered colors also fall into histogram cells that the bitmap doesn't use, whose box
+    // may be far from them, so look up the nearest palette entry instead.
+    std::optional<InverseColorMap> oColorMap;
+    if (eDither != QuantizationDither::None)
+        oColorMap.emplace(maPalette);
+    auto bestIndex = [&](const BitmapColor& rColor) -> sal_uInt16 {
+        return oColorMap ? oColorMap->GetBestPaletteIndex(rColor) : GetBestPaletteIndex(rColor);
+    };
+
+    if (eDither == QuantizationDither::FloydSteinberg)
+    {
+        // the errors of the current and the next row, with a pixel of margin on both sides
+        std::vector<sal_Int32> aErrors1((nWidth + 2) * 3, 0);
+        std::vector<sal_Int32> aErrors2((nWidth + 2) * 3, 0);
+        for (sal_Int32 nY = 0; nY < nHeight; nY++)
+        {
+            ConstScanline pScanlineRead = rReadAcc.GetScanline(nY);
+            Scanline pScanline = rWriteAcc.GetScanline(nY);
+            std::fill(aErrors2.begin(), aErrors2.end(), 0);
+            for (sal_Int32 nX = 0; nX < nWidth; nX++)
+            {
+                const BitmapColor aColor = readColor(rReadAcc, pScanlineRead, nX);
+                sal_Int32* pError = aErrors1.data() + (nX + 1) * 3;
+                sal_Int32* pBelow = aErrors2.data() + (nX + 1) * 3;
+                const sal_Int32 aWanted[3]
+                    = { std::clamp<sal_Int32>(aColor.GetRed() + pError[0] / 16, 0, 255),
+                        std::clamp<sal_Int32>(aColor.GetGreen() + pError[1] / 16, 0, 255),
+                        std::clamp<sal_Int32>(aColor.GetBlue() + pError[2] / 16, 0, 255) };
+                const sal_uInt16 nIndex
+                    = bestIndex(BitmapColor(aWanted[0], aWanted[1], aWanted[2]));
+                rWriteAcc.SetPixelOnData(pScanline, nX, BitmapColor(sal_uInt8(nIndex)));
+
+                const BitmapColor& rGot = maPalette[nIndex];
+                const sal_Int32 aError[3] = { aWanted[0] - rGot.GetRed(),
+                                              aWanted[1] - rGot.GetGreen(),
+                                              aWanted[2] - rGot.GetBlue() };
+                for (int i = 0; i < 3; i++)
+                {
+                    pError[3 + i] += aError[i] * 7;
+                    pBelow[-3 + i] += aError[i] * 3;
+                    pBelow[i] += aError[i] * 5;
+                    pBelow[3 + i] += aError[i];
+                }
+            }
+            std::swap(aErrors1, aErrors2);
+        }
+        return;
+    }
+
+    // the offsets have to be about as large as the steps between neighbouring palette colors
+    sal_Int32 nSpread = 0;
+    const sal_uInt16 nEntries = maPalette.GetEntryCount();
+    if (eDither == QuantizationDither::Ordered && nEntries > 1)
+    {
+        sal_Int64 nSum = 0;
+        for (sal_uInt16 i = 0; i < nEntries; i++)
+        {
+            sal_Int32 nNearest = 255;
+            for (sal_uInt16 j = 0; j < nEntries; j++)
+            {
+                if (i == j)
+                    continue;
+                const BitmapColor& rA = maPalette[i];
+                const BitmapColor& rB = maPalette[j];
+                nNearest = std::min<sal_Int32>(
+                    nNearest, std::max({ std::abs(rA.GetRed() - rB.GetRed()),
+                                         std::abs(rA.GetGreen() - rB.GetGreen()),
+                                         std::abs(rA.GetBlue() - rB.GetBlue()) }));
+            }
+            nSum += nNearest;
+        }
+        nSpread = nSum / nEntries;
+    }
+
+    vcl::bitmap::parallelForRows(nHeight, nWidth, [&](sal_Int32 nStartY, sal_Int32 nEndY) {
+        for (sal_Int32 nY = nStartY; nY <= nEndY; nY++)
+        {
+            ConstScanline pScanlineRead = rReadAcc.GetScanline(nY);
+            Scanline pScanline = rWriteAcc.GetScanline(nY);
+            for (sal_Int32 nX = 0; nX < nWidth; nX++)
+            {
+                BitmapColor aColor = readColor(rReadAcc, pScanlineRead, nX);
+                if (nSpread)
+                {
+                    const sal_Int32 nOffset
+                        = (2 * constBayer[nY & 7][nX & 7] - 63) * nSpread / 128;
+                    aColor = BitmapColor(
+                        std::clamp<sal_Int32>(aColor.GetRed() + nOffset, 0, 255),
+                        std::clamp<sal_Int32>(aColor.GetGreen() + nOffset, 0, 255),
+                        std::clamp<sal_Int32>(aColor.GetBlue() + nOffset, 0, 255));
+                }
+                rWriteAcc.SetPixelOnData(pScanline, nX, BitmapColor(sal_uInt8(bestIndex(aColor))));
+            }
+        }
+    });
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
@@ -36,20 +36,22 @@
 #endif
 #include <vcl/BitmapMonochromeFilter.hxx>
 
+#include <bitmap/BitmapFilterPipeline.hxx>
+#include <bitmap/BitmapRegionAccess.hxx>
 #include <bitmap/BitmapScaleSuperFilter.hxx>
 #include <bitmap/BitmapScaleConvolutionFilter.hxx>
 #include <bitmap/BitmapFastScaleFilter.hxx>
 #include <bitmap/BitmapInterpolateScaleFilter.hxx>
 #include <bitmap/BitmapWriteAccess.hxx>
-#include <bitmap/impoctree.hxx>
-#include <bitmap/Octree.hxx>
+#include <bitmap/WuQuantizer.hxx>
+#include <bitmap/impvect.hxx>
 
-#include "impvect.hxx"
 #include "floyd.hxx"
 
 #include <math.h>
 #include <algorithm>
 #include <memory>
+#include <optional>
 
 #ifdef DBG_UTIL
 #include <cstdlib>
@@ -423,34 +425,33 @@ bool Bitmap::Crop( const tools::Rectangle& rRectPixel )
 
     if( !aRect.IsEmpty() && aSizePix != aRect.GetSize())
     {
-        ScopedReadAccess pReadAcc(*this);
+        // only the part kept has to be read
+        std::optional<vcl::bitmap::BitmapRegionAccess> oReadAcc(std::in_place, *this, aRect);
 
-        if( pReadAcc )
+        if( *oReadAcc )
         {
             const tools::Rectangle     aNewRect( Point(), aRect.GetSize() );
-            Bitmap aNewBmp(aNewRect.GetSize(), getPixelFormat(), &pReadAcc->GetPalette());
+            Bitmap aNewBmp(aNewRect.GetSize(), getPixelFormat(), &oReadAcc->GetPalette());
             BitmapScopedWriteAccess pWriteAcc(aNewBmp);
 
             if( pWriteAcc )
             {
-                const tools::Long nOldX = aRect.Left();
-                const tools::Long nOldY = aRect.Top();
                 const tools::Long nNewWidth = aNewRect.GetWidth();
                 const tools::Long nNewHeight = aNewRect.GetHeight();
 
-                for( tools::Long nY = 0, nY2 = nOldY; nY < nNewHeight; nY++, nY2++ )
+                for( tools::Long nY = 0; nY < nNewHeight; nY++ )
                 {
                     Scanline pScanline = pWriteAcc->GetScanline(nY);
-                    Scanline pScanlineRead = pReadAcc->GetScanline(nY2);
-                    for( tools::Long nX = 0, nX2 = nOldX; nX < nNewWidth; nX++, nX2++ )
-                        pWriteAcc->SetPixelOnData( pScanline, nX, pReadAcc->GetPixelFromData( pScanlineRead, nX2 ) );
+                    Scanline pScanlineRead = oReadAcc->GetScanline(nY);
+                    for( tools::Long nX = 0; nX < nNewWidth; nX++ )
+                        pWriteAcc->SetPixelOnData( pScanline, nX, oReadAcc->GetPixelFromData( pScanlineRead, nX ) );
                 }
 
                 pWriteAcc.reset();
                 bRet = true;
             }
 
-            pReadAcc.reset();
+            oReadAcc.reset();
 
             if( bRet )
                 ReassignWithSize( aNewBmp );
@@ -1199,21 +1200,8 @@ bool Bitmap::ImplConvertDown8BPP(Color const * pExtColor)
         {
             sal_Int16 nNewBitCount = sal_Int16(vcl::PixelFormat::N8_BPP);
             const sal_uInt16 nCount = 1 << nNewBitCount;
-            const tools::Long nWidth = pWriteAcc->Width();
-            const tools::Long nWidth1 = nWidth - 1;
-            const tools::Long nHeight = pWriteAcc->Height();
-            Octree aOctree(*pReadAcc, pExtColor ? (nCount - 1) : nCount);
-            aPalette = aOctree.GetPalette();
-            InverseColorMap aColorMap(aPalette);
-            BitmapColor aColor;
-            ImpErrorQuad aErrQuad;
-            std::vector<ImpErrorQuad> aErrQuad1(nWidth);
-            std::vector<ImpErrorQuad> aErrQuad2(nWidth);
-            ImpErrorQuad* pQLine1 = aErrQuad1.data();
-            ImpErrorQuad* pQLine2 = nullptr;
-            tools::Long nYTmp = 0;
-            sal_uInt8 cIndex;
-            bool bQ1 = true;
+            WuQuantizer aQuantizer(*pReadAcc, pExtColor ? (nCount - 1) : nCount);
+            aPalette = aQuantizer.GetPalette();
 
             if (pExtColor)
             {
@@ -1230,66 +1218,7 @@ bool Bitmap::ImplConvertDown8BPP(Color const * pExtColor)
             }
 
             pWriteAcc->SetPalette(aPalette);
-
-            for (tools::Long nY = 0; nY < std::min(nHeight, tools::Long(2)); nY++, nYTmp++)
-            {
-                pQLine2 = !nY ? aErrQuad1.data() : aErrQuad2.data();
-                Scanline pScanlineRead = pReadAcc->GetScanline(nYTmp);
-                for (tools::Long nX = 0; nX < nWidth; nX++)
-                {
-                    if (pReadAcc->HasPalette())
-                        pQLine2[nX] = pReadAcc->GetPaletteColor(pReadAcc->GetIndexFromData(pScanlineRead, nX));
-                    else
-                        pQLine2[nX] = pReadAcc->GetPixelFromData(pScanlineRead, nX);
-                }
-            }
-
-            assert(pQLine2 || nHeight == 0);
-
-            for (tools::Long nY = 0; nY < nHeight; nY++, nYTmp++)
-            {
-                // first pixel in the line
-                cIndex = static_cast<sal_uInt8>(aColorMap.GetBestPaletteIndex(pQLine1[0].ImplGetColor()));
-                Scanline pScanline = pWriteAcc->GetScanline(nY);
-                pWriteAcc->SetPixelOnData(pScanline, 0, BitmapColor(cIndex));
-
-                tools::Long nX;
-                for (nX = 1; nX < nWidth1; nX++)
-                {
-                    aColor = pQLine1[nX].ImplGetColor();
-                    cIndex = static_cast<sal_uInt8>(aColorMap.GetBestPaletteIndex(aColor));
-                    aErrQuad = (ImpErrorQuad(aColor) -= pWriteAcc->GetPaletteColor(cIndex));
-                    pQLine1[++nX].ImplAddColorError7(aErrQuad);
-                    pQLine2[nX--].ImplAddColorError1(aErrQuad);
-                    pQLine2[nX--].ImplAddColorError5(aErrQuad);
-                    pQLine2[nX++].ImplAddColorError3(aErrQuad);
-                    pWriteAcc->SetPixelOnData(pScanline, nX, BitmapColor(cIndex));
-                }
-
-                // Last RowPixel
-                if (nX < nWidth)
-                {
-                    cIndex = static_cast<sal_uInt8>(aColorMap.GetBestPaletteIndex(pQLine1[nWidth1].ImplGetColor()));
-                    pWriteAcc->SetPixelOnData(pScanline, nX, BitmapColor(cIndex));
-                }
-
-                // Refill/copy row buffer
-                pQLine1 = pQLine2;
-                bQ1 = !bQ1;
-                pQLine2 = bQ1 ? aErrQuad2.data() : aErrQuad1.data();
-
-                if (nYTmp < nHeight)
-                {
-                    Scanline pScanlineRead = pReadAcc->GetScanline(nYTmp);
-                    for (nX = 0; nX < nWidth; nX++)
-                    {
-                        if (pReadAcc->HasPalette())
-                            pQLine2[nX] = pReadAcc->GetPaletteColor(pReadAcc->GetIndexFromData(pScanlineRead, nX));
-                        else
-                            pQLine2[nX] = pReadAcc->GetPixelFromData(pScanlineRead, nX);
-                    }
-                }
-            }
+            aQuantizer.Map(*pReadAcc, *pWriteAcc, QuantizationDither::FloydSteinberg);
 
             bRet = true;
         }
@@ -1574,147 +1503,18 @@ bool Bitmap::Adjust( short nLuminancePercent, short nContrastPercent,
                      short nChannelRPercent, short nChannelGPercent, short nChannelBPercent,
                      double fGamma, bool bInvert, bool msoBrightness )
 {
-    bool bRet = false;
-
     // nothing to do => return quickly
     if( !nLuminancePercent && !nContrastPercent &&
         !nChannelRPercent && !nChannelGPercent && !nChannelBPercent &&
         ( fGamma == 1.0 ) && !bInvert )
     {
-        bRet = true;
-    }
-    else
-    {
-        BitmapScopedWriteAccess pAcc(*this);
-
-        if( pAcc )
-        {
-            BitmapColor aCol;
-            const tools::Long nW = pAcc->Width();
-            const tools::Long nH = pAcc->Height();
-            std::unique_ptr<sal_uInt8[]> cMapR(new sal_uInt8[ 256 ]);
-            std::unique_ptr<sal_uInt8[]> cMapG(new sal_uInt8[ 256 ]);
-            std::unique_ptr<sal_uInt8[]> cMapB(new sal_uInt8[ 256 ]);
-            double fM, fROff, fGOff, fBOff, fOff;
-
-            // calculate slope
-            if( nContrastPercent >= 0 )
-                fM = 128.0 / ( 128.0 - 1.27 * MinMax( nContrastPercent, 0, 100 ) );
-            else
-                fM = ( 128.0 + 1.27 * MinMax( nContrastPercent, -100, 0 ) ) / 128.0;
-
-            if(!msoBrightness)
-                // total offset = luminance offset + contrast offset
-                fOff = MinMax( nLuminancePercent, -100, 100 ) * 2.55 + 128.0 - fM * 128.0;
-            else
-                fOff = MinMax( nLuminancePercent, -100, 100 ) * 2.55;
-
-            // channel offset = channel offset + total offset
-            fROff = nChannelRPercent * 2.55 + fOff;
-            fGOff = nChannelGPercent * 2.55 + fOff;
-            fBOff = nChannelBPercent * 2.55 + fOff;
-
-            // calculate gamma value
-            fGamma = ( fGamma <= 0.0 || fGamma > 10.0 ) ? 1.0 : ( 1.0 / fGamma );
-            const bool bGamma = ( fGamma != 1.0 );
-
-            // create mapping table
-            for( tools::Long nX = 0; nX < 256; nX++ )
-            {
-                if(!msoBrightness)
-                {
-                    cMapR[ nX ] = static_cast<sal_uInt8>(MinMax( FRound( nX * fM + fROff ), 0, 255 ));
-                    cMapG[ nX ] = static_cast<sal_uInt8>(MinMax( FRound( nX * fM + fGOff ), 0, 255 ));
-                    cMapB[ nX ] = static_cast<sal_uInt8>(MinMax( FRound( nX * fM + fBOff ), 0, 255 ));
-                }
-                else
-                {
-                    // LO simply uses (in a somewhat optimized form) "newcolor = (oldcolor-128)*contrast+brightness+128"
-                    // as the formula, i.e. contrast first, brightness afterwards. MSOffice, for whatever weird reason,
-                    // use neither first, but apparently it applies half of brightness before contrast and half afterwards.
-                    cMapR[ nX ] = static_cast<sal_uInt8>(MinMax( FRound( (nX+fROff/2-128) * fM + 128 + fROff/2 ), 0, 255 ));
-                    cMapG[ nX ] = static_cast<sal_uInt8>(MinMax( FRound( (nX+fGOff/2-128) * fM + 128 + fGOff/2 ), 0, 255 ));
-                    cMapB[ nX ] = static_cast<sal_uInt8>(MinMax( FRound( (nX+fBOff/2-128) * fM + 128 + fBOff/2 ), 0, 255 ));
-                }
-                if( bGamma )
-                {
-                    cMapR[ nX ] = GAMMA( cMapR[ nX ], fGamma );
-                    cMapG[ nX ] = GAMMA( cMapG[ nX ], fGamma );
-                    cMapB[ nX ] = GAMMA( cMapB[ nX ], fGamma );
-                }
-
-                if( bInvert )
-                {
-                    cMapR[ nX ] = ~cMapR[ nX ];
-                    cMapG[ nX ] = ~cMapG[ nX ];
-                    cMapB[ nX ] = ~cMapB[ nX ];
-                }
-            }
-
-            // do modifying
-            if( pAcc->HasPalette() )
-            {
-                BitmapColor aNewCol;
-
-                for( sal_uInt16 i = 0, nCount = pAcc->GetPaletteEntryCount(); i < nCount; i++ )
-                {
-                    const BitmapColor& rCol = pAcc->GetPaletteColor( i );
-                    aNewCol.SetRed( cMapR[ rCol.GetRed() ] );
-                    aNewCol.SetGreen( cMapG[ rCol.GetGreen() ] );
-                    aNewCol.SetBlue( cMapB[ rCol.GetBlue() ] );
-                    pAcc->SetPaletteColor( i, aNewCol );
-                }
-            }
-            else if( pAcc->GetScanlineFormat() == ScanlineFormat::N24BitTcBgr )
-            {
-                for( tools::Long nY = 0; nY < nH; nY++ )
-                {
-                    Scanline pScan = pAcc->GetScanline( nY );
-
-                    for( tools::Long nX = 0; nX < nW; nX++ )
-                    {
-                        *pScan = cMapB[ *pScan ]; pScan++;
-                        *pScan = cMapG[ *pScan ]; pScan++;
-                        *pScan = cMapR[ *pScan ]; pScan++;
-                    }
-                }
-            }
-            else if( pAcc->GetScanlineFormat() == ScanlineFormat::N24BitTcRgb )
-            {
-                for( tools::Long nY = 0; nY < nH; nY++ )
-                {
-                    Scanline pScan = pAcc->GetScanline( nY );
-
-                    for( tools::Long nX = 0; nX < nW; nX++ )
-                    {
-                        *pScan = cMapR[ *pScan ]; pScan++;
-                        *pScan = cMapG[ *pScan ]; pScan++;
-                        *pScan = cMapB[ *pScan ]; pScan++;
-                    }
-                }
-            }
-            else
-            {
-                for( tools::Long nY = 0; nY < nH; nY++ )
-                {
-                    Scanline pScanline = pAcc->GetScanline(nY);
-                    for( tools::Long nX = 0; nX < nW; nX++ )
-                    {
-                        aCol = pAcc->GetPixelFromData( pScanline, nX );
-                        aCol.SetRed( cMapR[ aCol.GetRed() ] );
-                        aCol.SetGreen( cMapG[ aCol.GetGreen() ] );
-                        aCol.SetBlue( cMapB[ aCol.GetBlue() ] );
-                        pAcc->SetPixelOnData( pScanline, nX, aCol );
-                    }
-                }
-            }
-
-            pAcc.reset();
-            bRet = true;
-        }
+        return true;
     }
 
-    return bRet;
+    vcl::bitmap::BitmapFilterPipeline aPipeline;
+    aPipeline.Adjust( nLuminancePercent, nContrastPercent, nChannelRPercent, nChannelGPercent,
+                      nChannelBPercent, fGamma, bInvert, msoBrightness );
+    return aPipeline.Apply( *this );
 }
 
 const basegfx::SystemDependentDataHolder* Bitmap::accessSystemDependentDataHolder() const
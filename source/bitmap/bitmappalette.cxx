@@ -30,6 +30,128 @@
 #include <svdata.hxx>
 #include <salinst.hxx>
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+namespace
+{
+/** Maps colors to the palette entries that can be nearest to them.
+
+    The RGB cube is split into 16x16x16 cells. Each cell lists, in palette order,
+    only the entries whose smallest distance to the cell is not larger than the
+    largest distance of the closest entry. Searching those candidates the same
+    way as the whole palette is searched gives exactly the same index.
+*/
+class InversePaletteMap
+{
+public:
+    explicit InversePaletteMap(const std::vector<BitmapColor>& rColors);
+
+    /// Equal colors only differ in the color error if the palette has mixed alpha values.
+    bool CanMap(const BitmapColor& rCol) const
+    {
+        return mbUniformAlpha && rCol.GetAlpha() == mnAlpha;
+    }
+
+    sal_uInt16 GetBestIndex(const std::vector<BitmapColor>& rColors,
+                            const BitmapColor& rCol) const;
+
+private:
+    static constexpr int gnCellBits = 4;
+    static constexpr int gnCells = 1 << gnCellBits;
+    static constexpr int gnCellSize = 256 >> gnCellBits;
+
+    static size_t GetCell(const BitmapColor& rCol)
+    {
+        return ((rCol.GetRed() >> (8 - gnCellBits)) << (2 * gnCellBits))
+               | ((rCol.GetGreen() >> (8 - gnCellBits)) << gnCellBits)
+               | (rCol.GetBlue() >> (8 - gnCellBits));
+    }
+
+    std::vector<sal_uInt32> maCellStart;
+    std::vector<sal_uInt16> maCandidates;
+    bool mbUniformAlpha;
+    sal_uInt8 mnAlpha;
+};
+
+InversePaletteMap::InversePaletteMap(const std::vector<BitmapColor>& rColors)
+    : maCellStart(gnCells * gnCells * gnCells + 1)
+    , mbUniformAlpha(true)
+    , mnAlpha(rColors.front().GetAlpha())
+{
+    for (const BitmapColor& rColor : rColors)
+        mbUniformAlpha &= rColor.GetAlpha() == mnAlpha;
+
+    // nearest and farthest distance of a channel value to each cell's range
+    auto aDistances = [](sal_uInt8 nValue, int nCell, int& rMin, int& rMax) {
+        const int nLow = nCell * gnCellSize;
+        const int nHigh = nLow + gnCellSize - 1;
+        rMin = nValue < nLow ? nLow - nValue : (nValue > nHigh ? nValue - nHigh : 0);
+        rMax = std::max(std::abs(nValue - nLow), std::abs(nValue - nHigh));
+    };
+
+    std::vector<int> aMinDist(rColors.size());
+    size_t nCell = 0;
+    for (int nRed = 0; nRed < gnCells; ++nRed)
+    {
+        for (int nGreen = 0; nGreen < gnCells; ++nGreen)
+        {
+            for (int nBlue = 0; nBlue < gnCells; ++nBlue, ++nCell)
+            {
+                // the color error is the sum of the channel differences, so its
+                // extremes over a cell are the sums of the per channel extremes
+                int nBestMax = std::numeric_limits<int>::max();
+                for (size_t i = 0; i < rColors.size(); ++i)
+                {
+                    int nMinR, nMaxR, nMinG, nMaxG, nMinB, nMaxB;
+                    aDistances(rColors[i].GetRed(), nRed, nMinR, nMaxR);
+                    aDistances(rColors[i].GetGreen(), nGreen, nMinG, nMaxG);
+                    aDistances(rColors[i].GetBlue(), nBlue, nMinB, nMaxB);
+                    aMinDist[i] = nMinR + nMinG + nMinB;
+                    nBestMax = std::min(nBestMax, nMaxR + nMaxG + nMaxB);
+                }
+
+                maCellStart[nCell] = maCandidates.size();
+                for (size_t i = 0; i < rColors.size(); ++i)
+                {
+                    if (aMinDist[i] <= nBestMax)
+                        maCandidates.push_back(i);
+                }
+            }
+        }
+    }
+    maCellStart[nCell] = maCandidates.size();
+}
+
+sal_uInt16 InversePaletteMap::GetBestIndex(const std::vector<BitmapColor>& rColors,
+                                           const BitmapColor& rCol) const
+{
+    const size_t nCell = GetCell(rCol);
+    sal_uInt16 nRetIndex = 0;
+    sal_uInt16 nLastErr = SAL_MAX_UINT16;
+    for (sal_uInt32 n = maCellStart[nCell]; n < maCellStart[nCell + 1]; ++n)
+    {
+        const sal_uInt16 nIndex = maCandidates[n];
+        const sal_uInt16 nActErr = rCol.GetColorError(rColors[nIndex]);
+        if (nActErr < nLastErr)
+        {
+            if (!nActErr)
+                return nIndex;
+            nLastErr = nActErr;
+            nRetIndex = nIndex;
+        }
+    }
+    return nRetIndex;
+}
+
+// building the map only pays off for larger palettes that are searched often
+constexpr size_t gnInverseMapMinEntries = 16;
+constexpr sal_uInt32 gnInverseMapMinSearches = 4096;
+}
+
 class ImplBitmapPalette
 {
 public:
@@ -46,15 +168,51 @@ public:
         : maBitmapColor(nCount)
     {
     }
-    std::vector<BitmapColor>& GetBitmapData() { return maBitmapColor; }
+    ImplBitmapPalette(const ImplBitmapPalette& rOther)
+        : maBitmapColor(rOther.maBitmapColor)
+    {
+    }
+    std::vector<BitmapColor>& GetBitmapData()
+    {
+        // the entries may get changed through the returned reference
+        if (mpInverseMap.load(std::memory_order_relaxed) || mnSearches.load(std::memory_order_relaxed))
+        {
+            mpInverseMap.store(nullptr, std::memory_order_relaxed);
+            mxInverseMap.reset();
+            mnSearches = 0;
+        }
+        return maBitmapColor;
+    }
     const std::vector<BitmapColor>& GetBitmapData() const { return maBitmapColor; }
     bool operator==(const ImplBitmapPalette& rBitmapPalette) const
     {
         return maBitmapColor == rBitmapPalette.maBitmapColor;
     }
 
+    /// The inverse map, once this palette has been searched often enough to build it.
+    const InversePaletteMap* GetInverseMap() const
+    {
+        if (const InversePaletteMap* pMap = mpInverseMap.load(std::memory_order_acquire))
+            return pMap;
+        if (maBitmapColor.size() < gnInverseMapMinEntries
+            || ++mnSearches < gnInverseMapMinSearches)
+            return nullptr;
+
+        std::scoped_lock aGuard(maInverseMapMutex);
+        if (!mxInverseMap)
+        {
+            mxInverseMap = std::make_unique<InversePaletteMap>(maBitmapColor);
+            mpInverseMap.store(mxInverseMap.get(), std::memory_order_release);
+        }
+        return mxInverseMap.get();
+    }
+
 private:
     std::vector<BitmapColor> maBitmapColor;
+    mutable std::mutex maInverseMapMutex;
+    mutable std::unique_ptr<InversePaletteMap> mxInverseMap;
+    mutable std::atomic<const InversePaletteMap*> mpInverseMap{ nullptr };
+    mutable std::atomic<sal_uInt32> mnSearches{ 0 };
 };
 
 namespace
@@ -153,6 +311,12 @@ sal_uInt16 BitmapPalette::GetBestIndex(const BitmapColor& rCol) const
 
     if (!rBitmapColor.empty())
     {
+        if (const InversePaletteMap* pMap = mpImpl->GetInverseMap())
+        {
+            if (pMap->CanMap(rCol))
+                return pMap->GetBestIndex(rBitmapColor, rCol);
+        }
+
         for (size_t j = 0; j < rBitmapColor.size(); ++j)
         {
             if (rCol == rBitmapColor[j])
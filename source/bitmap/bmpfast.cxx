@@ -21,9 +21,12 @@
 
 #include <bitmap/BitmapWriteAccess.hxx>
 #include <bitmap/bmpfast.hxx>
+#include <bitmap/bmpfastsimd.hxx>
 
 #include <sal/log.hxx>
 
+#include <vector>
+
 typedef unsigned char PIXBYTE;
 
 namespace {
@@ -33,6 +36,7 @@ class BasePixelPtr
 public:
     explicit BasePixelPtr( PIXBYTE* p = nullptr ) : mpPixel( p ) {}
     void    SetRawPtr( PIXBYTE* pRawPtr )               { mpPixel = pRawPtr; }
+    PIXBYTE* GetRawPtr() const                          { return mpPixel; }
     void    AddByteOffset( int nByteOffset )            { mpPixel += nByteOffset; }
 
 protected:
@@ -204,6 +208,17 @@ template <ScanlineFormat SRCFMT, ScanlineFormat DSTFMT>
 static void ImplConvertLine( const TrueColorPixelPtr<DSTFMT>& rDst,
     const TrueColorPixelPtr<SRCFMT>& rSrc, int nPixelCount )
 {
+    // all these conversions are byte shuffles, use the vectorized one if the CPU has it
+    if( vcl::bitmap::ShuffleLineFunction pShuffleLine = vcl::bitmap::getShuffleLineFunction() )
+    {
+        vcl::bitmap::PixelShuffle aShuffle;
+        if( vcl::bitmap::getPixelShuffle( SRCFMT, DSTFMT, aShuffle ) )
+        {
+            pShuffleLine( rDst.GetRawPtr(), rSrc.GetRawPtr(), nPixelCount, aShuffle );
+            return;
+        }
+    }
+
     TrueColorPixelPtr<DSTFMT> aDst( rDst );
     TrueColorPixelPtr<SRCFMT> aSrc( rSrc );
     while( --nPixelCount >= 0 )
@@ -586,6 +601,39 @@ static bool ImplBlendToBitmap( TrueColorPixelPtr<SRCFMT>& rSrcLine,
     }
 
     assert(rDstBuffer.mnHeight <= rSrcBuffer.mnHeight && "not sure about that?");
+
+    // 32 bit destinations are blended a whole line at once, after converting
+    // the source line into the destination format
+    vcl::bitmap::PixelShuffle aShuffle;
+    if( vcl::bitmap::getPixelShuffle( SRCFMT, DSTFMT, aShuffle ) && aShuffle.mnDstBytes == 4 )
+    {
+        const vcl::bitmap::BlendLine32Function pBlendLine = vcl::bitmap::getBlendLine32Function();
+        vcl::bitmap::ShuffleLineFunction pShuffleLine = vcl::bitmap::getShuffleLineFunction();
+        if( !pShuffleLine )
+            pShuffleLine = vcl::bitmap::shuffleLineScalar;
+
+        std::vector<PIXBYTE> aConvertedLine;
+        if( SRCFMT != DSTFMT )
+            aConvertedLine.resize( rDstBuffer.mnWidth * 4 );
+
+        for (int y = rDstBuffer.mnHeight; --y >= 0;)
+        {
+            const PIXBYTE* pSrcPixels = rSrcLine.GetRawPtr();
+            if( SRCFMT != DSTFMT )
+            {
+                pShuffleLine( aConvertedLine.data(), pSrcPixels, rDstBuffer.mnWidth, aShuffle );
+                pSrcPixels = aConvertedLine.data();
+            }
+            pBlendLine( aDstLine.GetRawPtr(), pSrcPixels, aMskLine.GetRawPtr(),
+                        rDstBuffer.mnWidth, aShuffle.mnDstAlpha );
+            aDstLine.AddByteOffset( nDstLinestep );
+            rSrcLine.AddByteOffset( nSrcLinestep );
+            aMskLine.AddByteOffset( nMskLinestep );
+        }
+
+        return true;
+    }
+
     for (int y = rDstBuffer.mnHeight; --y >= 0;)
     {
         ImplBlendLines(aDstLine, rSrcLine, aMskLine, rDstBuffer.mnWidth);
@@ -0,0 +1,157 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <tools/simdsupport.hxx>
+
+#include <bitmap/bmpfastsimd.hxx>
+#include <sal/types.h>
+
+#ifdef LO_AVX2_AVAILABLE
+
+#include <cstring>
+#include <immintrin.h>
+
+namespace vcl::bitmap
+{
+namespace
+{
+__m128i loadPixels(const sal_uInt8* pSrc, int nSrcBytes)
+{
+    if (nSrcBytes == 1)
+    {
+        sal_Int32 nFour;
+        memcpy(&nFour, pSrc, 4);
+        return _mm_cvtsi32_si128(nFour);
+    }
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+}
+
+void shuffleLineAVX2(sal_uInt8* pDst, const sal_uInt8* pSrc, int nPixelCount,
+                     const PixelShuffle& rShuffle)
+{
+    const int nSrcBytes = rShuffle.mnSrcBytes;
+    const int nDstBytes = rShuffle.mnDstBytes;
+
+    // _mm256_shuffle_epi8 works within 128 bit lanes, so each lane takes
+    // four pixels and both lanes use the same indices
+    alignas(32) sal_uInt8 aIndex[32];
+    alignas(32) sal_uInt8 aOpaque[32];
+    for (int i = 0; i < 16; ++i)
+    {
+        const int nPixel = i / nDstBytes;
+        const sal_uInt8 nSource = rShuffle.maSource[i % nDstBytes];
+        const bool bUsed = nPixel < 4;
+        aIndex[i] = aIndex[i + 16]
+            = (bUsed && nSource != ShuffleOpaque) ? nPixel * nSrcBytes + nSource : 0x80;
+        aOpaque[i] = aOpaque[i + 16] = (bUsed && nSource == ShuffleOpaque) ? 0xff : 0;
+    }
+    const __m256i aIndexVec = _mm256_load_si256(reinterpret_cast<const __m256i*>(aIndex));
+    const __m256i aOpaqueVec = _mm256_load_si256(reinterpret_cast<const __m256i*>(aOpaque));
+
+    const int nSrcStep = 4 * nSrcBytes;
+    const int nDstStep = 4 * nDstBytes;
+    // bytes touched by one iteration of eight pixels, see the 16 byte loads and stores below
+    const int nSrcNeed = nSrcStep + (nSrcBytes == 1 ? 4 : 16);
+    const int nDstNeed = nDstStep + 16;
+    while (nPixelCount * nSrcBytes >= nSrcNeed && nPixelCount * nDstBytes >= nDstNeed)
+    {
+        const __m256i aIn = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(loadPixels(pSrc, nSrcBytes)),
+            loadPixels(pSrc + nSrcStep, nSrcBytes), 1);
+        const __m256i aOut = _mm256_or_si256(_mm256_shuffle_epi8(aIn, aIndexVec), aOpaqueVec);
+        if (nDstBytes == 4)
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst), aOut);
+        else
+        {
+            // the upper four bytes of the first store get overwritten by the second one
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), _mm256_castsi256_si128(aOut));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + nDstStep),
+                             _mm256_extracti128_si256(aOut, 1));
+        }
+        pSrc += 2 * nSrcStep;
+        pDst += 2 * nDstStep;
+        nPixelCount -= 8;
+    }
+
+    shuffleLineScalar(pDst, pSrc, nPixelCount, rShuffle);
+}
+
+void blendLine32AVX2(sal_uInt8* pDst, const sal_uInt8* pSrc, const sal_uInt8* pMask,
+                     int nPixelCount, sal_uInt8 nDstAlpha)
+{
+    alignas(32) sal_uInt8 aAlphaPosBytes[32];
+    for (int i = 0; i < 32; ++i)
+        aAlphaPosBytes[i] = (i % 4 == nDstAlpha) ? 0xff : 0;
+    const __m256i aAlphaPos = _mm256_load_si256(reinterpret_cast<const __m256i*>(aAlphaPosBytes));
+    // the eight mask bytes are in both lanes, the lower lane spreads 0-3, the upper one 4-7
+    const __m256i aSpread = _mm256_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4,
+                                             4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7);
+    const __m256i aZero = _mm256_setzero_si256();
+
+    int nX = 0;
+    for (; nX + 8 <= nPixelCount; nX += 8)
+    {
+        sal_uInt64 nMaskWord;
+        memcpy(&nMaskWord, pMask + nX, 8);
+        if (nMaskWord == SAL_MAX_UINT64)
+            continue;
+
+        __m256i* pDstVec = reinterpret_cast<__m256i*>(pDst + 4 * nX);
+        const __m256i aSrc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + 4 * nX));
+        if (nMaskWord == 0)
+        {
+            _mm256_storeu_si256(pDstVec, aSrc);
+            continue;
+        }
+
+        const __m256i aDst = _mm256_loadu_si256(pDstVec);
+        const __m256i aMask = _mm256_shuffle_epi8(
+            _mm256_broadcastsi128_si256(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(pMask + nX))),
+            aSpread);
+
+        // s + (((d - s) * m) >> 8), computed as mulhi((d - s) << 1, m << 7) to stay within 16 bits
+        const __m256i aSrcLo = _mm256_unpacklo_epi8(aSrc, aZero);
+        const __m256i aSrcHi = _mm256_unpackhi_epi8(aSrc, aZero);
+        const __m256i aDiffLo
+            = _mm256_slli_epi16(_mm256_sub_epi16(_mm256_unpacklo_epi8(aDst, aZero), aSrcLo), 1);
+        const __m256i aDiffHi
+            = _mm256_slli_epi16(_mm256_sub_epi16(_mm256_unpackhi_epi8(aDst, aZero), aSrcHi), 1);
+        const __m256i aMaskLo = _mm256_slli_epi16(_mm256_unpacklo_epi8(aMask, aZero), 7);
+        const __m256i aMaskHi = _mm256_slli_epi16(_mm256_unpackhi_epi8(aMask, aZero), 7);
+        const __m256i aMixed
+            = _mm256_packus_epi16(_mm256_add_epi16(aSrcLo, _mm256_mulhi_epi16(aDiffLo, aMaskLo)),
+                                  _mm256_add_epi16(aSrcHi, _mm256_mulhi_epi16(aDiffHi, aMaskHi)));
+
+        // opaque mask keeps the whole destination pixel, a partial one its alpha byte
+        const __m256i aKeep = _mm256_or_si256(
+            _mm256_cmpeq_epi8(aMask, _mm256_set1_epi8(-1)),
+            _mm256_andnot_si256(_mm256_cmpeq_epi8(aMask, aZero), aAlphaPos));
+        _mm256_storeu_si256(pDstVec, _mm256_or_si256(_mm256_and_si256(aKeep, aDst),
+                                                     _mm256_andnot_si256(aKeep, aMixed)));
+    }
+
+    blendLine32Scalar(pDst + 4 * nX, pSrc + 4 * nX, pMask + nX, nPixelCount - nX, nDstAlpha);
+}
+
+} // end anonymous namespace
+
+ShuffleLineFunction getShuffleLineAVX2() { return shuffleLineAVX2; }
+BlendLine32Function getBlendLine32AVX2() { return blendLine32AVX2; }
+
+} // end vcl::bitmap
+
+#else
+
+vcl::bitmap::ShuffleLineFunction vcl::bitmap::getShuffleLineAVX2() { return nullptr; }
+vcl::bitmap::BlendLine32Function vcl::bitmap::getBlendLine32AVX2() { return nullptr; }
+
+#endif
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
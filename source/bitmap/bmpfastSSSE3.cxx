@@ -0,0 +1,149 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <tools/simdsupport.hxx>
+
+#include <bitmap/bmpfastsimd.hxx>
+#include <sal/types.h>
+
+#ifdef LO_SSSE3_AVAILABLE
+
+#include <cstring>
+#include <tmmintrin.h>
+
+namespace vcl::bitmap
+{
+namespace
+{
+__m128i loadPixels(const sal_uInt8* pSrc, int nSrcBytes)
+{
+    if (nSrcBytes == 1)
+    {
+        sal_Int32 nFour;
+        memcpy(&nFour, pSrc, 4);
+        return _mm_cvtsi32_si128(nFour);
+    }
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+}
+
+void shuffleLineSSSE3(sal_uInt8* pDst, const sal_uInt8* pSrc, int nPixelCount,
+                      const PixelShuffle& rShuffle)
+{
+    const int nSrcBytes = rShuffle.mnSrcBytes;
+    const int nDstBytes = rShuffle.mnDstBytes;
+
+    // four pixels per shuffle, indices with the high bit set give 0
+    alignas(16) sal_uInt8 aIndex[16];
+    alignas(16) sal_uInt8 aOpaque[16];
+    for (int i = 0; i < 16; ++i)
+    {
+        const int nPixel = i / nDstBytes;
+        const sal_uInt8 nSource = rShuffle.maSource[i % nDstBytes];
+        const bool bUsed = nPixel < 4;
+        aIndex[i] = (bUsed && nSource != ShuffleOpaque) ? nPixel * nSrcBytes + nSource : 0x80;
+        aOpaque[i] = (bUsed && nSource == ShuffleOpaque) ? 0xff : 0;
+    }
+    const __m128i aIndexVec = _mm_load_si128(reinterpret_cast<const __m128i*>(aIndex));
+    const __m128i aOpaqueVec = _mm_load_si128(reinterpret_cast<const __m128i*>(aOpaque));
+
+    // loads and stores are 16 bytes wide even for 24 bit pixels, never let
+    // them reach beyond the ends of the lines
+    const int nSrcStep = 4 * nSrcBytes;
+    const int nDstStep = 4 * nDstBytes;
+    const int nSrcNeed = nSrcBytes == 1 ? 4 : 16;
+    while (nPixelCount * nSrcBytes >= nSrcNeed && nPixelCount * nDstBytes >= 16)
+    {
+        const __m128i aIn = loadPixels(pSrc, nSrcBytes);
+        const __m128i aOut = _mm_or_si128(_mm_shuffle_epi8(aIn, aIndexVec), aOpaqueVec);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), aOut);
+        pSrc += nSrcStep;
+        pDst += nDstStep;
+        nPixelCount -= 4;
+    }
+
+    shuffleLineScalar(pDst, pSrc, nPixelCount, rShuffle);
+}
+
+// blends four pixels, aMask holds the mask value of each pixel in all of its bytes
+__m128i blendPixels(__m128i aDst, __m128i aSrc, __m128i aMask, __m128i aAlphaPos)
+{
+    const __m128i aZero = _mm_setzero_si128();
+
+    // s + (((d - s) * m) >> 8), computed as mulhi((d - s) << 1, m << 7) to stay within 16 bits
+    const __m128i aSrcLo = _mm_unpacklo_epi8(aSrc, aZero);
+    const __m128i aSrcHi = _mm_unpackhi_epi8(aSrc, aZero);
+    const __m128i aDiffLo = _mm_slli_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(aDst, aZero), aSrcLo), 1);
+    const __m128i aDiffHi = _mm_slli_epi16(_mm_sub_epi16(_mm_unpackhi_epi8(aDst, aZero), aSrcHi), 1);
+    const __m128i aMaskLo = _mm_slli_epi16(_mm_unpacklo_epi8(aMask, aZero), 7);
+    const __m128i aMaskHi = _mm_slli_epi16(_mm_unpackhi_epi8(aMask, aZero), 7);
+    const __m128i aMixed
+        = _mm_packus_epi16(_mm_add_epi16(aSrcLo, _mm_mulhi_epi16(aDiffLo, aMaskLo)),
+                           _mm_add_epi16(aSrcHi, _mm_mulhi_epi16(aDiffHi, aMaskHi)));
+
+    // opaque mask keeps the whole destination pixel, a partial one its alpha byte
+    const __m128i aKeep = _mm_or_si128(
+        _mm_cmpeq_epi8(aMask, _mm_set1_epi8(-1)),
+        _mm_andnot_si128(_mm_cmpeq_epi8(aMask, aZero), aAlphaPos));
+    return _mm_or_si128(_mm_and_si128(aKeep, aDst), _mm_andnot_si128(aKeep, aMixed));
+}
+
+void blendLine32SSSE3(sal_uInt8* pDst, const sal_uInt8* pSrc, const sal_uInt8* pMask,
+                      int nPixelCount, sal_uInt8 nDstAlpha)
+{
+    alignas(16) sal_uInt8 aAlphaPosBytes[16];
+    for (int i = 0; i < 16; ++i)
+        aAlphaPosBytes[i] = (i % 4 == nDstAlpha) ? 0xff : 0;
+    const __m128i aAlphaPos = _mm_load_si128(reinterpret_cast<const __m128i*>(aAlphaPosBytes));
+    const __m128i aSpreadLo = _mm_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3);
+    const __m128i aSpreadHi = _mm_setr_epi8(4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7);
+
+    int nX = 0;
+    for (; nX + 8 <= nPixelCount; nX += 8)
+    {
+        sal_uInt64 nMaskWord;
+        memcpy(&nMaskWord, pMask + nX, 8);
+        if (nMaskWord == SAL_MAX_UINT64)
+            continue;
+
+        __m128i* pDstVec = reinterpret_cast<__m128i*>(pDst + 4 * nX);
+        const __m128i* pSrcVec = reinterpret_cast<const __m128i*>(pSrc + 4 * nX);
+        const __m128i aSrc0 = _mm_loadu_si128(pSrcVec);
+        const __m128i aSrc1 = _mm_loadu_si128(pSrcVec + 1);
+        if (nMaskWord == 0)
+        {
+            _mm_storeu_si128(pDstVec, aSrc0);
+            _mm_storeu_si128(pDstVec + 1, aSrc1);
+            continue;
+        }
+
+        const __m128i aMask = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(pMask + nX));
+        _mm_storeu_si128(pDstVec, blendPixels(_mm_loadu_si128(pDstVec), aSrc0,
+                                              _mm_shuffle_epi8(aMask, aSpreadLo), aAlphaPos));
+        _mm_storeu_si128(pDstVec + 1, blendPixels(_mm_loadu_si128(pDstVec + 1), aSrc1,
+                                                  _mm_shuffle_epi8(aMask, aSpreadHi), aAlphaPos));
+    }
+
+    blendLine32Scalar(pDst + 4 * nX, pSrc + 4 * nX, pMask + nX, nPixelCount - nX, nDstAlpha);
+}
+
+} // end anonymous namespace
+
+ShuffleLineFunction getShuffleLineSSSE3() { return shuffleLineSSSE3; }
+BlendLine32Function getBlendLine32SSSE3() { return blendLine32SSSE3; }
+
+} // end vcl::bitmap
+
+#else
+
+vcl::bitmap::ShuffleLineFunction vcl::bitmap::getShuffleLineSSSE3() { return nullptr; }
+vcl::bitmap::BlendLine32Function vcl::bitmap::getBlendLine32SSSE3() { return nullptr; }
+
+#endif
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
@@ -0,0 +1,244 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <bitmap/bmpfastsimd.hxx>
+
+#include <tools/cpuid.hxx>
+
+#include <sal/types.h>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace vcl::bitmap
+{
+namespace
+{
+struct FormatLayout
+{
+    sal_uInt8 nBytes;
+    sal_uInt8 nRed;
+    sal_uInt8 nGreen;
+    sal_uInt8 nBlue;
+    sal_uInt8 nAlpha; // ShuffleOpaque if the format has no alpha
+};
+
+bool getFormatLayout(ScanlineFormat eFormat, FormatLayout& rLayout)
+{
+    switch (eFormat)
+    {
+        // only used for the grey palette, see TrueColorPixelPtr<N8BitPal>
+        case ScanlineFormat::N8BitPal:
+            rLayout = { 1, 0, 0, 0, ShuffleOpaque };
+            return true;
+        case ScanlineFormat::N24BitTcBgr:
+            rLayout = { 3, 2, 1, 0, ShuffleOpaque };
+            return true;
+        case ScanlineFormat::N24BitTcRgb:
+            rLayout = { 3, 0, 1, 2, ShuffleOpaque };
+            return true;
+        case ScanlineFormat::N32BitTcAbgr:
+            rLayout = { 4, 3, 2, 1, 0 };
+            return true;
+        case ScanlineFormat::N32BitTcArgb:
+            rLayout = { 4, 1, 2, 3, 0 };
+            return true;
+        case ScanlineFormat::N32BitTcBgra:
+            rLayout = { 4, 2, 1, 0, 3 };
+            return true;
+        case ScanlineFormat::N32BitTcRgba:
+            rLayout = { 4, 0, 1, 2, 3 };
+            return true;
+        default:
+            return false;
+    }
+}
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+void shuffleLineNEON(sal_uInt8* pDst, const sal_uInt8* pSrc, int nPixelCount,
+                     const PixelShuffle& rShuffle)
+{
+    const int nSrcBytes = rShuffle.mnSrcBytes;
+    const int nDstBytes = rShuffle.mnDstBytes;
+
+    // four pixels per table lookup, out of range indices give 0
+    sal_uInt8 aIndex[16];
+    sal_uInt8 aOpaque[16];
+    for (int i = 0; i < 16; ++i)
+    {
+        const int nPixel = i / nDstBytes;
+        const sal_uInt8 nSource = rShuffle.maSource[i % nDstBytes];
+        const bool bUsed = nPixel < 4;
+        aIndex[i] = (bUsed && nSource != ShuffleOpaque) ? nPixel * nSrcBytes + nSource : 0xff;
+        aOpaque[i] = (bUsed && nSource == ShuffleOpaque) ? 0xff : 0;
+    }
+    const uint8x16_t aIndexVec = vld1q_u8(aIndex);
+    const uint8x16_t aOpaqueVec = vld1q_u8(aOpaque);
+
+    // never touch bytes beyond the ends of the lines
+    const int nSrcStep = 4 * nSrcBytes;
+    const int nDstStep = 4 * nDstBytes;
+    const int nSrcNeed = std::max(16, nSrcStep);
+    while (nPixelCount * nSrcBytes >= nSrcNeed && nPixelCount * nDstBytes >= 16)
+    {
+        const uint8x16_t aIn = vld1q_u8(pSrc);
+        vst1q_u8(pDst, vorrq_u8(vqtbl1q_u8(aIn, aIndexVec), aOpaqueVec));
+        pSrc += nSrcStep;
+        pDst += nDstStep;
+        nPixelCount -= 4;
+    }
+
+    shuffleLineScalar(pDst, pSrc, nPixelCount, rShuffle);
+}
+#endif
+
+} // end anonymous namespace
+
+bool getPixelShuffle(ScanlineFormat eSrc, ScanlineFormat eDst, PixelShuffle& rShuffle)
+{
+    FormatLayout aSrc;
+    FormatLayout aDst;
+    if (!getFormatLayout(eSrc, aSrc) || !getFormatLayout(eDst, aDst) || aDst.nBytes == 1)
+        return false;
+
+    rShuffle.mnSrcBytes = aSrc.nBytes;
+    rShuffle.mnDstBytes = aDst.nBytes;
+    rShuffle.maSource.fill(ShuffleOpaque);
+    rShuffle.maSource[aDst.nRed] = aSrc.nRed;
+    rShuffle.maSource[aDst.nGreen] = aSrc.nGreen;
+    rShuffle.maSource[aDst.nBlue] = aSrc.nBlue;
+    if (aDst.nAlpha != ShuffleOpaque)
+        rShuffle.maSource[aDst.nAlpha] = aSrc.nAlpha;
+    rShuffle.mnDstAlpha = aDst.nAlpha;
+    return true;
+}
+
+void shuffleLineScalar(sal_uInt8* pDst, const sal_uInt8* pSrc, int nPixelCount,
+                       const PixelShuffle& rShuffle)
+{
+    const int nSrcBytes = rShuffle.mnSrcBytes;
+    const int nDstBytes = rShuffle.mnDstBytes;
+    while (--nPixelCount >= 0)
+    {
+        for (int i = 0; i < nDstBytes; ++i)
+        {
+            const sal_uInt8 nSource = rShuffle.maSource[i];
+            pDst[i] = nSource == ShuffleOpaque ? 0xff : pSrc[nSource];
+        }
+        pSrc += nSrcBytes;
+        pDst += nDstBytes;
+    }
+}
+
+std::vector<ShuffleLineFunction> getSupportedShuffleLineFunctions()
+{
+    std::vector<ShuffleLineFunction> aFunctions;
+#if defined(__aarch64__) && defined(__ARM_NEON)
+    aFunctions.push_back(shuffleLineNEON);
+#endif
+    if (cpuid::hasSSSE3())
+    {
+        if (ShuffleLineFunction pFunction = getShuffleLineSSSE3())
+            aFunctions.push_back(pFunction);
+    }
+    if (cpuid::hasAVX2())
+    {
+        if (ShuffleLineFunction pFunction = getShuffleLineAVX2())
+            aFunctions.push_back(pFunction);
+    }
+    return aFunctions;
+}
+
+ShuffleLineFunction getShuffleLineFunction()
+{
+    static const ShuffleLineFunction pBest = []() -> ShuffleLineFunction {
+        std::vector<ShuffleLineFunction> aFunctions = getSupportedShuffleLineFunctions();
+        return aFunctions.empty() ? nullptr : aFunctions.back();
+    }();
+    return pBest;
+}
+
+void blendLine32Scalar(sal_uInt8* pDst, const sal_uInt8* pSrc, const sal_uInt8* pMask,
+                       int nPixelCount, sal_uInt8 nDstAlpha)
+{
+    int nX = 0;
+    while (nX < nPixelCount)
+    {
+        const int nRun = std::min(8, nPixelCount - nX);
+        if (nRun == 8)
+        {
+            // skip or copy runs of eight fully opaque or transparent pixels at once
+            sal_uInt64 nMaskWord;
+            memcpy(&nMaskWord, pMask + nX, 8);
+            if (nMaskWord == SAL_MAX_UINT64)
+            {
+                nX += 8;
+                continue;
+            }
+            if (nMaskWord == 0)
+            {
+                memcpy(pDst + 4 * nX, pSrc + 4 * nX, 32);
+                nX += 8;
+                continue;
+            }
+        }
+
+        for (int nEnd = nX + nRun; nX < nEnd; ++nX)
+        {
+            const unsigned nAlphaVal = pMask[nX];
+            sal_uInt8* pDstPixel = pDst + 4 * nX;
+            const sal_uInt8* pSrcPixel = pSrc + 4 * nX;
+            if (!nAlphaVal)
+                memcpy(pDstPixel, pSrcPixel, 4);
+            else if (nAlphaVal != 255)
+            {
+                for (int i = 0; i < 4; ++i)
+                {
+                    if (i == nDstAlpha)
+                        continue;
+                    const int nS = pSrcPixel[i];
+                    pDstPixel[i] = nS + (((pDstPixel[i] - nS) * int(nAlphaVal)) >> 8);
+                }
+            }
+        }
+    }
+}
+
+std::vector<BlendLine32Function> getSupportedBlendLine32Functions()
+{
+    std::vector<BlendLine32Function> aFunctions;
+    if (cpuid::hasSSSE3())
+    {
+        if (BlendLine32Function pFunction = getBlendLine32SSSE3())
+            aFunctions.push_back(pFunction);
+    }
+    if (cpuid::hasAVX2())
+    {
+        if (BlendLine32Function pFunction = getBlendLine32AVX2())
+            aFunctions.push_back(pFunction);
+    }
+    return aFunctions;
+}
+
+BlendLine32Function getBlendLine32Function()
+{
+    static const BlendLine32Function pBest = []() -> BlendLine32Function {
+        std::vector<BlendLine32Function> aFunctions = getSupportedBlendLine32Functions();
+        return aFunctions.empty() ? blendLine32Scalar : aFunctions.back();
+    }();
+    return pBest;
+}
+
+} // end vcl::bitmap
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
@@ -123,6 +123,34 @@ const sal_uInt64 vcl_crc64Table[256] = {
 #define UPDCRC64(crc, octet) \
     (vcl_crc64Table[((crc) ^ (octet)) & 0xff] ^ ((crc) >> 8))
 
+namespace {
+
+/*
+ * Tables for processing eight bytes per step ("slice-by-8"): table n
+ * gives the CRC contribution of a byte followed by n zero bytes.
+ */
+struct Crc64SliceTables
+{
+    sal_uInt64 aTable[8][256];
+
+    Crc64SliceTables()
+    {
+        for (int i = 0; i < 256; ++i)
+            aTable[0][i] = vcl_crc64Table[i];
+        for (int n = 1; n < 8; ++n)
+            for (int i = 0; i < 256; ++i)
+                aTable[n][i] = UPDCRC64(aTable[n - 1][i], 0);
+    }
+};
+
+const Crc64SliceTables& getSliceTables()
+{
+    static const Crc64SliceTables aTables;
+    return aTables;
+}
+
+}
+
 /*
  * vcl_crc64.
  */
@@ -136,6 +164,21 @@ sal_uInt64 vcl_crc64 (
         const sal_uInt8 *q = p + DatLen;
 
         Crc = ~Crc;
+        if (DatLen >= 64)
+        {
+            const sal_uInt64 (&T)[8][256] = getSliceTables().aTable;
+            for (; q - p >= 8; p += 8)
+            {
+                // little endian regardless of the platform, compilers turn this into a plain load
+                Crc ^= sal_uInt64(p[0]) | (sal_uInt64(p[1]) << 8) | (sal_uInt64(p[2]) << 16)
+                       | (sal_uInt64(p[3]) << 24) | (sal_uInt64(p[4]) << 32)
+                       | (sal_uInt64(p[5]) << 40) | (sal_uInt64(p[6]) << 48)
+                       | (sal_uInt64(p[7]) << 56);
+                Crc = T[7][Crc & 0xff] ^ T[6][(Crc >> 8) & 0xff] ^ T[5][(Crc >> 16) & 0xff]
+                      ^ T[4][(Crc >> 24) & 0xff] ^ T[3][(Crc >> 32) & 0xff]
+                      ^ T[2][(Crc >> 40) & 0xff] ^ T[1][(Crc >> 48) & 0xff] ^ T[0][Crc >> 56];
+            }
+        }
         while (p < q)
             Crc = UPDCRC64(Crc, *(p++));
         Crc = ~Crc;
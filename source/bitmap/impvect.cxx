@@ -25,12 +25,19 @@
 #include <vcl/gdimtf.hxx>
 #include <vcl/metaact.hxx>
 #include <vcl/virdev.hxx>
-#include "impvect.hxx"
+#include <comphelper/threadpool.hxx>
+#include <bitmap/BitmapParallel.hxx>
+#include <bitmap/impvect.hxx>
+#include <algorithm>
 #include <array>
 #include <memory>
+#include <vector>
 
 #define VECT_POLY_MAX 8192
 
+// bytes of the maps of the colors traced at the same time
+#define VECT_MAP_BUDGET ( sal_Int64( 256 ) << 20 )
+
 #define VECT_FREE_INDEX 0
 #define VECT_CONT_INDEX 1
 #define VECT_DONE_INDEX 2
@@ -64,11 +71,15 @@ class ImplChain;
 
 namespace ImplVectorizer
 {
-    static void ImplExpand( std::optional<ImplVectMap>& rMap, const BitmapReadAccess* pRAcc, const Color& rColor );
+    static void ImplTraceColor( const std::vector<sal_uInt8>& rIndices, tools::Long nWidth, tools::Long nHeight,
+                                sal_uInt8 nIndex, sal_uInt8 cReduce, double fTolerance, tools::PolyPolygon& rPolyPoly );
+    static void ImplExpand( std::optional<ImplVectMap>& rMap, const std::vector<sal_uInt8>& rIndices,
+                            tools::Long nWidth, tools::Long nHeight, sal_uInt8 nIndex );
     static void ImplCalculate( ImplVectMap& rMap, tools::PolyPolygon& rPolyPoly, sal_uInt8 cReduce );
     static bool ImplGetChain( ImplVectMap& rMap, const Point& rStartPt, ImplChain& rChain );
     static bool ImplIsUp( ImplVectMap const & rMap, tools::Long nY, tools::Long nX );
     static void ImplLimitPolyPoly( tools::PolyPolygon& rPolyPoly );
+    static void ImplSimplifyPoly( tools::Polygon& rPoly, double fTolerance );
 }
 
 namespace {
@@ -206,6 +217,9 @@ public:
                     ImplVectMap( tools::Long nWidth, tools::Long nHeight );
                     ~ImplVectMap();
 
+    // bytes taken by the map, 2 bits per pixel
+    static tools::Long ImplGetSize( tools::Long nWidth, tools::Long nHeight ) { return ( ( nWidth >> 2 ) + 1 ) * nHeight; }
+
     tools::Long     Width() const { return mnWidth; }
     tools::Long     Height() const { return mnHeight; }
 
@@ -221,7 +235,7 @@ public:
 }
 
 ImplVectMap::ImplVectMap( tools::Long nWidth, tools::Long nHeight ) :
-    mpBuf ( static_cast<Scanline>(rtl_allocateZeroMemory(nWidth * nHeight)) ),
+    mpBuf ( static_cast<Scanline>(rtl_allocateZeroMemory(ImplGetSize( nWidth, nHeight ))) ),
     mpScan ( static_cast<Scanline*>(std::malloc(nHeight * sizeof(Scanline))) ),
     mnWidth ( nWidth ),
     mnHeight( nHeight )
@@ -642,7 +656,7 @@ void ImplChain::ImplPostProcess( const ImplPointArray& rArr )
 namespace ImplVectorizer {
 
 bool ImplVectorize( const Bitmap& rColorBmp, GDIMetaFile& rMtf,
-                    sal_uInt8 cReduce, const Link<tools::Long,void>* pProgress )
+                    sal_uInt8 cReduce, const Link<tools::Long,void>* pProgress, double fTolerance )
 {
     bool bRet = false;
 
@@ -660,6 +674,7 @@ bool ImplVectorize( const Bitmap& rColorBmp, GDIMetaFile& rMtf,
         const sal_uInt16        nColorCount = pRAcc->GetPaletteEntryCount();
         sal_uInt16              n;
         std::array<ImplColorSet, 256> aColorSet;
+        std::vector<sal_uInt8>  aIndices( nWidth * nHeight );
 
         rMtf.Clear();
 
@@ -670,11 +685,16 @@ bool ImplVectorize( const Bitmap& rColorBmp, GDIMetaFile& rMtf,
             aColorSet[ n ].maColor = pRAcc->GetPaletteColor( n );
         }
 
+        // keep the indices, which all colors are traced from
         for( tools::Long nY = 0; nY < nHeight; nY++ )
         {
             Scanline pScanlineRead = pRAcc->GetScanline( nY );
+            sal_uInt8* pIndex = aIndices.data() + nY * nWidth;
             for( tools::Long nX = 0; nX < nWidth; nX++ )
-                aColorSet[ pRAcc->GetIndexFromData( pScanlineRead, nX ) ].mbSet = true;
+            {
+                pIndex[ nX ] = pRAcc->GetIndexFromData( pScanlineRead, nX );
+                aColorSet[ pIndex[ nX ] ].mbSet = true;
+            }
         }
 
         std::sort( aColorSet.begin(), aColorSet.end(), ImplColorSetCmpFnc );
@@ -689,39 +709,49 @@ bool ImplVectorize( const Bitmap& rColorBmp, GDIMetaFile& rMtf,
         fPercent += 10.0;
         VECT_PROGRESS( pProgress, FRound( fPercent ) );
 
+        std::vector<Color>      aFindColors( n );
+        std::vector<sal_uInt8>  aFindIndices( n );
+        std::vector<tools::PolyPolygon> aPolyPolys( n );
+
         for( sal_uInt16 i = 0; i < n; i++ )
         {
             const BitmapColor   aBmpCol( pRAcc->GetPaletteColor( aColorSet[ i ].mnIndex ) );
-            const Color         aFindColor( aBmpCol.GetRed(), aBmpCol.GetGreen(), aBmpCol.GetBlue() );
-            std::optional<ImplVectMap> oMap;
-            ImplExpand( oMap, pRAcc.get(), aFindColor );
+            aFindColors[ i ] = Color( aBmpCol.GetRed(), aBmpCol.GetGreen(), aBmpCol.GetBlue() );
+            aFindIndices[ i ] = pRAcc->GetBestMatchingColor( aFindColors[ i ] ).GetIndex();
+        }
 
-            fPercent += fPercentStep_2;
-            VECT_PROGRESS( pProgress, FRound( fPercent ) );
+        // The colors are independent of each other, so trace several of them at once, each
+        // into its own poly polygon. Their maps take about 4 bytes per pixel each, so fewer are
+        // traced at once for large bitmaps; progress is reported in between, from this thread.
+        const sal_Int64 nMapBytes = ImplVectMap::ImplGetSize( ( nWidth << 2 ) + 4, ( nHeight << 2 ) + 4 );
+        const sal_Int64 nWorkers = comphelper::ThreadPool::getSharedOptimalPool().getWorkerCount();
+        const sal_uInt16 nBatch = std::clamp<sal_Int64>( std::min( VECT_MAP_BUDGET / nMapBytes, nWorkers ),
+                                                         1, std::max<sal_uInt16>( n, 1 ) );
 
-            if( oMap )
-            {
-                tools::PolyPolygon         aPolyPoly;
-                ImplCalculate( *oMap, aPolyPoly, cReduce );
-                oMap.reset();
+        for( sal_uInt16 nFirst = 0; nFirst < n; nFirst += nBatch )
+        {
+            const sal_uInt16 nCount = std::min<sal_uInt16>( nBatch, n - nFirst );
 
-                if( aPolyPoly.Count() )
+            vcl::bitmap::parallelForRows( nCount, nMapBytes,
+                [&]( sal_Int32 nStart, sal_Int32 nEnd )
                 {
-                    ImplLimitPolyPoly( aPolyPoly );
+                    for( sal_Int32 i = nFirst + nStart; i <= nFirst + nEnd; i++ )
+                        ImplTraceColor( aIndices, nWidth, nHeight, aFindIndices[ i ], cReduce, fTolerance,
+                                        aPolyPolys[ i ] );
+                } );
 
-                    aPolyPoly.Optimize( PolyOptimizeFlags::EDGES );
+            fPercent += 2 * fPercentStep_2 * nCount;
+            VECT_PROGRESS( pProgress, FRound( fPercent ) );
+        }
 
-                    if( aPolyPoly.Count() )
-                    {
-                        rMtf.AddAction( new MetaLineColorAction( aFindColor, true ) );
-                        rMtf.AddAction( new MetaFillColorAction( aFindColor, true ) );
-                        rMtf.AddAction( new MetaPolyPolygonAction( std::move(aPolyPoly) ) );
-                    }
-                }
+        for( sal_uInt16 i = 0; i < n; i++ )
+        {
+            if( aPolyPolys[ i ].Count() )
+            {
+                rMtf.AddAction( new MetaLineColorAction( aFindColors[ i ], true ) );
+                rMtf.AddAction( new MetaFillColorAction( aFindColors[ i ], true ) );
+                rMtf.AddAction( new MetaPolyPolygonAction( std::move( aPolyPolys[ i ] ) ) );
             }
-
-            fPercent += fPercentStep_2;
-            VECT_PROGRESS( pProgress, FRound( fPercent ) );
         }
 
         if( rMtf.GetActionSize() )
@@ -745,6 +775,32 @@ bool ImplVectorize( const Bitmap& rColorBmp, GDIMetaFile& rMtf,
     return bRet;
 }
 
+void ImplTraceColor( const std::vector<sal_uInt8>& rIndices, tools::Long nWidth, tools::Long nHeight,
+                     sal_uInt8 nIndex, sal_uInt8 cReduce, double fTolerance, tools::PolyPolygon& rPolyPoly )
+{
+    std::optional<ImplVectMap> oMap;
+    ImplExpand( oMap, rIndices, nWidth, nHeight, nIndex );
+
+    if( !oMap )
+        return;
+
+    ImplCalculate( *oMap, rPolyPoly, cReduce );
+    oMap.reset();
+
+    if( !rPolyPoly.Count() )
+        return;
+
+    ImplLimitPolyPoly( rPolyPoly );
+
+    if( fTolerance > 0.0 )
+    {
+        for( sal_uInt16 i = 0, nCount = rPolyPoly.Count(); i < nCount; i++ )
+            ImplSimplifyPoly( rPolyPoly[ i ], fTolerance );
+    }
+
+    rPolyPoly.Optimize( PolyOptimizeFlags::EDGES );
+}
+
 void ImplLimitPolyPoly( tools::PolyPolygon& rPolyPoly )
 {
     if( rPolyPoly.Count() <= VECT_POLY_MAX )
@@ -777,16 +833,100 @@ void ImplLimitPolyPoly( tools::PolyPolygon& rPolyPoly )
     rPolyPoly = aNewPolyPoly;
 }
 
-void ImplExpand( std::optional<ImplVectMap>& oMap, const BitmapReadAccess* pRAcc, const Color& rColor )
+static double ImplSegmentDistance2( const Point& rPt, const Point& rA, const Point& rB )
+{
+    const double fDX = rB.X() - rA.X(), fDY = rB.Y() - rA.Y();
+    double fPX = rPt.X() - rA.X(), fPY = rPt.Y() - rA.Y();
+    const double fLength2 = fDX * fDX + fDY * fDY;
+
+    if( fLength2 > 0.0 )
+    {
+        const double fT = std::clamp( ( fPX * fDX + fPY * fDY ) / fLength2, 0.0, 1.0 );
+        fPX -= fT * fDX;
+        fPY -= fT * fDY;
+    }
+
+    return fPX * fPX + fPY * fPY;
+}
+
+// Douglas-Peucker: of the closed outline rPoly, keep only the points that are more than
+// fTolerance away from the outline through the points kept.
+void ImplSimplifyPoly( tools::Polygon& rPoly, double fTolerance )
+{
+    const sal_uInt16 nSize = rPoly.GetSize();
+
+    if( nSize < 4 )
+        return;
+
+    // split the outline at its first point and the point farthest from it
+    sal_uInt16 nFar = 0;
+    double fFar = -1.0;
+    for( sal_uInt16 i = 1; i < nSize; i++ )
+    {
+        const double fDist = ImplSegmentDistance2( rPoly[ i ], rPoly[ 0 ], rPoly[ 0 ] );
+        if( fDist > fFar )
+        {
+            fFar = fDist;
+            nFar = i;
+        }
+    }
+
+    // index nSize stands for the first point again
+    std::vector<bool> aKeep( nSize + 1, false );
+    std::vector<std::pair<sal_uInt32, sal_uInt32>> aRanges{ { 0, nFar }, { nFar, nSize } };
+    const double fTolerance2 = fTolerance * fTolerance;
+    aKeep[ 0 ] = aKeep[ nFar ] = aKeep[ nSize ] = true;
+
+    while( !aRanges.empty() )
+    {
+        const auto [ nStart, nEnd ] = aRanges.back();
+        aRanges.pop_back();
+
+        const Point& rA = rPoly[ nStart ];
+        const Point& rB = rPoly[ nEnd % nSize ];
+        double fMax = fTolerance2;
+        sal_uInt32 nMax = 0;
+
+        for( sal_uInt32 i = nStart + 1; i < nEnd; i++ )
+        {
+            const double fDist = ImplSegmentDistance2( rPoly[ i ], rA, rB );
+            if( fDist > fMax )
+            {
+                fMax = fDist;
+                nMax = i;
+            }
+        }
+
+        if( nMax )
+        {
+            aKeep[ nMax ] = true;
+            aRanges.emplace_back( nStart, nMax );
+            aRanges.emplace_back( nMax, nEnd );
+        }
+    }
+
+    const sal_uInt16 nKept = std::count( aKeep.begin(), aKeep.begin() + nSize, true );
+
+    // a polygon that collapses is better kept as it is
+    if( nKept < 3 || nKept == nSize )
+        return;
+
+    tools::Polygon aSimple( nKept );
+    for( sal_uInt16 i = 0, nPos = 0; i < nSize; i++ )
+        if( aKeep[ i ] )
+            aSimple[ nPos++ ] = rPoly[ i ];
+
+    rPoly = aSimple;
+}
+
+void ImplExpand( std::optional<ImplVectMap>& oMap, const std::vector<sal_uInt8>& rIndices,
+                 tools::Long nOldWidth, tools::Long nOldHeight, sal_uInt8 nIndex )
 {
-    if( !pRAcc || !pRAcc->Width() || !pRAcc->Height() )
+    if( !nOldWidth || !nOldHeight )
         return;
 
-    const tools::Long          nOldWidth = pRAcc->Width();
-    const tools::Long          nOldHeight = pRAcc->Height();
     const tools::Long          nNewWidth = ( nOldWidth << 2 ) + 4;
     const tools::Long          nNewHeight = ( nOldHeight << 2 ) + 4;
-    const BitmapColor   aTest( pRAcc->GetBestMatchingColor( rColor ) );
     std::unique_ptr<sal_Int32[]> pMapIn(new sal_Int32[ std::max( nOldWidth, nOldHeight ) ]);
     std::unique_ptr<sal_Int32[]> pMapOut(new sal_Int32[ std::max( nOldWidth, nOldHeight ) ]);
     tools::Long                nX, nY, nTmpX, nTmpY;
@@ -798,10 +938,10 @@ void ImplExpand( std::optional<ImplVectMap>& oMap, const BitmapReadAccess* pRAcc
 
     for( nY = 0, nTmpY = 5; nY < nOldHeight; nY++, nTmpY += 4 )
     {
-        Scanline pScanlineRead = pRAcc->GetScanline( nY );
+        const sal_uInt8* pRow = rIndices.data() + nY * nOldWidth;
         for( nX = 0; nX < nOldWidth; )
         {
-            if( pRAcc->GetPixelFromData( pScanlineRead, nX ) == aTest )
+            if( pRow[ nX ] == nIndex )
             {
                 nTmpX = pMapIn[ nX++ ];
                 nTmpY -= 3;
@@ -811,7 +951,7 @@ void ImplExpand( std::optional<ImplVectMap>& oMap, const BitmapReadAccess* pRAcc
                 oMap->Set( nTmpY++, nTmpX, VECT_CONT_INDEX );
                 oMap->Set( nTmpY, nTmpX, VECT_CONT_INDEX );
 
-                while( nX < nOldWidth && pRAcc->GetPixelFromData( pScanlineRead, nX ) == aTest )
+                while( nX < nOldWidth && pRow[ nX ] == nIndex )
                      nX++;
 
                 nTmpX = pMapOut[ nX - 1 ];
@@ -832,9 +972,10 @@ void ImplExpand( std::optional<ImplVectMap>& oMap, const BitmapReadAccess* pRAcc
 
     for( nX = 0, nTmpX = 5; nX < nOldWidth; nX++, nTmpX += 4 )
     {
+        const sal_uInt8* pColumn = rIndices.data() + nX;
         for( nY = 0; nY < nOldHeight; )
         {
-            if( pRAcc->GetPixel( nY, nX ) == aTest )
+            if( pColumn[ nY * nOldWidth ] == nIndex )
             {
                 nTmpX -= 3;
                 nTmpY = pMapIn[ nY++ ];
@@ -844,7 +985,7 @@ void ImplExpand( std::optional<ImplVectMap>& oMap, const BitmapReadAccess* pRAcc
                 oMap->Set( nTmpY, nTmpX++, VECT_CONT_INDEX );
                 oMap->Set( nTmpY, nTmpX, VECT_CONT_INDEX );
 
-                while( nY < nOldHeight && pRAcc->GetPixel( nY, nX ) == aTest )
+                while( nY < nOldHeight && pColumn[ nY * nOldWidth ] == nIndex )
                     nY++;
 
                 nTmpX -= 3;
@@ -97,18 +97,27 @@ void GIFImageDataOutputStream::FlushBlockBuf()
 }
 
 
-struct GIFLZWCTreeNode
-{
+// The string table maps (prefix code, pixel value) to the code of the extended
+// string. It is kept as an open addressed hash table which holds at most
+// 4096 - 258 strings, so it never gets more than half full.
+constexpr sal_uInt32 GIF_LZW_HASH_SIZE = 8192;
 
-    GIFLZWCTreeNode*    pBrother;       // next node which has the same father
-    GIFLZWCTreeNode*    pFirstChild;    // first
+struct GIFLZWCHashEntry
+{
+    sal_uInt32          nGeneration;    // entry is only valid if this matches the compressor's generation
+    sal_uInt32          nKey;           // (prefix code << 8) | pixel value
     sal_uInt16          nCode;          // the code for the string of pixel values which comes about
-    sal_uInt16          nValue;         // the pixel value
 };
 
 
+static sal_uInt32 GIFLZWCHash( sal_uInt32 nKey )
+{
+    return ( nKey * 2654435761U ) >> ( 32 - 13 );
+}
+
+
 GIFLZWCompressor::GIFLZWCompressor()
-    : pPrefix(nullptr), nDataSize(0), nClearCode(0),
+    : nGeneration(0), nPrefixCode(0), bHasPrefix(false), nDataSize(0), nClearCode(0),
       nEOICode(0), nTableSize(0), nCodeSize(0)
 {
 }
@@ -125,8 +134,6 @@ void GIFLZWCompressor::StartCompression( SvStream& rGIF, sal_uInt16 nPixelSize )
     if( pIDOS )
         return;
 
-    sal_uInt16 i;
-
     nDataSize = nPixelSize;
 
     if( nDataSize < 2 )
@@ -138,16 +145,10 @@ void GIFLZWCompressor::StartCompression( SvStream& rGIF, sal_uInt16 nPixelSize )
     nCodeSize=nDataSize+1;
 
     pIDOS.reset(new GIFImageDataOutputStream(rGIF,static_cast<sal_uInt8>(nDataSize)));
-    pTable.reset(new GIFLZWCTreeNode[4096]);
+    pTable.reset(new GIFLZWCHashEntry[GIF_LZW_HASH_SIZE]());
 
-    for (i=0; i<4096; i++)
-    {
-        pTable[i].pBrother = pTable[i].pFirstChild = nullptr;
-        pTable[i].nCode = i;
-        pTable[i].nValue = static_cast<sal_uInt8>( i );
-    }
-
-    pPrefix = nullptr;
+    nGeneration = 1;
+    bHasPrefix = false;
     pIDOS->WriteBits( nClearCode,nCodeSize );
 }
 
@@ -156,13 +157,12 @@ void GIFLZWCompressor::Compress(sal_uInt8* pSrc, sal_uInt32 nSize)
     if( !pIDOS )
         return;
 
-    GIFLZWCTreeNode* p;
-    sal_uInt16 i;
     sal_uInt8 nV;
 
-    if( !pPrefix && nSize )
+    if( !bHasPrefix && nSize )
     {
-        pPrefix=&pTable[*pSrc++];
+        nPrefixCode=*pSrc++;
+        bHasPrefix=true;
         nSize--;
     }
 
@@ -170,24 +170,28 @@ void GIFLZWCompressor::Compress(sal_uInt8* pSrc, sal_uInt32 nSize)
     {
         nSize--;
         nV=*pSrc++;
-        for( p=pPrefix->pFirstChild; p!=nullptr; p=p->pBrother )
+
+        const sal_uInt32 nKey = ( static_cast<sal_uInt32>(nPrefixCode) << 8 ) | nV;
+        sal_uInt32 nSlot = GIFLZWCHash( nKey );
+        GIFLZWCHashEntry* p = &pTable[nSlot];
+        while( p->nGeneration==nGeneration && p->nKey!=nKey )
         {
-            if (p->nValue==nV)
-                break;
+            nSlot = ( nSlot + 1 ) & ( GIF_LZW_HASH_SIZE - 1 );
+            p = &pTable[nSlot];
         }
 
-        if( p)
-            pPrefix=p;
+        if( p->nGeneration==nGeneration )
+            nPrefixCode=p->nCode;
         else
         {
-            pIDOS->WriteBits(pPrefix->nCode,nCodeSize);
+            pIDOS->WriteBits(nPrefixCode,nCodeSize);
 
             if (nTableSize==4096)
             {
                 pIDOS->WriteBits(nClearCode,nCodeSize);
 
-                for (i=0; i<nClearCode; i++)
-                    pTable[i].pFirstChild=nullptr;
+                // forget all strings at once instead of clearing the table
+                nGeneration++;
 
                 nCodeSize=nDataSize+1;
                 nTableSize=nEOICode+1;
@@ -197,14 +201,13 @@ void GIFLZWCompressor::Compress(sal_uInt8* pSrc, sal_uInt32 nSize)
                 if(nTableSize==static_cast<sal_uInt16>(1<<nCodeSize))
                     nCodeSize++;
 
-                p=&pTable[nTableSize++];
-                p->pBrother=pPrefix->pFirstChild;
-                pPrefix->pFirstChild=p;
-                p->nValue=nV;
-                p->pFirstChild=nullptr;
+                // p is the free slot the probe sequence ended in
+                p->nGeneration=nGeneration;
+                p->nKey=nKey;
+                p->nCode=nTableSize++;
             }
 
-            pPrefix=&pTable[nV];
+            nPrefixCode=nV;
         }
     }
 }
@@ -213,8 +216,8 @@ void GIFLZWCompressor::EndCompression()
 {
     if( pIDOS )
     {
-        if( pPrefix )
-            pIDOS->WriteBits(pPrefix->nCode,nCodeSize);
+        if( bHasPrefix )
+            pIDOS->WriteBits(nPrefixCode,nCodeSize);
 
         pIDOS->WriteBits( nEOICode,nCodeSize );
         pTable.reset();
@@ -24,7 +24,7 @@
 
 
 class   GIFImageDataOutputStream;
-struct  GIFLZWCTreeNode;
+struct  GIFLZWCHashEntry;
 
 
 class GIFLZWCompressor
@@ -32,8 +32,10 @@ class GIFLZWCompressor
 private:
 
     std::unique_ptr<GIFImageDataOutputStream> pIDOS;
-    std::unique_ptr<GIFLZWCTreeNode[]> pTable;
-    GIFLZWCTreeNode*            pPrefix;
+    std::unique_ptr<GIFLZWCHashEntry[]> pTable;
+    sal_uInt32                  nGeneration;
+    sal_uInt16                  nPrefixCode;
+    bool                        bHasPrefix;
     sal_uInt16                  nDataSize;
     sal_uInt16                  nClearCode;
     sal_uInt16                  nEOICode;
@@ -20,6 +20,7 @@
 #include <filter/EpsWriter.hxx>
 #include <tools/stream.hxx>
 #include <tools/poly.hxx>
+#include <tools/zcodec.hxx>
 #include <tools/fract.hxx>
 #include <tools/helpers.hxx>
 #include <unotools/resmgr.hxx>
@@ -43,6 +44,7 @@
 
 #include <cstdlib>
 #include <memory>
+#include <vector>
 
 using namespace ::com::sun::star::uno;
 
@@ -178,6 +180,14 @@ private:
                         // writes a byte in ASCII (hex) format to stream
     void                ImplWriteHexByte( sal_uInt8 nNumb, NMode nMode = PS_WRAP );
 
+                        // writes a block of bytes in ASCII (hex) format to stream, same as
+                        // calling ImplWriteHexByte for each of them
+    void                ImplWriteHexData( const sal_uInt8* pData, size_t nSize );
+
+                        // writes a block of bytes in ASCII85 format to stream, including the
+                        // ~> end of data marker
+    void                ImplWriteASCII85Data( const sal_uInt8* pData, size_t nSize );
+
                         // writes nNumb as number from 0.000 till 1.000 in ASCII format to stream
     void                ImplWriteB1( sal_uInt8 nNumb );
 
@@ -201,6 +211,8 @@ private:
 
     void                ImplSetClipRegion( vcl::Region const & rRegion );
     void                ImplBmp( Bitmap const *, Bitmap const *, const Point &, double nWidth, double nHeight );
+    void                ImplWriteImageFilters();
+    void                ImplWriteImageData( BitmapReadAccess& rAcc, tools::Long nWidth, tools::Long nHeight, bool bRGB );
     void                ImplText( const OUString& rUniString, const Point& rPos, o3tl::span<const sal_Int32> pDXArry, o3tl::span<const sal_Bool> pKashidaArry, sal_Int32 nWidth, VirtualDevice const & rVDev );
     void                ImplSetAttrForText( const Point & rPoint );
     void                ImplWriteCharacter( char );
@@ -309,7 +321,7 @@ bool PSWriter::WritePS( const Graphic& rGraphic, SvStream& rTargetStream, Filter
         mnPreview = pFilterConfigItem->ReadInt32( "Preview", 1 );
 #endif
         mnLevel = pFilterConfigItem->ReadInt32( "Version", 2 );
-        if ( mnLevel != 1 )
+        if ( mnLevel != 1 && mnLevel != 3 )
             mnLevel = 2;
         mbGrayScale = pFilterConfigItem->ReadInt32( "ColorFormat", 1 ) == 2;
 #ifdef UNX // don't compress by default on unix as ghostscript is unable to read LZW compressed eps
@@ -1747,17 +1759,17 @@ void PSWriter::ImplBmp( Bitmap const * pBitmap, Bitmap const * pMaskBitmap, cons
             ImplWriteLong( nWidth );
             ImplWriteLine( "string readhexstring pop}" );
             ImplWriteLine( "image" );
+            std::vector<sal_uInt8> aRow( nWidth );
             for ( tools::Long y = 0; y < nHeight; y++ )
             {
                 Scanline pScanlineRead = pAcc->GetScanline( y );
                 for ( tools::Long x = 0; x < nWidth; x++ )
-                {
-                    ImplWriteHexByte( pAcc->GetIndexFromData( pScanlineRead, x ) );
-                }
+                    aRow[ x ] = pAcc->GetIndexFromData( pScanlineRead, x );
+                ImplWriteHexData( aRow.data(), aRow.size() );
             }
             mpPS->WriteUChar( 10 );
         }
-        else    // Level 2
+        else    // Level 2 and 3
         {
             if ( mbGrayScale )
             {
@@ -1777,36 +1789,10 @@ void PSWriter::ImplBmp( Bitmap const * pBitmap, Bitmap const * pMaskBitmap, cons
                 ImplWriteLong( 0 );
                 ImplWriteLong( nHeight, PS_NONE );
                 ImplWriteByte( ']', PS_RET );
-                ImplWriteLine( "/DataSource currentfile" );
-                ImplWriteLine( "/ASCIIHexDecode filter" );
-                if ( mbCompression )
-                    ImplWriteLine( "/LZWDecode filter" );
+                ImplWriteImageFilters();
                 ImplWriteLine( ">>" );
                 ImplWriteLine( "image" );
-                if ( mbCompression )
-                {
-                    StartCompression();
-                    for ( tools::Long y = 0; y < nHeight; y++ )
-                    {
-                        Scanline pScanlineRead = pAcc->GetScanline( y );
-                        for ( tools::Long x = 0; x < nWidth; x++ )
-                        {
-                            Compress( pAcc->GetIndexFromData( pScanlineRead, x ) );
-                        }
-                    }
-                    EndCompression();
-                }
-                else
-                {
-                    for ( tools::Long y = 0; y < nHeight; y++ )
-                    {
-                        Scanline pScanlineRead = pAcc->GetScanline( y );
-                        for ( tools::Long x = 0; x < nWidth; x++ )
-                        {
-                            ImplWriteHexByte( pAcc->GetIndexFromData( pScanlineRead, x ) );
-                        }
-                    }
-                }
+                ImplWriteImageData( *pAcc, nWidth, nHeight, false );
             }
             else
             {
@@ -1842,36 +1828,10 @@ void PSWriter::ImplBmp( Bitmap const * pBitmap, Bitmap const * pMaskBitmap, cons
                     ImplWriteLong( 0);
                     ImplWriteLong( nHeight, PS_NONE );
                     ImplWriteByte( ']', PS_RET );
-                    ImplWriteLine( "/DataSource currentfile" );
-                    ImplWriteLine( "/ASCIIHexDecode filter" );
-                    if ( mbCompression )
-                        ImplWriteLine( "/LZWDecode filter" );
+                    ImplWriteImageFilters();
                     ImplWriteLine( ">>" );
                     ImplWriteLine( "image" );
-                    if ( mbCompression )
-                    {
-                        StartCompression();
-                        for ( tools::Long y = 0; y < nHeight; y++ )
-                        {
-                            Scanline pScanlineRead = pAcc->GetScanline( y );
-                            for ( tools::Long x = 0; x < nWidth; x++ )
-                            {
-                                Compress( pAcc->GetIndexFromData( pScanlineRead, x ) );
-                            }
-                        }
-                        EndCompression();
-                    }
-                    else
-                    {
-                        for ( tools::Long y = 0; y < nHeight; y++ )
-                        {
-                            Scanline pScanlineRead = pAcc->GetScanline( y );
-                            for ( tools::Long x = 0; x < nWidth; x++ )
-                            {
-                                ImplWriteHexByte( pAcc->GetIndexFromData( pScanlineRead, x ) );
-                            }
-                        }
-                    }
+                    ImplWriteImageData( *pAcc, nWidth, nHeight, false );
                 }
                 else // 24 bit color
                 {
@@ -1891,45 +1851,12 @@ void PSWriter::ImplBmp( Bitmap const * pBitmap, Bitmap const * pMaskBitmap, cons
                     ImplWriteLong( 0 );
                     ImplWriteLong( nHeight, PS_NONE );
                     ImplWriteByte( ']', PS_RET );
-                    ImplWriteLine( "/DataSource currentfile" );
-                    ImplWriteLine( "/ASCIIHexDecode filter" );
-                    if ( mbCompression )
-                        ImplWriteLine( "/LZWDecode filter" );
+                    ImplWriteImageFilters();
                     ImplWriteLine( ">>" );
                     ImplWriteLine( "image" );
-                    if ( mbCompression )
-                    {
-                        StartCompression();
-                        for ( tools::Long y = 0; y < nHeight; y++ )
-                        {
-                            Scanline pScanlineRead = pAcc->GetScanline( y );
-                            for ( tools::Long x = 0; x < nWidth; x++ )
-                            {
-                                const BitmapColor aBitmapColor( pAcc->GetPixelFromData( pScanlineRead, x ) );
-                                Compress( aBitmapColor.GetRed() );
-                                Compress( aBitmapColor.GetGreen() );
-                                Compress( aBitmapColor.GetBlue() );
-                            }
-                        }
-                        EndCompression();
-                    }
-                    else
-                    {
-                        for ( tools::Long y = 0; y < nHeight; y++ )
-                        {
-                            Scanline pScanline = pAcc->GetScanline( y );
-                            for ( tools::Long x = 0; x < nWidth; x++ )
-                            {
-                                const BitmapColor aBitmapColor( pAcc->GetPixelFromData( pScanline, x ) );
-                                ImplWriteHexByte( aBitmapColor.GetRed() );
-                                ImplWriteHexByte( aBitmapColor.GetGreen() );
-                                ImplWriteHexByte( aBitmapColor.GetBlue() );
-                            }
-                        }
-                    }
+                    ImplWriteImageData( *pAcc, nWidth, nHeight, true );
                 }
             }
-            ImplWriteLine( ">" );       // in Level 2 the dictionary needs to be closed (eod)
         }
         if ( bDoTrans )
             ImplWriteLine( "gr" );
@@ -1946,6 +1873,80 @@ void PSWriter::ImplBmp( Bitmap const * pBitmap, Bitmap const * pMaskBitmap, cons
     }
 }
 
+void PSWriter::ImplWriteImageFilters()
+{
+    ImplWriteLine( "/DataSource currentfile" );
+    if ( mnLevel == 3 )
+    {
+        ImplWriteLine( "/ASCII85Decode filter" );
+        ImplWriteLine( "/FlateDecode filter" );
+    }
+    else
+    {
+        ImplWriteLine( "/ASCIIHexDecode filter" );
+        if ( mbCompression )
+            ImplWriteLine( "/LZWDecode filter" );
+    }
+}
+
+void PSWriter::ImplWriteImageData( BitmapReadAccess& rAcc, tools::Long nWidth, tools::Long nHeight, bool bRGB )
+{
+    std::vector<sal_uInt8> aRow( nWidth * ( bRGB ? 3 : 1 ) );
+    auto fillRow = [&]( tools::Long y )
+    {
+        Scanline pScanlineRead = rAcc.GetScanline( y );
+        sal_uInt8* pDst = aRow.data();
+        for ( tools::Long x = 0; x < nWidth; x++ )
+        {
+            if ( bRGB )
+            {
+                const BitmapColor aBitmapColor( rAcc.GetPixelFromData( pScanlineRead, x ) );
+                *pDst++ = aBitmapColor.GetRed();
+                *pDst++ = aBitmapColor.GetGreen();
+                *pDst++ = aBitmapColor.GetBlue();
+            }
+            else
+                *pDst++ = rAcc.GetIndexFromData( pScanlineRead, x );
+        }
+    };
+
+    if ( mnLevel == 3 )
+    {
+        SvMemoryStream aCompressed( nHeight * aRow.size() / 2 + 1024, 65536 );
+        ZCodec aCodec( 0x8000, 0x8000 );
+        aCodec.BeginCompression();
+        for ( tools::Long y = 0; y < nHeight; y++ )
+        {
+            fillRow( y );
+            aCodec.Write( aCompressed, aRow.data(), aRow.size() );
+        }
+        aCodec.EndCompression();
+        ImplWriteASCII85Data( static_cast<const sal_uInt8*>( aCompressed.GetData() ), aCompressed.TellEnd() );
+        return;
+    }
+
+    if ( mbCompression )
+    {
+        StartCompression();
+        for ( tools::Long y = 0; y < nHeight; y++ )
+        {
+            fillRow( y );
+            for ( sal_uInt8 nByte : aRow )
+                Compress( nByte );
+        }
+        EndCompression();
+    }
+    else
+    {
+        for ( tools::Long y = 0; y < nHeight; y++ )
+        {
+            fillRow( y );
+            ImplWriteHexData( aRow.data(), aRow.size() );
+        }
+    }
+    ImplWriteLine( ">" );       // in Level 2 the dictionary needs to be closed (eod)
+}
+
 void PSWriter::ImplWriteCharacter( char nChar )
 {
     switch( nChar )
@@ -2464,6 +2465,23 @@ void PSWriter::ImplWriteHexByte( sal_uInt8 nNumb, NMode nMode )
     ImplExecMode( nMode );
 }
 
+void PSWriter::ImplWriteHexData( const sal_uInt8* pData, size_t nSize )
+{
+    std::string aBuffer;
+    vcl::eps::EncodeHex( aBuffer, pData, nSize, mnCursorPos, PS_LINESIZE );
+    mpPS->WriteBytes( aBuffer.data(), aBuffer.size() );
+}
+
+void PSWriter::ImplWriteASCII85Data( const sal_uInt8* pData, size_t nSize )
+{
+    std::string aBuffer;
+    vcl::eps::EncodeASCII85( aBuffer, pData, nSize, mnCursorPos, PS_LINESIZE );
+    mpPS->WriteBytes( aBuffer.data(), aBuffer.size() );
+    mnCursorPos = 0;
+    mpPS->WriteCharPtr( "~>" );
+    mpPS->WriteUChar( 0xa );
+}
+
 // writes the sal_uInt8 nNumb as a Number from 0.000 up to 1.000
 
 void PSWriter::ImplWriteB1( sal_uInt8 nNumb )
@@ -2656,6 +2674,83 @@ bool PSWriter::ImplGetBoundingBox( double* nNumb, sal_uInt8* pSource, sal_uInt32
     return bRetValue;
 }
 
+namespace vcl::eps
+{
+void EncodeHex( std::string& rOut, const sal_uInt8* pData, size_t nSize,
+                sal_uInt32& rLinePos, sal_uInt32 nLineSize )
+{
+    static const char aHexDigits[] = "0123456789ABCDEF";
+
+    // two digits per byte, plus a line feed every nLineSize / 2 bytes
+    rOut.reserve( rOut.size() + nSize * 2 + nSize / ( nLineSize / 2 ) + 1 );
+    for ( size_t i = 0; i < nSize; i++ )
+    {
+        rOut.push_back( aHexDigits[ pData[ i ] >> 4 ] );
+        rOut.push_back( aHexDigits[ pData[ i ] & 0xf ] );
+        rLinePos += 2;
+        if ( rLinePos >= nLineSize )
+        {
+            rOut.push_back( 0xa );
+            rLinePos = 0;
+        }
+    }
+}
+
+void EncodeASCII85( std::string& rOut, const sal_uInt8* pData, size_t nSize,
+                    sal_uInt32& rLinePos, sal_uInt32 nLineSize )
+{
+    // at most five characters per four bytes, a line feed and a guard blank per line
+    rOut.reserve( rOut.size() + nSize / 4 * 5 + ( nSize / 4 + 1 ) * 2 + 16 );
+
+    auto writeGroup = [&]( sal_uInt32 nGroup, size_t nChars )
+    {
+        char aDigits[ 5 ];
+        if ( nChars == 5 && !nGroup )
+        {
+            aDigits[ 0 ] = 'z';
+            nChars = 1;
+        }
+        else
+        {
+            for ( int i = 4; i >= 0; i-- )
+            {
+                aDigits[ i ] = static_cast<char>( '!' + nGroup % 85 );
+                nGroup /= 85;
+            }
+        }
+        if ( rLinePos >= nLineSize )
+        {
+            rOut.push_back( 0xa );
+            rLinePos = 0;
+        }
+        // don't let a data line start with % and be taken for a DSC comment
+        if ( !rLinePos && aDigits[ 0 ] == '%' )
+        {
+            rOut.push_back( ' ' );
+            rLinePos++;
+        }
+        rOut.append( aDigits, nChars );
+        rLinePos += nChars;
+    };
+
+    const sal_uInt8* pEnd = pData + ( nSize & ~size_t( 3 ) );
+    for ( ; pData != pEnd; pData += 4 )
+    {
+        writeGroup( ( sal_uInt32( pData[ 0 ] ) << 24 ) | ( sal_uInt32( pData[ 1 ] ) << 16 ) |
+                    ( sal_uInt32( pData[ 2 ] ) << 8 ) | pData[ 3 ], 5 );
+    }
+
+    // a final partial group is padded with zeros and written with one character per byte more
+    if ( const size_t nRest = nSize & 3 )
+    {
+        sal_uInt32 nGroup = 0;
+        for ( size_t i = 0; i < 4; i++ )
+            nGroup = ( nGroup << 8 ) | ( i < nRest ? pData[ i ] : 0 );
+        writeGroup( nGroup, nRest + 1 );
+    }
+}
+}
+
 //================== GraphicExport - the exported function ===================
 
 bool ExportEpsGraphic(SvStream & rStream, const Graphic & rGraphic, FilterConfigItem* pFilterConfigItem)
@@ -30,12 +30,7 @@
 
 sal_uInt64 DXF2GDIMetaFile::CountEntities(const DXFEntities & rEntities)
 {
-    const DXFBasicEntity * pBE;
-    sal_uInt64 nRes;
-
-    nRes=0;
-    for (pBE=rEntities.pFirst; pBE!=nullptr; pBE=pBE->pSucc) nRes++;
-    return nRes;
+    return rEntities.GetCount();
 }
 
 Color DXF2GDIMetaFile::ConvertColor(sal_uInt8 nColor) const
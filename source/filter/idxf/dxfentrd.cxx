@@ -791,10 +791,7 @@ void DXFDimensionEntity::EvaluateGroup(DXFGroupReader & rDGR)
 
 void DXFEntities::Read(DXFGroupReader & rDGR)
 {
-    DXFBasicEntity * pE, * * ppSucc;
-
-    ppSucc=&pFirst;
-    while (*ppSucc!=nullptr) ppSucc=&((*ppSucc)->pSucc);
+    DXFBasicEntity * pE;
 
     while (rDGR.GetG()!=0) rDGR.Read();
 
@@ -803,24 +800,24 @@ void DXFEntities::Read(DXFGroupReader & rDGR)
            rDGR.GetS()!="EOF" )
     {
 
-        if      (rDGR.GetS() == "LINE"      ) pE=new DXFLineEntity;
-        else if (rDGR.GetS() == "POINT"     ) pE=new DXFPointEntity;
-        else if (rDGR.GetS() == "CIRCLE"    ) pE=new DXFCircleEntity;
-        else if (rDGR.GetS() == "ARC"       ) pE=new DXFArcEntity;
-        else if (rDGR.GetS() == "TRACE"     ) pE=new DXFTraceEntity;
-        else if (rDGR.GetS() == "SOLID"     ) pE=new DXFSolidEntity;
-        else if (rDGR.GetS() == "TEXT"      ) pE=new DXFTextEntity;
-        else if (rDGR.GetS() == "SHAPE"     ) pE=new DXFShapeEntity;
-        else if (rDGR.GetS() == "INSERT"    ) pE=new DXFInsertEntity;
-        else if (rDGR.GetS() == "ATTDEF"    ) pE=new DXFAttDefEntity;
-        else if (rDGR.GetS() == "ATTRIB"    ) pE=new DXFAttribEntity;
-        else if (rDGR.GetS() == "POLYLINE"  ) pE=new DXFPolyLineEntity;
-        else if (rDGR.GetS() == "LWPOLYLINE") pE=new DXFLWPolyLineEntity;
-        else if (rDGR.GetS() == "VERTEX"    ) pE=new DXFVertexEntity;
-        else if (rDGR.GetS() == "SEQEND"    ) pE=new DXFSeqEndEntity;
-        else if (rDGR.GetS() == "3DFACE"    ) pE=new DXF3DFaceEntity;
-        else if (rDGR.GetS() == "DIMENSION" ) pE=new DXFDimensionEntity;
-        else if (rDGR.GetS() == "HATCH"     ) pE=new DXFHatchEntity;
+        if      (rDGR.GetS() == "LINE"      ) pE=CreateEntity<DXFLineEntity>();
+        else if (rDGR.GetS() == "POINT"     ) pE=CreateEntity<DXFPointEntity>();
+        else if (rDGR.GetS() == "CIRCLE"    ) pE=CreateEntity<DXFCircleEntity>();
+        else if (rDGR.GetS() == "ARC"       ) pE=CreateEntity<DXFArcEntity>();
+        else if (rDGR.GetS() == "TRACE"     ) pE=CreateEntity<DXFTraceEntity>();
+        else if (rDGR.GetS() == "SOLID"     ) pE=CreateEntity<DXFSolidEntity>();
+        else if (rDGR.GetS() == "TEXT"      ) pE=CreateEntity<DXFTextEntity>();
+        else if (rDGR.GetS() == "SHAPE"     ) pE=CreateEntity<DXFShapeEntity>();
+        else if (rDGR.GetS() == "INSERT"    ) pE=CreateEntity<DXFInsertEntity>();
+        else if (rDGR.GetS() == "ATTDEF"    ) pE=CreateEntity<DXFAttDefEntity>();
+        else if (rDGR.GetS() == "ATTRIB"    ) pE=CreateEntity<DXFAttribEntity>();
+        else if (rDGR.GetS() == "POLYLINE"  ) pE=CreateEntity<DXFPolyLineEntity>();
+        else if (rDGR.GetS() == "LWPOLYLINE") pE=CreateEntity<DXFLWPolyLineEntity>();
+        else if (rDGR.GetS() == "VERTEX"    ) pE=CreateEntity<DXFVertexEntity>();
+        else if (rDGR.GetS() == "SEQEND"    ) pE=CreateEntity<DXFSeqEndEntity>();
+        else if (rDGR.GetS() == "3DFACE"    ) pE=CreateEntity<DXF3DFaceEntity>();
+        else if (rDGR.GetS() == "DIMENSION" ) pE=CreateEntity<DXFDimensionEntity>();
+        else if (rDGR.GetS() == "HATCH"     ) pE=CreateEntity<DXFHatchEntity>();
         else
         {
             do {
@@ -828,21 +825,22 @@ void DXFEntities::Read(DXFGroupReader & rDGR)
             } while (rDGR.GetG()!=0);
             continue;
         }
-        *ppSucc=pE;
-        ppSucc=&(pE->pSucc);
+        if (mpLast!=nullptr)
+            mpLast->pSucc=pE;
+        else
+            pFirst=pE;
+        mpLast=pE;
+        mnCount++;
         pE->Read(rDGR);
     }
 }
 
 void DXFEntities::Clear()
 {
-    DXFBasicEntity * ptmp;
-
-    while (pFirst!=nullptr) {
-        ptmp=pFirst;
-        pFirst=ptmp->pSucc;
-        delete ptmp;
-    }
+    pFirst=nullptr;
+    mpLast=nullptr;
+    mnCount=0;
+    std::apply([](auto&... rArena) { (rArena.reset(), ...); }, maArena);
 }
 
 /* vim:set shiftwidth=4 softtabstop=4 expandtab: */
@@ -24,7 +24,9 @@
 #include "dxfvec.hxx"
 #include <tools/long.hxx>
 
+#include <deque>
 #include <memory>
+#include <tuple>
 #include <vector>
 
 enum DXFEntityType {
@@ -512,9 +514,14 @@ public:
     DXFEntities()
         : pFirst(nullptr)
         , mbBeingDrawn(false)
+        , mpLast(nullptr)
+        , mnCount(0)
     {
     }
 
+    DXFEntities(const DXFEntities&) = delete;
+    DXFEntities& operator=(const DXFEntities&) = delete;
+
     ~DXFEntities()
     {
         Clear();
@@ -530,6 +537,50 @@ public:
 
     void Clear();
         // deletes all entities
+
+    sal_uInt64 GetCount() const { return mnCount; }
+        // number of entities in the list starting at pFirst
+
+private:
+
+    template<class T> T * CreateEntity()
+    {
+        std::unique_ptr<std::deque<T>> & rpArena = std::get<std::unique_ptr<std::deque<T>>>(maArena);
+        if (!rpArena)
+            rpArena = std::make_unique<std::deque<T>>();
+        return &rpArena->emplace_back();
+    }
+
+    // The entities are kept in one arena per entity type instead of being
+    // allocated one by one on the heap. std::deque grows in chunks and never
+    // moves its elements, so the pSucc chain stays valid while reading and
+    // everything is released in bulk by Clear(). An arena is only created
+    // when the first entity of its type is read, since a drawing can have
+    // thousands of blocks that each use just one or two entity types.
+    template<class... T> using Arenas = std::tuple<std::unique_ptr<std::deque<T>>...>;
+    Arenas<
+        DXFLineEntity,
+        DXFPointEntity,
+        DXFCircleEntity,
+        DXFArcEntity,
+        DXFTraceEntity,
+        DXFSolidEntity,
+        DXFTextEntity,
+        DXFShapeEntity,
+        DXFInsertEntity,
+        DXFAttDefEntity,
+        DXFAttribEntity,
+        DXFPolyLineEntity,
+        DXFLWPolyLineEntity,
+        DXFVertexEntity,
+        DXFSeqEndEntity,
+        DXF3DFaceEntity,
+        DXFDimensionEntity,
+        DXFHatchEntity
+    > maArena;
+
+    DXFBasicEntity * mpLast; // tail of the list, for appending in Read()
+    sal_uInt64 mnCount;
 };
 
 #endif
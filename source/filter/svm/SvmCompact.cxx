@@ -0,0 +1,329 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <sal/config.h>
+#include <sal/log.hxx>
+
+#include <filter/SvmCompact.hxx>
+
+#include <tools/vcompat.hxx>
+#include <vcl/TypeSerializer.hxx>
+#include <vcl/lineinfo.hxx>
+
+#include <vector>
+
+namespace
+{
+class CompactEncoder
+{
+    std::vector<sal_uInt8> maBuffer;
+    sal_Int64 mnLastX = 0;
+    sal_Int64 mnLastY = 0;
+
+public:
+    void writeVarInt(sal_uInt64 nValue)
+    {
+        while (nValue >= 0x80)
+        {
+            maBuffer.push_back(static_cast<sal_uInt8>(nValue | 0x80));
+            nValue >>= 7;
+        }
+        maBuffer.push_back(static_cast<sal_uInt8>(nValue));
+    }
+
+    void writeSigned(sal_Int64 nValue)
+    {
+        writeVarInt((static_cast<sal_uInt64>(nValue) << 1) ^ static_cast<sal_uInt64>(nValue >> 63));
+    }
+
+    void writePolygon(const tools::Polygon& rPoly)
+    {
+        const sal_uInt16 nPoints = rPoly.GetSize();
+        writeVarInt(nPoints);
+        maBuffer.reserve(maBuffer.size() + 4 * size_t(nPoints));
+        for (sal_uInt16 i = 0; i < nPoints; ++i)
+        {
+            const Point& rPt = rPoly.GetPoint(i);
+            writeSigned(rPt.X() - mnLastX);
+            writeSigned(rPt.Y() - mnLastY);
+            mnLastX = rPt.X();
+            mnLastY = rPt.Y();
+        }
+    }
+
+    void flush(SvStream& rOStm)
+    {
+        rOStm.WriteUInt32(maBuffer.size());
+        rOStm.WriteBytes(maBuffer.data(), maBuffer.size());
+    }
+};
+
+class CompactDecoder
+{
+    std::vector<sal_uInt8> maBuffer;
+    size_t mnPos = 0;
+    sal_Int64 mnLastX = 0;
+    sal_Int64 mnLastY = 0;
+
+public:
+    bool fill(SvStream& rIStm)
+    {
+        sal_uInt32 nSize(0);
+        rIStm.ReadUInt32(nSize);
+        if (!rIStm.good() || nSize > rIStm.remainingSize())
+        {
+            SAL_WARN("vcl.gdi", "svm compact polygon block claims " << nSize << " bytes");
+            return false;
+        }
+        maBuffer.resize(nSize);
+        return rIStm.ReadBytes(maBuffer.data(), nSize) == nSize;
+    }
+
+    bool readVarInt(sal_uInt64& rValue)
+    {
+        rValue = 0;
+        for (int nShift = 0; nShift < 64 && mnPos < maBuffer.size(); nShift += 7)
+        {
+            const sal_uInt8 nByte = maBuffer[mnPos++];
+            rValue |= static_cast<sal_uInt64>(nByte & 0x7f) << nShift;
+            if (!(nByte & 0x80))
+                return true;
+        }
+        return false;
+    }
+
+    bool readSigned(sal_Int64& rValue)
+    {
+        sal_uInt64 nValue(0);
+        if (!readVarInt(nValue))
+            return false;
+        rValue = static_cast<sal_Int64>(nValue >> 1) ^ -static_cast<sal_Int64>(nValue & 1);
+        return true;
+    }
+
+    bool readPolygon(tools::Polygon& rPoly)
+    {
+        sal_uInt64 nPoints(0);
+        // every point takes at least two bytes
+        if (!readVarInt(nPoints) || nPoints > SAL_MAX_UINT16
+            || nPoints > (maBuffer.size() - mnPos) / 2)
+            return false;
+
+        tools::Polygon aPoly(static_cast<sal_uInt16>(nPoints));
+        for (sal_uInt16 i = 0; i < nPoints; ++i)
+        {
+            sal_Int64 nDeltaX(0), nDeltaY(0);
+            if (!readSigned(nDeltaX) || !readSigned(nDeltaY))
+                return false;
+            mnLastX += nDeltaX;
+            mnLastY += nDeltaY;
+            aPoly.SetPoint(Point(mnLastX, mnLastY), i);
+        }
+        rPoly = std::move(aPoly);
+        return true;
+    }
+};
+}
+
+namespace vcl::svm
+{
+namespace
+{
+void WriteCompactPolygon(SvStream& rOStm, const tools::Polygon& rPoly)
+{
+    CompactEncoder aEncoder;
+    aEncoder.writePolygon(rPoly);
+    aEncoder.flush(rOStm);
+}
+
+void WriteCompactPolyPolygon(SvStream& rOStm, const tools::PolyPolygon& rPolyPoly)
+{
+    CompactEncoder aEncoder;
+    const sal_uInt16 nPolyCount = rPolyPoly.Count();
+    aEncoder.writeVarInt(nPolyCount);
+    for (sal_uInt16 i = 0; i < nPolyCount; ++i)
+        aEncoder.writePolygon(rPolyPoly.GetObject(i));
+    aEncoder.flush(rOStm);
+}
+}
+
+CompactSvmWriter::CompactSvmWriter(SvStream& rOStm)
+    : SvmWriter(rOStm)
+    , mrOStm(rOStm)
+{
+}
+
+SvStream& CompactSvmWriter::Write(const GDIMetaFile& rMetaFile)
+{
+    const SvStreamCompressFlags nStmCompressMode = mrOStm.GetCompressMode();
+    SvStreamEndian nOldFormat = mrOStm.GetEndian();
+
+    mrOStm.SetEndian(SvStreamEndian::LITTLE);
+    mrOStm.WriteBytes("VCLMTF", 6);
+
+    {
+        VersionCompatWrite aCompat(mrOStm, 1);
+
+        mrOStm.WriteUInt32(static_cast<sal_uInt32>(nStmCompressMode));
+        TypeSerializer aSerializer(mrOStm);
+        aSerializer.writeMapMode(rMetaFile.GetPrefMapMode());
+        aSerializer.writeSize(rMetaFile.GetPrefSize());
+        mrOStm.WriteUInt32(rMetaFile.GetActionSize());
+    }
+
+    ImplMetaWriteData aWriteData;
+
+    aWriteData.meActualCharSet = mrOStm.GetStreamCharSet();
+
+    MetaAction* pAct = const_cast<GDIMetaFile&>(rMetaFile).FirstAction();
+    while (pAct)
+    {
+        switch (pAct->GetType())
+        {
+            case MetaActionType::POLYLINE:
+                CompactPolyLineHandler(static_cast<MetaPolyLineAction*>(pAct));
+                break;
+            case MetaActionType::POLYGON:
+                CompactPolygonHandler(static_cast<MetaPolygonAction*>(pAct));
+                break;
+            case MetaActionType::POLYPOLYGON:
+                CompactPolyPolygonHandler(static_cast<MetaPolyPolygonAction*>(pAct));
+                break;
+            default:
+                MetaActionHandler(pAct, &aWriteData);
+                break;
+        }
+        pAct = const_cast<GDIMetaFile&>(rMetaFile).NextAction();
+    }
+
+    mrOStm.SetEndian(nOldFormat);
+
+    return mrOStm;
+}
+
+// The three handlers below write what SvmWriter writes, plus one more action
+// version holding the compact points. When the compact form is used, the
+// Version 1 points are left empty.
+
+void CompactSvmWriter::CompactPolyLineHandler(const MetaPolyLineAction* pAction)
+{
+    mrOStm.WriteUInt16(static_cast<sal_uInt16>(pAction->GetType()));
+
+    VersionCompatWrite aCompat(mrOStm, 4);
+
+    const bool bHasPolyFlags = pAction->GetPolygon().HasFlags();
+
+    tools::Polygon aSimplePoly;
+    if (bHasPolyFlags)
+        pAction->GetPolygon().AdaptiveSubdivide(aSimplePoly);
+
+    WritePolygon(mrOStm, aSimplePoly); // Version 1
+    WriteLineInfo(mrOStm, pAction->GetLineInfo()); // Version 2
+
+    mrOStm.WriteBool(bHasPolyFlags); // Version 3
+    if (bHasPolyFlags)
+        pAction->GetPolygon().Write(mrOStm);
+
+    mrOStm.WriteBool(!bHasPolyFlags); // Version 4
+    if (!bHasPolyFlags)
+        WriteCompactPolygon(mrOStm, pAction->GetPolygon());
+}
+
+void CompactSvmWriter::CompactPolygonHandler(const MetaPolygonAction* pAction)
+{
+    mrOStm.WriteUInt16(static_cast<sal_uInt16>(pAction->GetType()));
+
+    VersionCompatWrite aCompat(mrOStm, 3);
+
+    const bool bHasPolyFlags = pAction->GetPolygon().HasFlags();
+
+    tools::Polygon aSimplePoly; // Version 1
+    if (bHasPolyFlags)
+        pAction->GetPolygon().AdaptiveSubdivide(aSimplePoly);
+    WritePolygon(mrOStm, aSimplePoly);
+
+    mrOStm.WriteBool(bHasPolyFlags); // Version 2
+    if (bHasPolyFlags)
+        pAction->GetPolygon().Write(mrOStm);
+
+    mrOStm.WriteBool(!bHasPolyFlags); // Version 3
+    if (!bHasPolyFlags)
+        WriteCompactPolygon(mrOStm, pAction->GetPolygon());
+}
+
+void CompactSvmWriter::CompactPolyPolygonHandler(const MetaPolyPolygonAction* pAction)
+{
+    mrOStm.WriteUInt16(static_cast<sal_uInt16>(pAction->GetType()));
+
+    VersionCompatWrite aCompat(mrOStm, 3);
+
+    const tools::PolyPolygon& rPolyPoly = pAction->GetPolyPolygon();
+    sal_uInt16 nNumberOfComplexPolygons = 0;
+    sal_uInt16 i, nPolyCount = rPolyPoly.Count();
+
+    for (i = 0; i < nPolyCount; i++)
+    {
+        if (rPolyPoly.GetObject(i).HasFlags())
+            nNumberOfComplexPolygons++;
+    }
+    const bool bCompact = !nNumberOfComplexPolygons;
+
+    tools::Polygon aSimplePoly; // Version 1
+    mrOStm.WriteUInt16(bCompact ? 0 : nPolyCount);
+    for (i = 0; !bCompact && i < nPolyCount; i++)
+    {
+        rPolyPoly.GetObject(i).AdaptiveSubdivide(aSimplePoly);
+        WritePolygon(mrOStm, aSimplePoly);
+    }
+
+    mrOStm.WriteUInt16(nNumberOfComplexPolygons); // Version 2
+    for (i = 0; nNumberOfComplexPolygons && (i < nPolyCount); i++)
+    {
+        const tools::Polygon& rPoly = rPolyPoly.GetObject(i);
+        if (rPoly.HasFlags())
+        {
+            mrOStm.WriteUInt16(i);
+            rPoly.Write(mrOStm);
+
+            nNumberOfComplexPolygons--;
+        }
+    }
+
+    mrOStm.WriteBool(bCompact); // Version 3
+    if (bCompact)
+        WriteCompactPolyPolygon(mrOStm, rPolyPoly);
+}
+
+bool ReadCompactPolygon(SvStream& rIStm, tools::Polygon& rPoly)
+{
+    CompactDecoder aDecoder;
+    return aDecoder.fill(rIStm) && aDecoder.readPolygon(rPoly);
+}
+
+bool ReadCompactPolyPolygon(SvStream& rIStm, tools::PolyPolygon& rPolyPoly)
+{
+    CompactDecoder aDecoder;
+    sal_uInt64 nPolyCount(0);
+    if (!aDecoder.fill(rIStm) || !aDecoder.readVarInt(nPolyCount) || nPolyCount > SAL_MAX_UINT16)
+        return false;
+
+    tools::PolyPolygon aPolyPoly(static_cast<sal_uInt16>(nPolyCount));
+    for (sal_uInt64 i = 0; i < nPolyCount; ++i)
+    {
+        tools::Polygon aPoly;
+        if (!aDecoder.readPolygon(aPoly))
+            return false;
+        aPolyPoly.Insert(aPoly);
+    }
+    rPolyPoly = std::move(aPolyPoly);
+    return true;
+}
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
@@ -18,7 +18,9 @@
  */
 
 #include <sal/log.hxx>
+#include <osl/endian.h>
 #include <osl/thread.h>
+#include <tools/poly.hxx>
 #include <tools/stream.hxx>
 #include <tools/vcompat.hxx>
 
@@ -28,8 +30,12 @@
 #include <vcl/gdimtf.hxx>
 #include <vcl/metaact.hxx>
 
+#include <filter/SvmCompact.hxx>
 #include "SvmConverter.hxx"
 
+#include <algorithm>
+#include <vector>
+
 namespace
 {
 class DepthGuard
@@ -53,6 +59,78 @@ public:
         m_rData.meActualCharSet = m_eOrigCharSet;
     }
 };
+
+bool NeedsSwap(SvStream const& rIStm)
+{
+#ifdef OSL_BIGENDIAN
+    return rIStm.GetEndian() == SvStreamEndian::LITTLE;
+#else
+    return rIStm.GetEndian() == SvStreamEndian::BIG;
+#endif
+}
+
+// Reads nCount sal_Int32 values with a single stream read, which on memory backed
+// streams (clipboard, graphic swap) boils down to one memcpy.
+size_t ReadInt32Array(SvStream& rIStm, sal_Int32* pData, size_t nCount)
+{
+    const size_t nRead = rIStm.ReadBytes(pData, nCount * sizeof(sal_Int32)) / sizeof(sal_Int32);
+    if (NeedsSwap(rIStm))
+    {
+        for (size_t i = 0; i < nRead; ++i)
+            pData[i] = OSL_SWAPDWORD(pData[i]);
+    }
+    return nRead;
+}
+
+// Same as ReadPolygon from tools, but fetches the whole point array at once
+// instead of going through the stream twice per point.
+void ReadPolygonBulk(SvStream& rIStm, tools::Polygon& rPoly, std::vector<sal_Int32>& rBuffer)
+{
+    sal_uInt16 nPoints(0);
+    rIStm.ReadUInt16(nPoints);
+
+    const size_t nMaxRecordsPossible = rIStm.remainingSize() / (2 * sizeof(sal_Int32));
+    if (nPoints > nMaxRecordsPossible)
+    {
+        SAL_WARN("vcl.gdi", "Polygon claims " << nPoints << " records, but only "
+                                              << nMaxRecordsPossible << " possible");
+        nPoints = nMaxRecordsPossible;
+    }
+
+    rBuffer.resize(2 * size_t(nPoints));
+    const size_t nRead = ReadInt32Array(rIStm, rBuffer.data(), rBuffer.size());
+    std::fill(rBuffer.begin() + nRead, rBuffer.end(), 0);
+
+    tools::Polygon aPoly(nPoints);
+    for (sal_uInt16 i = 0; i < nPoints; ++i)
+        aPoly.SetPoint(Point(rBuffer[2 * i], rBuffer[2 * i + 1]), i);
+    rPoly = std::move(aPoly);
+}
+
+void ReadPolyPolygonBulk(SvStream& rIStm, tools::PolyPolygon& rPolyPoly)
+{
+    sal_uInt16 nPolyCount(0);
+    rIStm.ReadUInt16(nPolyCount);
+
+    const size_t nMinRecordSize = sizeof(sal_uInt16);
+    const size_t nMaxRecords = rIStm.remainingSize() / nMinRecordSize;
+    if (nPolyCount > nMaxRecords)
+    {
+        SAL_WARN("vcl.gdi", "Parsing error: " << nMaxRecords << " max possible entries, but "
+                                              << nPolyCount << " claimed, truncating");
+        nPolyCount = nMaxRecords;
+    }
+
+    tools::PolyPolygon aPolyPoly(nPolyCount);
+    std::vector<sal_Int32> aBuffer;
+    for (sal_uInt16 i = 0; i < nPolyCount; ++i)
+    {
+        tools::Polygon aPoly;
+        ReadPolygonBulk(rIStm, aPoly, aBuffer);
+        aPolyPoly.Insert(aPoly);
+    }
+    rPolyPoly = std::move(aPolyPoly);
+}
 }
 
 SvmReader::SvmReader(SvStream& rIStm)
@@ -496,7 +574,8 @@ rtl::Reference<MetaAction> SvmReader::PolyLineHandler()
 
     // Version 1
     tools::Polygon aPolygon;
-    ReadPolygon(mrStream, aPolygon);
+    std::vector<sal_Int32> aBuffer;
+    ReadPolygonBulk(mrStream, aPolygon, aBuffer);
 
     // Version 2
     if (aCompat.GetVersion() >= 2)
@@ -512,6 +591,13 @@ rtl::Reference<MetaAction> SvmReader::PolyLineHandler()
         if (bHasPolyFlags)
             aPolygon.Read(mrStream);
     }
+    if (aCompat.GetVersion() >= 4)
+    {
+        sal_uInt8 bCompact(0);
+        mrStream.ReadUChar(bCompact);
+        if (bCompact && !vcl::svm::ReadCompactPolygon(mrStream, aPolygon))
+            SAL_WARN("vcl.gdi", "svm contains broken compact polyline");
+    }
     pAction->SetPolygon(aPolygon);
 
     return pAction;
@@ -524,7 +610,8 @@ rtl::Reference<MetaAction> SvmReader::PolygonHandler()
     VersionCompatRead aCompat(mrStream);
 
     tools::Polygon aPolygon;
-    ReadPolygon(mrStream, aPolygon); // Version 1
+    std::vector<sal_Int32> aBuffer;
+    ReadPolygonBulk(mrStream, aPolygon, aBuffer); // Version 1
 
     if (aCompat.GetVersion() >= 2) // Version 2
     {
@@ -534,6 +621,14 @@ rtl::Reference<MetaAction> SvmReader::PolygonHandler()
             aPolygon.Read(mrStream);
     }
 
+    if (aCompat.GetVersion() >= 3) // Version 3
+    {
+        sal_uInt8 bCompact(0);
+        mrStream.ReadUChar(bCompact);
+        if (bCompact && !vcl::svm::ReadCompactPolygon(mrStream, aPolygon))
+            SAL_WARN("vcl.gdi", "svm contains broken compact polygon");
+    }
+
     pAction->SetPolygon(aPolygon);
 
     return pAction;
@@ -545,7 +640,7 @@ rtl::Reference<MetaAction> SvmReader::PolyPolygonHandler()
 
     VersionCompatRead aCompat(mrStream);
     tools::PolyPolygon aPolyPolygon;
-    ReadPolyPolygon(mrStream, aPolyPolygon); // Version 1
+    ReadPolyPolygonBulk(mrStream, aPolyPolygon); // Version 1
 
     if (aCompat.GetVersion() < 2) // Version 2
     {
@@ -580,6 +675,14 @@ rtl::Reference<MetaAction> SvmReader::PolyPolygonHandler()
         aPolyPolygon.Replace(aPoly, nIndex);
     }
 
+    if (aCompat.GetVersion() >= 3) // Version 3
+    {
+        sal_uInt8 bCompact(0);
+        mrStream.ReadUChar(bCompact);
+        if (bCompact && !vcl::svm::ReadCompactPolyPolygon(mrStream, aPolyPolygon))
+            SAL_WARN("vcl.gdi", "svm contains broken compact polypolygon");
+    }
+
     pAction->SetPolyPolygon(aPolyPolygon);
 
     return pAction;
@@ -668,17 +771,9 @@ rtl::Reference<MetaAction> SvmReader::TextArrayHandler(const ImplMetaReadData* p
         {
             try
             {
-                aArray.resize(nTmpLen);
-                sal_Int32 i;
-                sal_Int32 val(0);
-                for (i = 0; i < nAryLen; i++)
-                {
-                    mrStream.ReadInt32(val);
-                    aArray[i] = val;
-                }
-                // #106172# setup remainder
-                for (; i < nTmpLen; i++)
-                    aArray[i] = 0;
+                // #106172# remainder (and anything the stream could not deliver) stays 0
+                aArray.resize(nTmpLen, 0);
+                ReadInt32Array(mrStream, aArray.data(), std::max<sal_Int32>(nAryLen, 0));
             }
             catch (std::bad_alloc&)
             {
@@ -1069,7 +1164,7 @@ rtl::Reference<MetaAction> SvmReader::GradientExHandler()
 
     VersionCompatRead aCompat(mrStream);
     tools::PolyPolygon aPolyPoly;
-    ReadPolyPolygon(mrStream, aPolyPoly);
+    ReadPolyPolygonBulk(mrStream, aPolyPoly);
     TypeSerializer aSerializer(mrStream);
     Gradient aGradient;
     aSerializer.readGradient(aGradient);
@@ -1086,7 +1181,7 @@ rtl::Reference<MetaAction> SvmReader::HatchHandler()
 
     VersionCompatRead aCompat(mrStream);
     tools::PolyPolygon aPolyPoly;
-    ReadPolyPolygon(mrStream, aPolyPoly);
+    ReadPolyPolygonBulk(mrStream, aPolyPoly);
     Hatch aHatch;
     ReadHatch(mrStream, aHatch);
 
@@ -1311,7 +1406,7 @@ rtl::Reference<MetaAction> SvmReader::TransparentHandler()
 
     VersionCompatRead aCompat(mrStream);
     tools::PolyPolygon aPolyPoly;
-    ReadPolyPolygon(mrStream, aPolyPoly);
+    ReadPolyPolygonBulk(mrStream, aPolyPoly);
     sal_uInt16 nTransPercent(0);
     mrStream.ReadUInt16(nTransPercent);
 
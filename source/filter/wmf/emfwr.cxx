@@ -628,15 +628,44 @@ void EMFWriter::ImplWriteSize( const Size& rSize)
 }
 
 void EMFWriter::ImplWriteRect( const tools::Rectangle& rRect )
+{
+    WmfRecordBuffer aBuffer( 16 );
+    ImplWriteRect( aBuffer, rRect );
+    aBuffer.flush( m_rStm );
+}
+
+void EMFWriter::ImplWriteRect( WmfRecordBuffer& rRecord, const tools::Rectangle& rRect )
 {
     const tools::Rectangle aRect( OutputDevice::LogicToLogic ( rRect, maVDev->GetMapMode(), maDestMapMode ));
     auto right = aRect.IsWidthEmpty() ? aRect.Left() : aRect.Right();
     auto bottom = aRect.IsHeightEmpty() ? aRect.Top() : aRect.Bottom();
-    m_rStm
-       .WriteInt32( aRect.Left() )
-       .WriteInt32( aRect.Top() )
-       .WriteInt32( right )
-       .WriteInt32( bottom );
+    rRecord.writeInt32( aRect.Left() );
+    rRecord.writeInt32( aRect.Top() );
+    rRecord.writeInt32( right );
+    rRecord.writeInt32( bottom );
+}
+
+void EMFWriter::ImplWritePoints( WmfRecordBuffer& rRecord, const tools::Polygon& rPoly )
+{
+    const MapMode& rSrcMapMode = maVDev->GetMapMode();
+    for( sal_uInt16 i = 0; i < rPoly.GetSize(); i++ )
+    {
+        const Point aPoint( OutputDevice::LogicToLogic( rPoly[ i ], rSrcMapMode, maDestMapMode ));
+        rRecord.writeInt32( aPoint.X() );
+        rRecord.writeInt32( aPoint.Y() );
+    }
+}
+
+void EMFWriter::ImplWriteRecord( WmfRecordBuffer& rRecord )
+{
+    SAL_WARN_IF( mbRecordOpen, "vcl", "Another record is already opened!" );
+
+    // each record has to be dword aligned
+    if( rRecord.size() & 2 )
+        rRecord.writeUInt16( 0 );
+    rRecord.patchUInt32( 4, rRecord.size() );
+    rRecord.flush( m_rStm );
+    mnRecordCount++;
 }
 
 void EMFWriter::ImplWritePolygonRecord( const tools::Polygon& rPoly, bool bClose )
@@ -653,20 +682,19 @@ void EMFWriter::ImplWritePolygonRecord( const tools::Polygon& rPoly, bool bClose
 
         ImplCheckLineAttr();
 
-        ImplBeginRecord( bClose ? WIN_EMR_POLYGON : WIN_EMR_POLYLINE );
-        ImplWriteRect( rPoly.GetBoundRect() );
-        m_rStm.WriteUInt32( rPoly.GetSize() );
-
-        for( sal_uInt16 i = 0; i < rPoly.GetSize(); i++ )
-            ImplWritePoint( rPoly[ i ] );
-
-        ImplEndRecord();
+        WmfRecordBuffer aRecord( 28 + 8 * size_t( rPoly.GetSize() ) );
+        aRecord.writeUInt32( bClose ? WIN_EMR_POLYGON : WIN_EMR_POLYLINE );
+        aRecord.writeUInt32( 0 ); // size, set by ImplWriteRecord
+        ImplWriteRect( aRecord, rPoly.GetBoundRect() );
+        aRecord.writeUInt32( rPoly.GetSize() );
+        ImplWritePoints( aRecord, rPoly );
+        ImplWriteRecord( aRecord );
     }
 }
 
 void EMFWriter::ImplWritePolyPolygonRecord( const tools::PolyPolygon& rPolyPoly )
 {
-    sal_uInt16 n, i, nPolyCount = rPolyPoly.Count();
+    sal_uInt16 i, nPolyCount = rPolyPoly.Count();
 
     if( !nPolyCount )
         return;
@@ -693,21 +721,20 @@ void EMFWriter::ImplWritePolyPolygonRecord( const tools::PolyPolygon& rPolyPoly
                 ImplCheckFillAttr();
                 ImplCheckLineAttr();
 
-                ImplBeginRecord( WIN_EMR_POLYPOLYGON );
-                ImplWriteRect( rPolyPoly.GetBoundRect() );
-                m_rStm.WriteUInt32( nPolyCount ).WriteUInt32( nTotalPoints );
+                WmfRecordBuffer aRecord( 32 + 4 * size_t( nPolyCount ) + 8 * size_t( nTotalPoints ) );
+                aRecord.writeUInt32( WIN_EMR_POLYPOLYGON );
+                aRecord.writeUInt32( 0 ); // size, set by ImplWriteRecord
+                ImplWriteRect( aRecord, rPolyPoly.GetBoundRect() );
+                aRecord.writeUInt32( nPolyCount );
+                aRecord.writeUInt32( nTotalPoints );
 
                 for( i = 0; i < nPolyCount; i++ )
-                    m_rStm.WriteUInt32( rPolyPoly[ i ].GetSize() );
+                    aRecord.writeUInt32( rPolyPoly[ i ].GetSize() );
 
                 for( i = 0; i < nPolyCount; i++ )
-                {
-                    const tools::Polygon& rPoly = rPolyPoly[ i ];
+                    ImplWritePoints( aRecord, rPolyPoly[ i ] );
 
-                    for( n = 0; n < rPoly.GetSize(); n++ )
-                        ImplWritePoint( rPoly[ n ] );
-                }
-                ImplEndRecord();
+                ImplWriteRecord( aRecord );
             }
         }
     }
@@ -23,6 +23,8 @@
 #include <vcl/gdimtf.hxx>
 #include <vcl/virdev.hxx>
 
+#include "wmfrecordbuffer.hxx"
+
 class LineInfo;
 namespace basegfx { class B2DPolygon; }
 enum class EmfPlusRecordType;
@@ -71,6 +73,9 @@ private:
     void                ImplWritePoint( const Point& rPoint );
     void                ImplWriteSize( const Size& rSize);
     void                ImplWriteRect( const tools::Rectangle& rRect );
+    void                ImplWriteRect( WmfRecordBuffer& rRecord, const tools::Rectangle& rRect );
+    void                ImplWritePoints( WmfRecordBuffer& rRecord, const tools::Polygon& rPoly );
+    void                ImplWriteRecord( WmfRecordBuffer& rRecord );
     void                ImplWritePath( const tools::PolyPolygon& rPolyPoly, bool bClose );
     void                ImplWritePolygonRecord( const tools::Polygon& rPoly, bool bClose );
     void                ImplWritePolyPolygonRecord( const tools::PolyPolygon& rPolyPoly );
@@ -0,0 +1,65 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <sal/types.h>
+#include <tools/stream.hxx>
+
+#include <vector>
+
+/**
+ * Assembles one WMF/EMF record in memory, so that it can be handed to the
+ * output stream with a single WriteBytes() call instead of one stream call
+ * per field, and without seeking back to patch the record size.
+ *
+ * Both formats are little endian, so the values are stored as such.
+ */
+class WmfRecordBuffer
+{
+    std::vector<sal_uInt8> maData;
+
+public:
+    explicit WmfRecordBuffer(size_t nReserve) { maData.reserve(nReserve); }
+
+    size_t size() const { return maData.size(); }
+
+    void writeUInt16(sal_uInt16 nValue)
+    {
+        maData.push_back(static_cast<sal_uInt8>(nValue));
+        maData.push_back(static_cast<sal_uInt8>(nValue >> 8));
+    }
+
+    void writeInt16(sal_Int16 nValue) { writeUInt16(static_cast<sal_uInt16>(nValue)); }
+
+    void writeUInt32(sal_uInt32 nValue)
+    {
+        writeUInt16(static_cast<sal_uInt16>(nValue));
+        writeUInt16(static_cast<sal_uInt16>(nValue >> 16));
+    }
+
+    void writeInt32(sal_Int32 nValue) { writeUInt32(static_cast<sal_uInt32>(nValue)); }
+
+    /// overwrite an already written value, e.g. the record size
+    void patchUInt32(size_t nPos, sal_uInt32 nValue)
+    {
+        maData[nPos] = static_cast<sal_uInt8>(nValue);
+        maData[nPos + 1] = static_cast<sal_uInt8>(nValue >> 8);
+        maData[nPos + 2] = static_cast<sal_uInt8>(nValue >> 16);
+        maData[nPos + 3] = static_cast<sal_uInt8>(nValue >> 24);
+    }
+
+    void flush(SvStream& rStream)
+    {
+        rStream.WriteBytes(maData.data(), maData.size());
+        maData.clear();
+    }
+};
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
@@ -218,6 +218,17 @@ void WMFWriter::WritePointXY(const Point & rPoint)
     pWMF->WriteInt16( aPt.X() ).WriteInt16( aPt.Y() );
 }
 
+void WMFWriter::WritePointsXY(WmfRecordBuffer & rRecord, const tools::Polygon & rPoly)
+{
+    const sal_uInt16 nSize = rPoly.GetSize();
+    for (sal_uInt16 i=0; i<nSize; ++i)
+    {
+        Point aPt( OutputDevice::LogicToLogic(rPoly.GetPoint(i),aSrcMapMode,aTargetMapMode) );
+        rRecord.writeInt16( aPt.X() );
+        rRecord.writeInt16( aPt.Y() );
+    }
+}
+
 void WMFWriter::WritePointYX(const Point & rPoint)
 {
     Point aPt( OutputDevice::LogicToLogic(rPoint,aSrcMapMode,aTargetMapMode) );
@@ -624,11 +635,7 @@ void WMFWriter::WMFRecord_Polygon(const tools::Polygon & rPoly)
         rPoly.AdaptiveSubdivide( aSimplePoly );
     else
         aSimplePoly = rPoly;
-    const sal_uInt16 nSize = aSimplePoly.GetSize();
-    WriteRecordHeader(static_cast<sal_uInt32>(nSize)*2+4,W_META_POLYGON);
-    pWMF->WriteUInt16( nSize );
-    for (sal_uInt16 i=0; i<nSize; ++i)
-        WritePointXY(aSimplePoly.GetPoint(i));
+    WritePolyRecord(aSimplePoly, W_META_POLYGON);
 }
 
 void WMFWriter::WMFRecord_PolyLine(const tools::Polygon & rPoly)
@@ -638,17 +645,29 @@ void WMFWriter::WMFRecord_PolyLine(const tools::Polygon & rPoly)
         rPoly.AdaptiveSubdivide( aSimplePoly );
     else
         aSimplePoly = rPoly;
-    const sal_uInt16 nSize = aSimplePoly.GetSize();
-    WriteRecordHeader(static_cast<sal_uInt32>(nSize)*2+4,W_META_POLYLINE);
-    pWMF->WriteUInt16( nSize );
-    for (sal_uInt16 i=0; i<nSize; ++i)
-        WritePointXY(aSimplePoly.GetPoint(i));
+    WritePolyRecord(aSimplePoly, W_META_POLYLINE);
+}
+
+void WMFWriter::WritePolyRecord(const tools::Polygon & rPoly, sal_uInt16 nType)
+{
+    const sal_uInt16 nSize = rPoly.GetSize();
+    const sal_uInt32 nSizeWords = static_cast<sal_uInt32>(nSize)*2+4;
+    if (nSizeWords>nMaxRecordSize) nMaxRecordSize=nSizeWords;
+
+    WmfRecordBuffer aRecord(nSizeWords*2);
+    aRecord.writeUInt32(nSizeWords);
+    aRecord.writeUInt16(nType);
+    aRecord.writeUInt16(nSize);
+    WritePointsXY(aRecord, rPoly);
+
+    nActRecordPos=pWMF->Tell();
+    aRecord.flush(*pWMF);
 }
 
 void WMFWriter::WMFRecord_PolyPolygon(const tools::PolyPolygon & rPolyPoly)
 {
-    const tools::Polygon * pPoly;
-    sal_uInt16 nCount,nSize,i,j;
+    sal_uInt16 nCount,i;
+    sal_uInt32 nTotalPoints = 0;
 
     nCount=rPolyPoly.Count();
     tools::PolyPolygon aSimplePolyPoly( rPolyPoly );
@@ -660,16 +679,22 @@ void WMFWriter::WMFRecord_PolyPolygon(const tools::PolyPolygon & rPolyPoly)
             aSimplePolyPoly[ i ].AdaptiveSubdivide( aSimplePoly );
             aSimplePolyPoly[ i ] = aSimplePoly;
         }
+        nTotalPoints += aSimplePolyPoly.GetObject(i).GetSize();
     }
-    WriteRecordHeader(0,W_META_POLYPOLYGON);
-    pWMF->WriteUInt16( nCount );
-    for (i=0; i<nCount; i++) pWMF->WriteUInt16( aSimplePolyPoly.GetObject(i).GetSize() );
-    for (i=0; i<nCount; i++) {
-        pPoly=&(aSimplePolyPoly.GetObject(i));
-        nSize=pPoly->GetSize();
-        for (j=0; j<nSize; j++) WritePointXY(pPoly->GetPoint(j));
-    }
-    UpdateRecordHeader();
+
+    // header, polygon count, point counts and the points themselves
+    const sal_uInt32 nSizeWords = 3 + 1 + nCount + 2*nTotalPoints;
+    if (nSizeWords>nMaxRecordSize) nMaxRecordSize=nSizeWords;
+
+    WmfRecordBuffer aRecord(nSizeWords*2);
+    aRecord.writeUInt32(nSizeWords);
+    aRecord.writeUInt16(W_META_POLYPOLYGON);
+    aRecord.writeUInt16(nCount);
+    for (i=0; i<nCount; i++) aRecord.writeUInt16(aSimplePolyPoly.GetObject(i).GetSize());
+    for (i=0; i<nCount; i++) WritePointsXY(aRecord, aSimplePolyPoly.GetObject(i));
+
+    nActRecordPos=pWMF->Tell();
+    aRecord.flush(*pWMF);
 }
 
 void WMFWriter::WMFRecord_Rectangle(const tools::Rectangle & rRect)
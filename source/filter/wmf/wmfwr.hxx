@@ -27,6 +27,8 @@
 #include <com/sun/star/task/XStatusIndicator.hpp>
 #include <tools/stream.hxx>
 
+#include "wmfrecordbuffer.hxx"
+
 #define MAXOBJECTHANDLES 16
 
 struct WMFWriterAttrStackMember
@@ -118,6 +120,7 @@ private:
         // be initialised to 0 at start, as this method is recursive)
 
     void WritePointXY(const Point & rPoint);
+    void WritePointsXY(WmfRecordBuffer & rRecord, const tools::Polygon & rPoly);
     void WritePointYX(const Point & rPoint);
     sal_Int32 ScaleWidth( sal_Int32 nDX );
     void WriteSize(const Size & rSize);
@@ -153,6 +156,7 @@ private:
     void WMFRecord_Pie(const tools::Rectangle & rRect, const Point & rStartPt, const Point & rEndPt);
     void WMFRecord_Polygon(const tools::Polygon & rPoly);
     void WMFRecord_PolyLine(const tools::Polygon & rPoly);
+    void WritePolyRecord(const tools::Polygon & rPoly, sal_uInt16 nType);
     void WMFRecord_PolyPolygon(const tools::PolyPolygon & rPolyPoly);
     void WMFRecord_Rectangle(const tools::Rectangle & rRect);
     void WMFRecord_RestoreDC();
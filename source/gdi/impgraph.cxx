@@ -51,6 +51,7 @@
 #include <vcl/TypeSerializer.hxx>
 #include <vcl/pdfread.hxx>
 #include <graphic/VectorGraphicLoader.hxx>
+#include <filter/SvmCompact.hxx>
 
 #define GRAPHIC_MTFTOBMP_MAXEXT     2048
 #define GRAPHIC_STREAMBUFSIZE       8192UL
@@ -1190,7 +1191,8 @@ bool ImpGraphic::swapOutGraphic(SvStream& rStream)
         {
             if(!rStream.GetError())
             {
-                SvmWriter aWriter(rStream);
+                // only read back by swapIn(), so the polygons can be written compactly
+                vcl::svm::CompactSvmWriter aWriter(rStream);
                 aWriter.Write(maMetaFile);
             }
         }
@@ -23,6 +23,7 @@
 
 #include <tools/stream.hxx>
 #include <regionband.hxx>
+#include <regionbandarray.hxx>
 #include <o3tl/safeint.hxx>
 #include <osl/diagnose.h>
 #include <sal/log.hxx>
@@ -953,26 +954,8 @@ void RegionBand::Intersect(tools::Long nLeft, tools::Long nTop, tools::Long nRig
 
 void RegionBand::Union(const RegionBand& rSource)
 {
-    // apply all rectangles from rSource to this
-    ImplRegionBand* pBand = rSource.mpFirstBand;
-
-    while ( pBand )
-    {
-        // insert bands if the boundaries are not already in the list
-        InsertBands(pBand->mnYTop, pBand->mnYBottom);
-
-        // process all elements of the list
-        ImplRegionBandSep* pSep = pBand->mpFirstSep;
-
-        while(pSep)
-        {
-            Union(pSep->mnXLeft, pBand->mnYTop, pSep->mnXRight, pBand->mnYBottom);
-            pSep = pSep->mpNextSep;
-        }
-
-        pBand = pBand->mpNextBand;
-    }
-
+    RegionBandArray(RegionBandArray(*this), RegionBandArray(rSource), RegionBandOperation::Union)
+        .ToRegionBand(*this);
 }
 
 void RegionBand::Exclude(tools::Long nLeft, tools::Long nTop, tools::Long nRight, tools::Long nBottom)
@@ -1059,114 +1042,16 @@ void RegionBand::XOr(tools::Long nLeft, tools::Long nTop, tools::Long nRight, to
 
 void RegionBand::Intersect(const RegionBand& rSource)
 {
-    // mark all bands as untouched
-    ImplRegionBand* pBand = mpFirstBand;
-
-    while ( pBand )
-    {
-        pBand->mbTouched = false;
-        pBand = pBand->mpNextBand;
-    }
-
-    pBand = rSource.mpFirstBand;
-
-    while ( pBand )
-    {
-        // insert bands if the boundaries are not already in the list
-        InsertBands( pBand->mnYTop, pBand->mnYBottom );
-
-        // process all elements of the list
-        ImplRegionBandSep* pSep = pBand->mpFirstSep;
-
-        while ( pSep )
-        {
-            // left boundary?
-            if ( pSep == pBand->mpFirstSep )
-            {
-                // process intersection and do not remove untouched bands
-                Exclude( LONG_MIN+1, pBand->mnYTop, pSep->mnXLeft-1, pBand->mnYBottom );
-            }
-
-            // right boundary?
-            if ( pSep->mpNextSep == nullptr )
-            {
-                // process intersection and do not remove untouched bands
-                Exclude( pSep->mnXRight+1, pBand->mnYTop, LONG_MAX-1, pBand->mnYBottom );
-            }
-            else
-            {
-                // process intersection and do not remove untouched bands
-                Exclude( pSep->mnXRight+1, pBand->mnYTop, pSep->mpNextSep->mnXLeft-1, pBand->mnYBottom );
-            }
-
-            pSep = pSep->mpNextSep;
-        }
-
-        pBand = pBand->mpNextBand;
-    }
-
-    // remove all untouched bands if bands already left
-    ImplRegionBand* pPrevBand = nullptr;
-    pBand = mpFirstBand;
-
-    while ( pBand )
-    {
-        if ( !pBand->mbTouched )
-        {
-            // save pointer
-            ImplRegionBand* pOldBand = pBand;
-
-            // previous element of the list
-            if ( pBand == mpFirstBand )
-            {
-                mpFirstBand = pBand->mpNextBand;
-            }
-            else
-            {
-                pPrevBand->mpNextBand = pBand->mpNextBand;
-            }
-
-            pBand = pBand->mpNextBand;
-            delete pOldBand;
-        }
-        else
-        {
-            pPrevBand = pBand;
-            pBand = pBand->mpNextBand;
-        }
-    }
-
+    RegionBandArray(RegionBandArray(*this), RegionBandArray(rSource),
+                    RegionBandOperation::Intersect)
+        .ToRegionBand(*this);
 }
 
 bool RegionBand::Exclude(const RegionBand& rSource)
 {
-    // apply all rectangles to the region passed to this region
-    ImplRegionBand* pBand = rSource.mpFirstBand;
-
-    while ( pBand )
-    {
-        // insert bands if the boundaries are not already in the list
-        InsertBands( pBand->mnYTop, pBand->mnYBottom );
-
-        // process all elements of the list
-        ImplRegionBandSep* pSep = pBand->mpFirstSep;
-
-        while ( pSep )
-        {
-            Exclude( pSep->mnXLeft, pBand->mnYTop, pSep->mnXRight, pBand->mnYBottom );
-            pSep = pSep->mpNextSep;
-        }
-
-        // to test less bands, already check in the loop
-        if ( !OptimizeBandList() )
-        {
-            return false;
-        }
-
-        pBand = pBand->mpNextBand;
-    }
-
-    return true;
+    RegionBandArray(RegionBandArray(*this), RegionBandArray(rSource), RegionBandOperation::Exclude)
+        .ToRegionBand(*this);
+    return mpFirstBand != nullptr;
 }
 
 bool RegionBand::CheckConsistency() const
@@ -1210,24 +1095,8 @@ tools::Rectangle RegionBand::GetBoundRect() const
 
 void RegionBand::XOr(const RegionBand& rSource)
 {
-    ImplRegionBand* pBand = rSource.mpFirstBand;
-
-    while ( pBand )
-    {
-        // insert bands if the boundaries are not already in the list
-        InsertBands( pBand->mnYTop, pBand->mnYBottom );
-
-        // process all elements of the list
-        ImplRegionBandSep* pSep = pBand->mpFirstSep;
-
-        while ( pSep )
-        {
-            XOr( pSep->mnXLeft, pBand->mnYTop, pSep->mnXRight, pBand->mnYBottom );
-            pSep = pSep->mpNextSep;
-        }
-
-        pBand = pBand->mpNextBand;
-    }
+    RegionBandArray(RegionBandArray(*this), RegionBandArray(rSource), RegionBandOperation::XOr)
+        .ToRegionBand(*this);
 }
 
 bool RegionBand::Contains(const Point& rPoint) const
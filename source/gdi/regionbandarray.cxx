@@ -0,0 +1,232 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4; fill-column: 100 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <sal/config.h>
+
+#include <regionbandarray.hxx>
+#include <regionband.hxx>
+
+#include <o3tl/safeint.hxx>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace
+{
+constexpr tools::Long MaxCoordinate = std::numeric_limits<tools::Long>::max();
+
+bool isInside(RegionBandOperation eOperation, bool bInFirst, bool bInSecond)
+{
+    switch (eOperation)
+    {
+        case RegionBandOperation::Union:
+            return bInFirst || bInSecond;
+        case RegionBandOperation::Intersect:
+            return bInFirst && bInSecond;
+        case RegionBandOperation::Exclude:
+            return bInFirst && !bInSecond;
+        case RegionBandOperation::XOr:
+            return bInFirst != bInSecond;
+    }
+    return false;
+}
+}
+
+RegionBandArray::RegionBandArray(const RegionBand& rRegionBand)
+{
+    for (const ImplRegionBand* pBand = rRegionBand.ImplGetFirstRegionBand(); pBand;
+         pBand = pBand->mpNextBand)
+    {
+        // a band may still touch the previous one before RegionBand::OptimizeBandList(), which
+        // then moves the bottom of the previous one up, and drops it if nothing is left of it
+        while (!maBands.empty() && pBand->mnYTop <= maBands.back().mnYBottom)
+        {
+            Band& rLast = maBands.back();
+            rLast.mnYBottom = pBand->mnYTop - 1;
+            if (rLast.mnYBottom >= rLast.mnYTop)
+                break;
+            maSeps.resize(rLast.mnFirstSep);
+            maBands.pop_back();
+        }
+
+        const sal_uInt32 nFirstSep = maSeps.size();
+        for (const ImplRegionBandSep* pSep = pBand->mpFirstSep; pSep; pSep = pSep->mpNextSep)
+        {
+            if (!pSep->mbRemoved && pSep->mnXLeft <= pSep->mnXRight)
+                appendSep(nFirstSep, pSep->mnXLeft, pSep->mnXRight);
+        }
+        appendBand(pBand->mnYTop, pBand->mnYBottom, nFirstSep);
+    }
+}
+
+RegionBandArray::RegionBandArray(const RegionBandArray& rFirst, const RegionBandArray& rSecond,
+                                 RegionBandOperation eOperation)
+{
+    maBands.reserve(rFirst.maBands.size() + rSecond.maBands.size());
+    maSeps.reserve(rFirst.maSeps.size() + rSecond.maSeps.size());
+
+    auto itFirst = rFirst.maBands.begin();
+    auto itSecond = rSecond.maBands.begin();
+    const auto itFirstEnd = rFirst.maBands.end();
+    const auto itSecondEnd = rSecond.maBands.end();
+
+    tools::Long nY = std::min(itFirst != itFirstEnd ? itFirst->mnYTop : MaxCoordinate,
+                              itSecond != itSecondEnd ? itSecond->mnYTop : MaxCoordinate);
+    while (itFirst != itFirstEnd || itSecond != itSecondEnd)
+    {
+        const bool bInFirst = itFirst != itFirstEnd && itFirst->mnYTop <= nY;
+        const bool bInSecond = itSecond != itSecondEnd && itSecond->mnYTop <= nY;
+
+        // the rows from nY to nYBottom are in the same bands of both
+        tools::Long nYBottom = MaxCoordinate;
+        if (itFirst != itFirstEnd)
+            nYBottom = std::min(nYBottom, bInFirst ? itFirst->mnYBottom : itFirst->mnYTop - 1);
+        if (itSecond != itSecondEnd)
+            nYBottom = std::min(nYBottom, bInSecond ? itSecond->mnYBottom : itSecond->mnYTop - 1);
+
+        if (bInFirst || bInSecond)
+        {
+            const sal_uInt32 nFirstSep = maSeps.size();
+            const Sep* pFirst = rFirst.maSeps.data();
+            const Sep* pSecond = rSecond.maSeps.data();
+            combineSeps(bInFirst ? pFirst + itFirst->mnFirstSep : nullptr,
+                        bInFirst ? pFirst + itFirst->mnEndSep : nullptr,
+                        bInSecond ? pSecond + itSecond->mnFirstSep : nullptr,
+                        bInSecond ? pSecond + itSecond->mnEndSep : nullptr, eOperation);
+            appendBand(nY, nYBottom, nFirstSep);
+        }
+
+        if (bInFirst && itFirst->mnYBottom == nYBottom)
+            ++itFirst;
+        if (bInSecond && itSecond->mnYBottom == nYBottom)
+            ++itSecond;
+        if (nYBottom == MaxCoordinate)
+            break;
+        nY = nYBottom + 1;
+    }
+}
+
+void RegionBandArray::combineSeps(const Sep* pFirst, const Sep* pFirstEnd, const Sep* pSecond,
+                                  const Sep* pSecondEnd, RegionBandOperation eOperation)
+{
+    const sal_uInt32 nFirstSep = maSeps.size();
+
+    // walk the x positions where the inside of one of them begins or ends
+    bool bInFirst = false;
+    bool bInSecond = false;
+    bool bInside = false;
+    tools::Long nXLeft = 0;
+    while (pFirst != pFirstEnd || pSecond != pSecondEnd)
+    {
+        const bool bFirstLeft = pFirst != pFirstEnd;
+        const bool bSecondLeft = pSecond != pSecondEnd;
+        const tools::Long nFirstX
+            = !bFirstLeft ? MaxCoordinate
+                          : bInFirst ? o3tl::saturating_add<tools::Long>(pFirst->mnXRight, 1)
+                                     : pFirst->mnXLeft;
+        const tools::Long nSecondX
+            = !bSecondLeft ? MaxCoordinate
+                           : bInSecond ? o3tl::saturating_add<tools::Long>(pSecond->mnXRight, 1)
+                                       : pSecond->mnXLeft;
+        const tools::Long nX = std::min(nFirstX, nSecondX);
+
+        if (bFirstLeft && nFirstX == nX)
+        {
+            if (bInFirst)
+                ++pFirst;
+            bInFirst = !bInFirst;
+        }
+        if (bSecondLeft && nSecondX == nX)
+        {
+            if (bInSecond)
+                ++pSecond;
+            bInSecond = !bInSecond;
+        }
+
+        const bool bNowInside = isInside(eOperation, bInFirst, bInSecond);
+        if (bNowInside != bInside)
+        {
+            if (bNowInside)
+                nXLeft = nX;
+            else
+                appendSep(nFirstSep, nXLeft, nX - 1);
+            bInside = bNowInside;
+        }
+    }
+    assert(!bInside && "outside of both at the end");
+}
+
+void RegionBandArray::appendSep(sal_uInt32 nFirstSep, tools::Long nXLeft, tools::Long nXRight)
+{
+    if (maSeps.size() > nFirstSep
+        && o3tl::saturating_add<tools::Long>(maSeps.back().mnXRight, 1) >= nXLeft)
+    {
+        maSeps.back().mnXRight = std::max(maSeps.back().mnXRight, nXRight);
+        return;
+    }
+    maSeps.push_back({ nXLeft, nXRight });
+}
+
+void RegionBandArray::appendBand(tools::Long nYTop, tools::Long nYBottom, sal_uInt32 nFirstSep)
+{
+    const sal_uInt32 nEndSep = maSeps.size();
+    if (nFirstSep == nEndSep)
+        return;
+
+    if (!maBands.empty())
+    {
+        Band& rLast = maBands.back();
+        if (rLast.mnYBottom == nYTop - 1
+            && rLast.mnEndSep - rLast.mnFirstSep == nEndSep - nFirstSep
+            && std::equal(maSeps.begin() + rLast.mnFirstSep, maSeps.begin() + rLast.mnEndSep,
+                          maSeps.begin() + nFirstSep, [](const Sep& rA, const Sep& rB) {
+                              return rA.mnXLeft == rB.mnXLeft && rA.mnXRight == rB.mnXRight;
+                          }))
+        {
+            rLast.mnYBottom = nYBottom;
+            maSeps.resize(nFirstSep);
+            return;
+        }
+    }
+    maBands.push_back({ nYTop, nYBottom, nFirstSep, nEndSep });
+}
+
+void RegionBandArray::ToRegionBand(RegionBand& rRegionBand) const
+{
+    rRegionBand.implReset();
+
+    ImplRegionBand* pPrevBand = nullptr;
+    for (const Band& rBand : maBands)
+    {
+        ImplRegionBand* pNewBand = new ImplRegionBand(rBand.mnYTop, rBand.mnYBottom);
+        ImplRegionBandSep* pPrevSep = nullptr;
+        for (sal_uInt32 i = rBand.mnFirstSep; i < rBand.mnEndSep; ++i)
+        {
+            ImplRegionBandSep* pNewSep = new ImplRegionBandSep;
+            pNewSep->mnXLeft = maSeps[i].mnXLeft;
+            pNewSep->mnXRight = maSeps[i].mnXRight;
+            pNewSep->mbRemoved = false;
+            pNewSep->mpNextSep = nullptr;
+            if (pPrevSep)
+                pPrevSep->mpNextSep = pNewSep;
+            else
+                pNewBand->mpFirstSep = pNewSep;
+            pPrevSep = pNewSep;
+        }
+
+        if (pPrevBand)
+            pPrevBand->mpNextBand = pNewBand;
+        else
+            rRegionBand.mpFirstBand = pNewBand;
+        pPrevBand = pNewBand;
+    }
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab: */
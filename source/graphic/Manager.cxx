@@ -18,6 +18,7 @@
  */
 
 #include <graphic/Manager.hxx>
+#include <bitmap/BitmapBufferPool.hxx>
 #include <impgraph.hxx>
 #include <sal/log.hxx>
 
@@ -127,6 +128,9 @@ void Manager::reduceGraphicMemory(std::unique_lock<std::mutex>& rGuard)
         return;
     mbReducingGraphicMemory = true;
 
+    // the pixel memory kept for temporary bitmaps goes first
+    vcl::bitmap::BitmapBufferPool::get().Trim();
+
     loopGraphicsAndSwapOut(rGuard);
 
     sal_Int64 calculatedSize = 0;
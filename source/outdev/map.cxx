@@ -282,6 +282,101 @@ static tools::Long ImplPixelToLogic(tools::Long n, tools::Long nDPI, tools::Long
     return n;
 }
 
+namespace
+{
+/*
+ImplLogicToPixel() of one axis with the scale factors worked out once, for converting many
+points. The 64 bit division per coordinate is what takes the time there: this multiplies with
+the reciprocal of the denominator instead and corrects the quotient by its remainder, so the
+result (and the rounding) is exactly the one of ImplLogicToPixel(). Scales by whole numbers
+need just a multiplication.
+*/
+class LogicToPixelScale
+{
+public:
+    LogicToPixelScale(tools::Long nMapOfs, tools::Long nDPI, tools::Long nMapNum,
+                      tools::Long nMapDenom, tools::Long nPixelOfs)
+        : mnMapOfs(nMapOfs)
+        , mnPixelOfs(nPixelOfs)
+        , mnDPI(nDPI)
+        , mnMapNum(nMapNum)
+        , mnMapDenom(nMapDenom)
+    {
+        assert(nDPI > 0);
+        assert(nMapDenom != 0);
+        sal_Int64 nMul = static_cast<sal_Int64>(nMapNum) * nDPI;
+        sal_Int64 nDenom = nMapDenom;
+        if (nDenom < 0)
+        {
+            nMul = -nMul;
+            nDenom = -nDenom;
+        }
+        mnMul = nMul;
+        mnDenom = nDenom;
+        mbWhole = nMul % nDenom == 0;
+        mnFactor = mbWhole ? nMul / nDenom : 0;
+        mfInvDenom = 1.0 / nDenom;
+        // below 2^51 the quotient in double is off by less than one
+        mnMaxFast = nMul == 0 ? 0 : (sal_Int64(1) << 50) / std::abs(nMul);
+    }
+
+    tools::Long operator()(tools::Long n) const
+    {
+        n += mnMapOfs;
+        if (mbWhole)
+            return static_cast<tools::Long>(n * mnFactor) + mnPixelOfs;
+        if (std::abs(n) > mnMaxFast)
+            return ImplLogicToPixel(n, mnDPI, mnMapNum, mnMapDenom) + mnPixelOfs;
+
+        const sal_Int64 nValue = 2 * static_cast<sal_Int64>(n) * mnMul;
+        sal_Int64 nQuot = static_cast<sal_Int64>(std::floor(nValue * mfInvDenom));
+        sal_Int64 nRem = nValue - nQuot * mnDenom;
+        if (nRem < 0)
+        {
+            --nQuot;
+            nRem += mnDenom;
+        }
+        else if (nRem >= mnDenom)
+        {
+            ++nQuot;
+            nRem -= mnDenom;
+        }
+        // that is the floored quotient, the division in ImplLogicToPixel() truncates
+        if (nValue < 0 && nRem != 0)
+            ++nQuot;
+        nQuot += nQuot < 0 ? -1 : 1;
+        return static_cast<tools::Long>(nQuot / 2) + mnPixelOfs;
+    }
+
+private:
+    tools::Long mnMapOfs;
+    tools::Long mnPixelOfs;
+    // for the coordinates too far out for the fast way
+    tools::Long mnDPI;
+    tools::Long mnMapNum;
+    tools::Long mnMapDenom;
+
+    sal_Int64 mnMul;
+    sal_Int64 mnDenom;
+    sal_Int64 mnFactor;
+    sal_Int64 mnMaxFast;
+    double mfInvDenom;
+    bool mbWhole;
+};
+
+void ImplLogicToPixelPoly(tools::Polygon& rPoly, const LogicToPixelScale& rScaleX,
+                          const LogicToPixelScale& rScaleY)
+{
+    const sal_uInt16 nPoints = rPoly.GetSize();
+    if (!nPoints)
+        return;
+
+    Point* pPoints = rPoly.GetPointAry();
+    for (sal_uInt16 i = 0; i < nPoints; ++i)
+        pPoints[i] = Point(rScaleX(pPoints[i].X()), rScaleY(pPoints[i].Y()));
+}
+}
+
 tools::Long OutputDevice::ImplLogicXToDevicePixel( tools::Long nX ) const
 {
     if ( !mbMap )
@@ -414,15 +509,11 @@ tools::Polygon OutputDevice::ImplLogicToDevicePixel( const tools::Polygon& rLogi
 
     if ( mbMap )
     {
-        for ( i = 0; i < nPoints; i++ )
-        {
-            const Point& rPt = pPointAry[i];
-            Point aPt(ImplLogicToPixel( rPt.X()+maMapRes.mnMapOfsX, mnDPIX,
-                                        maMapRes.mnMapScNumX, maMapRes.mnMapScDenomX )+mnOutOffX+mnOutOffOrigX,
-                      ImplLogicToPixel( rPt.Y()+maMapRes.mnMapOfsY, mnDPIY,
-                                        maMapRes.mnMapScNumY, maMapRes.mnMapScDenomY )+mnOutOffY+mnOutOffOrigY);
-            aPoly[i] = aPt;
-        }
+        ImplLogicToPixelPoly( aPoly,
+            LogicToPixelScale( maMapRes.mnMapOfsX, mnDPIX, maMapRes.mnMapScNumX,
+                               maMapRes.mnMapScDenomX, mnOutOffX+mnOutOffOrigX ),
+            LogicToPixelScale( maMapRes.mnMapOfsY, mnDPIY, maMapRes.mnMapScNumY,
+                               maMapRes.mnMapScDenomY, mnOutOffY+mnOutOffOrigY ) );
     }
     else
     {
@@ -533,6 +624,17 @@ tools::PolyPolygon OutputDevice::ImplLogicToDevicePixel( const tools::PolyPolygo
 
     tools::PolyPolygon aPolyPoly( rLogicPolyPoly );
     sal_uInt16      nPoly = aPolyPoly.Count();
+    if ( mbMap )
+    {
+        const LogicToPixelScale aScaleX( maMapRes.mnMapOfsX, mnDPIX, maMapRes.mnMapScNumX,
+                                         maMapRes.mnMapScDenomX, mnOutOffX+mnOutOffOrigX );
+        const LogicToPixelScale aScaleY( maMapRes.mnMapOfsY, mnDPIY, maMapRes.mnMapScNumY,
+                                         maMapRes.mnMapScDenomY, mnOutOffY+mnOutOffOrigY );
+        for( sal_uInt16 i = 0; i < nPoly; i++ )
+            ImplLogicToPixelPoly( aPolyPoly[i], aScaleX, aScaleY );
+        return aPolyPoly;
+    }
+
     for( sal_uInt16 i = 0; i < nPoly; i++ )
     {
         tools::Polygon& rPoly = aPolyPoly[i];
@@ -952,24 +1054,12 @@ tools::Polygon OutputDevice::LogicToPixel( const tools::Polygon& rLogicPoly ) co
     if ( !mbMap )
         return rLogicPoly;
 
-    sal_uInt16  i;
-    sal_uInt16  nPoints = rLogicPoly.GetSize();
     tools::Polygon aPoly( rLogicPoly );
-
-    // get pointer to Point-array (copy data)
-    const Point* pPointAry = aPoly.GetConstPointAry();
-
-    for ( i = 0; i < nPoints; i++ )
-    {
-        const Point* pPt = &(pPointAry[i]);
-        Point aPt;
-        aPt.setX( ImplLogicToPixel( pPt->X() + maMapRes.mnMapOfsX, mnDPIX,
-                                    maMapRes.mnMapScNumX, maMapRes.mnMapScDenomX )+mnOutOffOrigX );
-        aPt.setY( ImplLogicToPixel( pPt->Y() + maMapRes.mnMapOfsY, mnDPIY,
-                                    maMapRes.mnMapScNumY, maMapRes.mnMapScDenomY )+mnOutOffOrigY );
-        aPoly[i] = aPt;
-    }
-
+    ImplLogicToPixelPoly( aPoly,
+        LogicToPixelScale( maMapRes.mnMapOfsX, mnDPIX, maMapRes.mnMapScNumX,
+                           maMapRes.mnMapScDenomX, mnOutOffOrigX ),
+        LogicToPixelScale( maMapRes.mnMapOfsY, mnDPIY, maMapRes.mnMapScNumY,
+                           maMapRes.mnMapScDenomY, mnOutOffOrigY ) );
     return aPoly;
 }
 
@@ -979,13 +1069,14 @@ tools::PolyPolygon OutputDevice::LogicToPixel( const tools::PolyPolygon& rLogicP
     if ( !mbMap )
         return rLogicPolyPoly;
 
+    const LogicToPixelScale aScaleX( maMapRes.mnMapOfsX, mnDPIX, maMapRes.mnMapScNumX,
+                                     maMapRes.mnMapScDenomX, mnOutOffOrigX );
+    const LogicToPixelScale aScaleY( maMapRes.mnMapOfsY, mnDPIY, maMapRes.mnMapScNumY,
+                                     maMapRes.mnMapScDenomY, mnOutOffOrigY );
     tools::PolyPolygon aPolyPoly( rLogicPolyPoly );
     sal_uInt16      nPoly = aPolyPoly.Count();
     for( sal_uInt16 i = 0; i < nPoly; i++ )
-    {
-        tools::Polygon& rPoly = aPolyPoly[i];
-        rPoly = LogicToPixel( rPoly );
-    }
+        ImplLogicToPixelPoly( aPolyPoly[i], aScaleX, aScaleY );
     return aPolyPoly;
 }
 
@@ -1102,24 +1193,12 @@ tools::Polygon OutputDevice::LogicToPixel( const tools::Polygon& rLogicPoly,
     ImplMapRes          aMapRes;
     ImplCalcMapResolution(rMapMode, mnDPIX, mnDPIY, aMapRes);
 
-    sal_uInt16  i;
-    sal_uInt16  nPoints = rLogicPoly.GetSize();
     tools::Polygon aPoly( rLogicPoly );
-
-    // get pointer to Point-array (copy data)
-    const Point* pPointAry = aPoly.GetConstPointAry();
-
-    for ( i = 0; i < nPoints; i++ )
-    {
-        const Point* pPt = &(pPointAry[i]);
-        Point aPt;
-        aPt.setX( ImplLogicToPixel( pPt->X() + aMapRes.mnMapOfsX, mnDPIX,
-                                    aMapRes.mnMapScNumX, aMapRes.mnMapScDenomX )+mnOutOffOrigX );
-        aPt.setY( ImplLogicToPixel( pPt->Y() + aMapRes.mnMapOfsY, mnDPIY,
-                                    aMapRes.mnMapScNumY, aMapRes.mnMapScDenomY )+mnOutOffOrigY );
-        aPoly[i] = aPt;
-    }
-
+    ImplLogicToPixelPoly( aPoly,
+        LogicToPixelScale( aMapRes.mnMapOfsX, mnDPIX, aMapRes.mnMapScNumX,
+                           aMapRes.mnMapScDenomX, mnOutOffOrigX ),
+        LogicToPixelScale( aMapRes.mnMapOfsY, mnDPIY, aMapRes.mnMapScNumY,
+                           aMapRes.mnMapScDenomY, mnOutOffOrigY ) );
     return aPoly;
 }
 
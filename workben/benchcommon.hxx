@@ -0,0 +1,147 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4; fill-column: 100 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/* The command line and the output of the benchmarks, which all take
+
+        [--<sizes> N,...] [--repeat N] [--only NAME,...] [FILE]
+
+   and write their timings as JSON to FILE, or to stdout without FILE or with --.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+struct BenchOptions
+{
+    std::vector<int> maSizes;
+    int mnRepeat = 5;
+    std::vector<std::string> maOnly;
+    std::string maFilename;
+};
+
+std::vector<std::string> splitList(std::string_view aList)
+{
+    std::vector<std::string> aItems;
+    while (!aList.empty())
+    {
+        const size_t nComma = std::min(aList.find(','), aList.size());
+        if (nComma != 0)
+            aItems.emplace_back(aList.substr(0, nComma));
+        aList.remove_prefix(std::min(nComma + 1, aList.size()));
+    }
+    return aItems;
+}
+
+/** Parses the arguments into rOptions, which comes with the defaults.
+
+    @return the exit code if the benchmark is not to run, after --help or an invalid argument.
+*/
+std::optional<int> parseBenchOptions(int argc, char** argv, std::string_view aSizesOption,
+                                     BenchOptions& rOptions, void (*pShowHelp)())
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view aArg(argv[i]);
+        if (aArg == "--help" || aArg == "-h")
+        {
+            pShowHelp();
+            return 0;
+        }
+        else if (aArg == aSizesOption && i + 1 < argc)
+        {
+            rOptions.maSizes.clear();
+            for (const std::string& rSize : splitList(argv[++i]))
+                rOptions.maSizes.push_back(std::max(1, std::atoi(rSize.c_str())));
+        }
+        else if (aArg == "--repeat" && i + 1 < argc)
+            rOptions.mnRepeat = std::max(1, std::atoi(argv[++i]));
+        else if (aArg == "--only" && i + 1 < argc)
+            rOptions.maOnly = splitList(argv[++i]);
+        else if (aArg != "--" && rOptions.maFilename.empty() && aArg.substr(0, 1) != "-")
+            rOptions.maFilename = aArg;
+        else if (aArg != "--")
+        {
+            std::cerr << "invalid argument: " << aArg << "\n";
+            pShowHelp();
+            return 1;
+        }
+    }
+    return {};
+}
+
+bool wantsBench(const BenchOptions& rOptions, std::string_view aName)
+{
+    return rOptions.maOnly.empty()
+           || std::find(rOptions.maOnly.begin(), rOptions.maOnly.end(), aName)
+                  != rOptions.maOnly.end();
+}
+
+/// rTimes are sorted.
+double getMedian(const std::vector<double>& rTimes) { return rTimes[rTimes.size() / 2]; }
+
+/// Writes the statistics of the sorted rTimes as fields of a JSON object.
+void writeTimes(std::ostream& rStream, const std::vector<double>& rTimes)
+{
+    const double fMean = std::accumulate(rTimes.begin(), rTimes.end(), 0.0) / rTimes.size();
+    rStream << "\"min_ms\": " << rTimes.front() << ", \"median_ms\": " << getMedian(rTimes)
+            << ", \"mean_ms\": " << fMean << ", \"max_ms\": " << rTimes.back();
+}
+
+/** Writes the JSON document with rWriteHeader adding fields after "version" and "repeat", and
+    rWriteResult writing result nIndex of nCount as the fields of its object.
+
+    @return false if the file could not be written.
+*/
+bool writeBenchJson(const BenchOptions& rOptions,
+                    const std::function<void(std::ostream&)>& rWriteHeader, size_t nCount,
+                    const std::function<void(std::ostream&, size_t)>& rWriteResult)
+{
+    std::ofstream aFile;
+    if (!rOptions.maFilename.empty())
+    {
+        aFile.open(rOptions.maFilename, std::ios::out | std::ios::trunc);
+        if (!aFile)
+        {
+            std::cerr << "can not create file: " << rOptions.maFilename << "\n";
+            return false;
+        }
+    }
+    std::ostream& rStream = rOptions.maFilename.empty() ? std::cout : aFile;
+
+    // the names are all plain ASCII, nothing needs escaping
+    rStream << std::fixed << std::setprecision(4);
+    rStream << "{\n  \"version\": 1,\n  \"repeat\": " << rOptions.mnRepeat;
+    if (rWriteHeader)
+        rWriteHeader(rStream);
+    rStream << ",\n  \"results\": [";
+    for (size_t i = 0; i < nCount; ++i)
+    {
+        rStream << (i == 0 ? "\n" : ",\n") << "    { ";
+        rWriteResult(rStream, i);
+        rStream << " }";
+    }
+    rStream << "\n  ]\n}\n";
+    return rStream.good();
+}
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab cinoptions=b1,g0,N-s cinkeys+=0=break: */
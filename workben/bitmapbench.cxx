@@ -0,0 +1,433 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4; fill-column: 100 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/* Times the bitmap operations and writes the results as JSON, e.g.
+
+        make Executable_bitmapbench
+        cp workdir/LinkTarget/Executable/bitmapbench instdir/program
+        instdir/program/bitmapbench --sizes 256,2048 --repeat 9 results.json
+
+   It runs headless, with the svp backend unless SAL_USE_VCLPLUGIN says otherwise. The timings
+   are in milliseconds per call of the operation; the input is made anew before each call and
+   that is not timed. Compare results of the same machine and build type only.
+*/
+
+#include <sal/main.h>
+#include <cppuhelper/bootstrap.hxx>
+#include <comphelper/processfactory.hxx>
+#include <i18nlangtag/languagetag.hxx>
+#include <i18nlangtag/mslangid.hxx>
+#include <rtl/ustring.hxx>
+#include <tools/degree.hxx>
+
+#include <com/sun/star/lang/XComponent.hpp>
+#include <com/sun/star/lang/XMultiServiceFactory.hpp>
+#include <com/sun/star/uno/XComponentContext.hpp>
+
+#include <vcl/alpha.hxx>
+#include <vcl/bitmap.hxx>
+#include <vcl/bitmapex.hxx>
+#include <vcl/BitmapBasicMorphologyFilter.hxx>
+#include <vcl/BitmapColorQuantizationFilter.hxx>
+#include <vcl/BitmapDuoToneFilter.hxx>
+#include <vcl/BitmapEmbossGreyFilter.hxx>
+#include <vcl/BitmapFilterStackBlur.hxx>
+#include <vcl/BitmapGaussianSeparableBlurFilter.hxx>
+#include <vcl/BitmapMedianFilter.hxx>
+#include <vcl/BitmapMonochromeFilter.hxx>
+#include <vcl/BitmapMosaicFilter.hxx>
+#include <vcl/BitmapPopArtFilter.hxx>
+#include <vcl/BitmapSepiaFilter.hxx>
+#include <vcl/BitmapSeparableUnsharpenFilter.hxx>
+#include <vcl/BitmapSharpenFilter.hxx>
+#include <vcl/BitmapSimpleColorQuantizationFilter.hxx>
+#include <vcl/BitmapSmoothenFilter.hxx>
+#include <vcl/BitmapSobelGreyFilter.hxx>
+#include <vcl/BitmapSolarizeFilter.hxx>
+#include <vcl/svapp.hxx>
+
+#include <bitmap/BitmapDisabledImageFilter.hxx>
+#include <bitmap/BitmapFilterPipeline.hxx>
+#include <bitmap/BitmapLightenFilter.hxx>
+#include <bitmap/BitmapWriteAccess.hxx>
+#include <salinst.hxx>
+#include <svdata.hxx>
+
+#include "benchcommon.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+struct Result
+{
+    std::string maGroup;
+    std::string maName;
+    Size maSize;
+    int mnBitCount;
+    std::vector<double> maTimes; // milliseconds, sorted
+};
+
+struct NamedFilter
+{
+    const char* mpName;
+    std::function<std::unique_ptr<BitmapFilter>()> mfnCreate;
+};
+
+/// Gradients with some high frequency noise, so that neither scaling nor quantizing is trivial.
+Bitmap createBitmap(const Size& rSize, vcl::PixelFormat ePixelFormat)
+{
+    const BitmapPalette aGreyPalette = Bitmap::GetGreyPalette(256);
+    Bitmap aBitmap(rSize, ePixelFormat,
+                   ePixelFormat == vcl::PixelFormat::N8_BPP ? &aGreyPalette : nullptr);
+    BitmapScopedWriteAccess pAccess(aBitmap);
+    const tools::Long nWidth = pAccess->Width();
+    const tools::Long nHeight = pAccess->Height();
+    for (tools::Long nY = 0; nY < nHeight; ++nY)
+    {
+        Scanline pScanline = pAccess->GetScanline(nY);
+        for (tools::Long nX = 0; nX < nWidth; ++nX)
+        {
+            const sal_uInt8 nR = nX * 255 / nWidth;
+            const sal_uInt8 nG = nY * 255 / nHeight;
+            const sal_uInt8 nB = ((nX * 7 + nY * 13) ^ (nX * nY)) & 0xff;
+            if (ePixelFormat == vcl::PixelFormat::N8_BPP)
+                pAccess->SetPixelOnData(pScanline, nX, BitmapColor(sal_uInt8((nR + nG + nB) / 3)));
+            else if (ePixelFormat == vcl::PixelFormat::N32_BPP)
+                pAccess->SetPixelOnData(pScanline, nX,
+                                        BitmapColor(ColorAlpha, nR, nG, nB, 255 - (nX & 0x7f)));
+            else
+                pAccess->SetPixelOnData(pScanline, nX, BitmapColor(nR, nG, nB));
+        }
+    }
+    return aBitmap;
+}
+
+AlphaMask createAlpha(const Size& rSize)
+{
+    AlphaMask aAlpha(rSize);
+    AlphaScopedWriteAccess pAccess(aAlpha);
+    const tools::Long nWidth = pAccess->Width();
+    const tools::Long nHeight = pAccess->Height();
+    for (tools::Long nY = 0; nY < nHeight; ++nY)
+    {
+        Scanline pScanline = pAccess->GetScanline(nY);
+        for (tools::Long nX = 0; nX < nWidth; ++nX)
+            pAccess->SetPixelOnData(pScanline, nX,
+                                    BitmapColor(sal_uInt8((nX + nY) * 255 / (nWidth + nHeight))));
+    }
+    return aAlpha;
+}
+
+class BitmapBench
+{
+public:
+    explicit BitmapBench(BenchOptions aOptions)
+        : maOptions(std::move(aOptions))
+    {
+    }
+
+    void run();
+    bool writeJson() const;
+
+private:
+    /// Times rOperation on what rPrepare returns, once to warm up and then --repeat times.
+    template <typename Prepare, typename Operation>
+    void measure(const char* pGroup, std::string aName, const Size& rSize,
+                 vcl::PixelFormat ePixelFormat, const Prepare& rPrepare,
+                 const Operation& rOperation);
+
+    void runScale(const Size& rSize);
+    void runConvert(const Size& rSize);
+    void runFilter(const Size& rSize);
+    void runBlend(const Size& rSize);
+    void runChecksum(const Size& rSize);
+
+    const BenchOptions maOptions;
+    bool mbSupports32 = false;
+    std::vector<Result> maResults;
+};
+
+template <typename Prepare, typename Operation>
+void BitmapBench::measure(const char* pGroup, std::string aName, const Size& rSize,
+                          vcl::PixelFormat ePixelFormat, const Prepare& rPrepare,
+                          const Operation& rOperation)
+{
+    Result aResult{ pGroup, std::move(aName), rSize, vcl::pixelFormatBitCount(ePixelFormat), {} };
+    for (int i = 0; i <= maOptions.mnRepeat; ++i)
+    {
+        auto aInput = rPrepare();
+        const auto aStart = std::chrono::steady_clock::now();
+        rOperation(aInput);
+        const auto aEnd = std::chrono::steady_clock::now();
+        if (i != 0)
+            aResult.maTimes.push_back(
+                std::chrono::duration<double, std::milli>(aEnd - aStart).count());
+    }
+    std::sort(aResult.maTimes.begin(), aResult.maTimes.end());
+
+    std::cerr << aResult.maGroup << "/" << aResult.maName << " " << rSize.Width() << "x"
+              << rSize.Height() << "@" << aResult.mnBitCount << ": "
+              << getMedian(aResult.maTimes) << " ms\n";
+    maResults.push_back(std::move(aResult));
+}
+
+void BitmapBench::run()
+{
+    mbSupports32 = ImplGetSVData()->mpDefInst->supportsBitmap32();
+    for (int nSize : maOptions.maSizes)
+    {
+        const Size aSize(nSize, nSize);
+        if (wantsBench(maOptions, "scale"))
+            runScale(aSize);
+        if (wantsBench(maOptions, "convert"))
+            runConvert(aSize);
+        if (wantsBench(maOptions, "filter"))
+            runFilter(aSize);
+        if (wantsBench(maOptions, "blend"))
+            runBlend(aSize);
+        if (wantsBench(maOptions, "checksum"))
+            runChecksum(aSize);
+    }
+}
+
+void BitmapBench::runScale(const Size& rSize)
+{
+    static const std::pair<BmpScaleFlag, const char*> aFlags[]
+        = { { BmpScaleFlag::Default, "Default" },
+            { BmpScaleFlag::Fast, "Fast" },
+            { BmpScaleFlag::BestQuality, "BestQuality" },
+            { BmpScaleFlag::Interpolate, "Interpolate" },
+            { BmpScaleFlag::Lanczos, "Lanczos" },
+            { BmpScaleFlag::BiCubic, "BiCubic" },
+            { BmpScaleFlag::BiLinear, "BiLinear" },
+            { BmpScaleFlag::NearestNeighbor, "NearestNeighbor" } };
+    static const std::pair<double, const char*> aFactors[] = { { 0.5, "down" }, { 1.5, "up" } };
+
+    const Bitmap aSource(createBitmap(rSize, vcl::PixelFormat::N24_BPP));
+    for (const auto & [ eFlag, pFlagName ] : aFlags)
+    {
+        for (const auto & [ fFactor, pFactorName ] : aFactors)
+        {
+            measure(
+                "scale", std::string(pFlagName) + "/" + pFactorName, rSize,
+                vcl::PixelFormat::N24_BPP,
+                [&aSource] { return Bitmap(aSource); },
+                [fFactor = fFactor, eFlag = eFlag](Bitmap& rBitmap) {
+                    rBitmap.Scale(fFactor, fFactor, eFlag);
+                });
+        }
+    }
+}
+
+void BitmapBench::runConvert(const Size& rSize)
+{
+    static const std::pair<BmpConversion, const char*> aConversions[]
+        = { { BmpConversion::N1BitThreshold, "N1BitThreshold" },
+            { BmpConversion::N8BitGreys, "N8BitGreys" },
+            { BmpConversion::N8BitColors, "N8BitColors" },
+            { BmpConversion::N8BitTrans, "N8BitTrans" },
+            { BmpConversion::N24Bit, "N24Bit" },
+            { BmpConversion::N32Bit, "N32Bit" } };
+
+    for (vcl::PixelFormat eFormat :
+         { vcl::PixelFormat::N8_BPP, vcl::PixelFormat::N24_BPP, vcl::PixelFormat::N32_BPP })
+    {
+        if (eFormat == vcl::PixelFormat::N32_BPP && !mbSupports32)
+            continue;
+        const Bitmap aSource(createBitmap(rSize, eFormat));
+        for (const auto & [ eConversion, pName ] : aConversions)
+        {
+            if ((eConversion == BmpConversion::N32Bit && !mbSupports32)
+                || (eConversion == BmpConversion::N24Bit && eFormat == vcl::PixelFormat::N24_BPP)
+                || (eConversion == BmpConversion::N32Bit && eFormat == vcl::PixelFormat::N32_BPP))
+                continue;
+            measure(
+                "convert", pName, rSize, eFormat, [&aSource] { return Bitmap(aSource); },
+                [eConversion = eConversion](Bitmap& rBitmap) { rBitmap.Convert(eConversion); });
+        }
+    }
+}
+
+void BitmapBench::runFilter(const Size& rSize)
+{
+    static const NamedFilter aFilters[] = {
+        { "Sepia", [] { return std::make_unique<BitmapSepiaFilter>(10); } },
+        { "Solarize", [] { return std::make_unique<BitmapSolarizeFilter>(128); } },
+        { "Mosaic", [] { return std::make_unique<BitmapMosaicFilter>(8, 8); } },
+        { "EmbossGrey",
+          [] {
+              return std::make_unique<BitmapEmbossGreyFilter>(Degree100(4500), Degree100(4500));
+          } },
+        { "SobelGrey", [] { return std::make_unique<BitmapSobelGreyFilter>(); } },
+        { "Sharpen", [] { return std::make_unique<BitmapSharpenFilter>(); } },
+        { "Smoothen", [] { return std::make_unique<BitmapSmoothenFilter>(2.0); } },
+        { "GaussianSeparableBlur",
+          [] { return std::make_unique<BitmapGaussianSeparableBlurFilter>(2.0); } },
+        { "SeparableUnsharpen",
+          [] { return std::make_unique<BitmapSeparableUnsharpenFilter>(-2.0); } },
+        { "StackBlur", [] { return std::make_unique<BitmapFilterStackBlur>(10); } },
+        { "Median", [] { return std::make_unique<BitmapMedianFilter>(); } },
+        { "Dilate", [] { return std::make_unique<BitmapDilateFilter>(2); } },
+        { "Erode", [] { return std::make_unique<BitmapErodeFilter>(2); } },
+        { "Monochrome", [] { return std::make_unique<BitmapMonochromeFilter>(128); } },
+        { "PopArt", [] { return std::make_unique<BitmapPopArtFilter>(); } },
+        { "ColorQuantization",
+          [] { return std::make_unique<BitmapColorQuantizationFilter>(256); } },
+        { "SimpleColorQuantization",
+          [] { return std::make_unique<BitmapSimpleColorQuantizationFilter>(256); } },
+        { "DuoTone",
+          [] { return std::make_unique<BitmapDuoToneFilter>(COL_LIGHTBLUE, COL_YELLOW); } },
+        { "Lighten", [] { return std::make_unique<BitmapLightenFilter>(); } },
+        { "DisabledImage", [] { return std::make_unique<BitmapDisabledImageFilter>(); } },
+        { "Pipeline",
+          [] {
+              auto pPipeline = std::make_unique<vcl::bitmap::BitmapFilterPipeline>();
+              pPipeline->Adjust(10, 20, 0, 0, 0, 1.2, false, false).Grey();
+              return pPipeline;
+          } },
+    };
+
+    const Bitmap aSource(createBitmap(rSize, vcl::PixelFormat::N24_BPP));
+    for (const NamedFilter& rFilter : aFilters)
+    {
+        const std::unique_ptr<BitmapFilter> pFilter(rFilter.mfnCreate());
+        measure(
+            "filter", rFilter.mpName, rSize, vcl::PixelFormat::N24_BPP,
+            [&aSource] { return BitmapEx(aSource); },
+            [&pFilter](BitmapEx& rBitmapEx) { BitmapFilter::Filter(rBitmapEx, *pFilter); });
+    }
+
+    measure(
+        "filter", "Adjust", rSize, vcl::PixelFormat::N24_BPP,
+        [&aSource] { return Bitmap(aSource); },
+        [](Bitmap& rBitmap) { rBitmap.Adjust(10, 20, 0, 0, 0, 1.2, false, false); });
+}
+
+void BitmapBench::runBlend(const Size& rSize)
+{
+    const Bitmap aSource(createBitmap(rSize, vcl::PixelFormat::N24_BPP));
+    const AlphaMask aAlpha(createAlpha(rSize));
+
+    measure(
+        "blend", "Bitmap::Blend", rSize, vcl::PixelFormat::N24_BPP,
+        [&aSource] { return Bitmap(aSource); },
+        [&aAlpha](Bitmap& rBitmap) { rBitmap.Blend(aAlpha, COL_WHITE); });
+
+    measure(
+        "blend", "AlphaMask::BlendWith", rSize, vcl::PixelFormat::N8_BPP,
+        [&rSize] { return createAlpha(rSize); },
+        [&aAlpha](AlphaMask& rMask) { rMask.BlendWith(aAlpha.GetBitmap()); });
+}
+
+void BitmapBench::runChecksum(const Size& rSize)
+{
+    for (vcl::PixelFormat eFormat :
+         { vcl::PixelFormat::N8_BPP, vcl::PixelFormat::N24_BPP, vcl::PixelFormat::N32_BPP })
+    {
+        if (eFormat == vcl::PixelFormat::N32_BPP && !mbSupports32)
+            continue;
+        // the checksum is cached in the bitmap, so every call needs a bitmap of its own
+        measure(
+            "checksum", "Bitmap::GetChecksum", rSize, eFormat,
+            [&] { return createBitmap(rSize, eFormat); },
+            [](Bitmap& rBitmap) { rBitmap.GetChecksum(); });
+    }
+
+    measure(
+        "checksum", "BitmapEx::GetChecksum", rSize, vcl::PixelFormat::N24_BPP,
+        [&rSize] {
+            return BitmapEx(createBitmap(rSize, vcl::PixelFormat::N24_BPP), createAlpha(rSize));
+        },
+        [](BitmapEx& rBitmapEx) { rBitmapEx.GetChecksum(); });
+}
+
+bool BitmapBench::writeJson() const
+{
+    return writeBenchJson(
+        maOptions,
+        [this](std::ostream& rStream) {
+            rStream << ",\n  \"threads\": " << std::thread::hardware_concurrency()
+                    << ",\n  \"supports_bitmap32\": " << (mbSupports32 ? "true" : "false");
+        },
+        maResults.size(),
+        [this](std::ostream& rStream, size_t nIndex) {
+            const Result& rResult = maResults[nIndex];
+            const double fMedian = getMedian(rResult.maTimes);
+            const double fMegaPixels = rResult.maSize.Width() * rResult.maSize.Height() / 1e6;
+
+            rStream << "\"group\": \"" << rResult.maGroup << "\", \"name\": \"" << rResult.maName
+                    << "\", \"width\": " << rResult.maSize.Width()
+                    << ", \"height\": " << rResult.maSize.Height()
+                    << ", \"bit_count\": " << rResult.mnBitCount << ", ";
+            writeTimes(rStream, rResult.maTimes);
+            rStream << ", \"mpixels_per_s\": "
+                    << (fMedian > 0 ? fMegaPixels * 1000 / fMedian : 0);
+        });
+}
+
+void showHelp()
+{
+    std::cerr << "Usage: bitmapbench [--sizes N,...] [--repeat N] [--only GROUP,...] [FILE]\n";
+    std::cerr << "Times bitmap operations on N x N bitmaps (default 64,512,2048) and writes the\n";
+    std::cerr << "results as JSON to FILE, or to stdout without FILE or with --.\n";
+    std::cerr << "Every operation is timed --repeat times (default 5), and the minimum, median,\n";
+    std::cerr << "mean and maximum of those are written.\n";
+    std::cerr << "Groups: scale, convert, filter, blend, checksum (default all).\n";
+}
+
+int runBench(int argc, char** argv)
+{
+    BenchOptions aOptions;
+    aOptions.maSizes = { 64, 512, 2048 };
+    if (const std::optional<int> oExit
+        = parseBenchOptions(argc, argv, "--sizes", aOptions, &showHelp))
+        return *oExit;
+
+    BitmapBench aBench(std::move(aOptions));
+    aBench.run();
+    return aBench.writeJson() ? 0 : 1;
+}
+}
+
+SAL_IMPLEMENT_MAIN_WITH_ARGS(argc, argv)
+{
+    // headless, but an explicitly chosen backend can be benchmarked as well
+    setenv("SAL_USE_VCLPLUGIN", "svp", 0);
+
+    auto xContext = cppu::defaultBootstrap_InitialComponentContext();
+    css::uno::Reference<css::lang::XMultiServiceFactory> xServiceManager(
+        xContext->getServiceManager(), css::uno::UNO_QUERY);
+    if (!xServiceManager.is())
+        Application::Abort("Bootstrap failure - no service manager");
+    comphelper::setProcessServiceFactory(xServiceManager);
+    LanguageTag::setConfiguredSystemLanguage(MsLangId::getSystemLanguage());
+
+    Application::EnableHeadlessMode(false);
+    InitVCL();
+    const int nRet = runBench(argc, argv);
+    DeInitVCL();
+
+    css::uno::Reference<css::lang::XComponent>(xContext, css::uno::UNO_QUERY_THROW)->dispose();
+    comphelper::setProcessServiceFactory(nullptr);
+
+    return nRet;
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab cinoptions=b1,g0,N-s cinkeys+=0=break: */
@@ -0,0 +1,265 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4; fill-column: 100 -*- */
+/*
+ * This file is part of the LibreOffice project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/* Times the set operations of vcl::Region and writes the results as JSON, e.g.
+
+        make Executable_regionbench
+        cp workdir/LinkTarget/Executable/regionbench instdir/program
+        instdir/program/regionbench --counts 100,1000 --repeat 9 results.json
+
+   Both regions of an operation are made of the given count of random rectangles (always the same
+   ones). Every operation is timed once with the other region as a whole ("region") and once with
+   it applied rectangle by rectangle ("rectangles"), which is what callers without the merge of
+   whole regions end up doing; both have to give the same region, else the benchmark fails. The
+   rectangles are those of the other region, which do not overlap. For intersecting, the parts of
+   the first region within each rectangle are collected. The timings
+   are in milliseconds per call. Compare results of the same machine and build type only.
+*/
+
+#include <sal/main.h>
+#include <tools/gen.hxx>
+#include <vcl/region.hxx>
+
+#include "benchcommon.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+struct Result
+{
+    std::string maName;
+    std::string maVariant;
+    int mnCount;
+    size_t mnResultRectangles;
+    std::vector<double> maTimes; // milliseconds, sorted
+};
+
+struct Operation
+{
+    const char* mpName;
+    std::function<void(vcl::Region&, const vcl::Region&)> mfnRegion;
+    std::function<void(vcl::Region&, const tools::Rectangle&)> mfnRectangle;
+};
+
+/// Overlapping rectangles of different sizes, so that the bands have some separations each.
+std::vector<tools::Rectangle> createRectangles(int nCount, unsigned nSeed)
+{
+    std::mt19937 aGenerator(nSeed);
+    // keep about the same density for all counts
+    const int nExtent = std::max(256, static_cast<int>(std::sqrt(nCount) * 64));
+    std::uniform_int_distribution<int> aPosition(0, nExtent);
+    std::uniform_int_distribution<int> aSize(4, 96);
+
+    std::vector<tools::Rectangle> aRectangles;
+    aRectangles.reserve(nCount);
+    for (int i = 0; i < nCount; ++i)
+    {
+        const Point aTopLeft(aPosition(aGenerator), aPosition(aGenerator));
+        aRectangles.emplace_back(aTopLeft, Size(aSize(aGenerator), aSize(aGenerator)));
+    }
+    return aRectangles;
+}
+
+vcl::Region createRegion(const std::vector<tools::Rectangle>& rRectangles)
+{
+    vcl::Region aRegion;
+    for (const tools::Rectangle& rRectangle : rRectangles)
+        aRegion.Union(rRectangle);
+    return aRegion;
+}
+
+size_t countRectangles(const vcl::Region& rRegion)
+{
+    RectangleVector aRectangles;
+    rRegion.GetRegionRectangles(aRectangles);
+    return aRectangles.size();
+}
+
+class RegionBench
+{
+public:
+    explicit RegionBench(BenchOptions aOptions)
+        : maOptions(std::move(aOptions))
+    {
+    }
+
+    /// False if the two ways of an operation did not give the same region.
+    bool run();
+    bool writeJson() const;
+
+private:
+    /// Times rOperation on a copy of rFirst, once to warm up and then --repeat times.
+    vcl::Region measure(const char* pName, const char* pVariant, int nCount,
+                        const vcl::Region& rFirst,
+                        const std::function<void(vcl::Region&)>& rOperation);
+
+    const BenchOptions maOptions;
+    std::vector<Result> maResults;
+};
+
+vcl::Region RegionBench::measure(const char* pName, const char* pVariant, int nCount,
+                                 const vcl::Region& rFirst,
+                                 const std::function<void(vcl::Region&)>& rOperation)
+{
+    Result aResult{ pName, pVariant, nCount, 0, {} };
+    vcl::Region aRegion;
+    for (int i = 0; i <= maOptions.mnRepeat; ++i)
+    {
+        aRegion = rFirst;
+        const auto aStart = std::chrono::steady_clock::now();
+        rOperation(aRegion);
+        const auto aEnd = std::chrono::steady_clock::now();
+        if (i != 0)
+            aResult.maTimes.push_back(
+                std::chrono::duration<double, std::milli>(aEnd - aStart).count());
+    }
+    std::sort(aResult.maTimes.begin(), aResult.maTimes.end());
+    aResult.mnResultRectangles = countRectangles(aRegion);
+
+    std::cerr << aResult.maName << "/" << aResult.maVariant << " " << nCount << ": "
+              << getMedian(aResult.maTimes) << " ms\n";
+    maResults.push_back(std::move(aResult));
+    return aRegion;
+}
+
+bool RegionBench::run()
+{
+    // the intersection of a region with the rectangles one by one would be the intersection with
+    // the first one only, so the parts of the region within each of them are collected instead
+    static const Operation aOperations[] = {
+        { "union", [](vcl::Region& rRegion, const vcl::Region& rOther) { rRegion.Union(rOther); },
+          [](vcl::Region& rRegion, const tools::Rectangle& rRectangle) {
+              rRegion.Union(rRectangle);
+          } },
+        { "intersect",
+          [](vcl::Region& rRegion, const vcl::Region& rOther) { rRegion.Intersect(rOther); },
+          nullptr },
+        { "exclude",
+          [](vcl::Region& rRegion, const vcl::Region& rOther) { rRegion.Exclude(rOther); },
+          [](vcl::Region& rRegion, const tools::Rectangle& rRectangle) {
+              rRegion.Exclude(rRectangle);
+          } },
+        { "xor", [](vcl::Region& rRegion, const vcl::Region& rOther) { rRegion.XOr(rOther); },
+          [](vcl::Region& rRegion, const tools::Rectangle& rRectangle) {
+              rRegion.XOr(rRectangle);
+          } },
+    };
+
+    bool bSame = true;
+    for (int nCount : maOptions.maSizes)
+    {
+        const std::vector<tools::Rectangle> aFirstRectangles(createRectangles(nCount, 1));
+        const std::vector<tools::Rectangle> aSecondRectangles(createRectangles(nCount, 2));
+        const vcl::Region aFirst(createRegion(aFirstRectangles));
+        const vcl::Region aSecond(createRegion(aSecondRectangles));
+        // The generated rectangles overlap, which would toggle pixels back for XOr one by one;
+        // those of the region do not, and cover the same pixels.
+        RectangleVector aSecondParts;
+        aSecond.GetRegionRectangles(aSecondParts);
+
+        if (wantsBench(maOptions, "build"))
+            measure("build", "rectangles", nCount, vcl::Region(),
+                    [&aFirstRectangles](vcl::Region& rRegion) {
+                        for (const tools::Rectangle& rRectangle : aFirstRectangles)
+                            rRegion.Union(rRectangle);
+                    });
+
+        for (const Operation& rOperation : aOperations)
+        {
+            if (!wantsBench(maOptions, rOperation.mpName))
+                continue;
+
+            const vcl::Region aByRegion(
+                measure(rOperation.mpName, "region", nCount, aFirst,
+                        [&](vcl::Region& rRegion) { rOperation.mfnRegion(rRegion, aSecond); }));
+            const vcl::Region aByRectangles(measure(
+                rOperation.mpName, "rectangles", nCount, aFirst, [&](vcl::Region& rRegion) {
+                    if (!rOperation.mfnRectangle)
+                    {
+                        const vcl::Region aWhole(rRegion);
+                        rRegion.SetEmpty();
+                        for (const tools::Rectangle& rRectangle : aSecondParts)
+                        {
+                            vcl::Region aPart(aWhole);
+                            aPart.Intersect(rRectangle);
+                            RectangleVector aPartRectangles;
+                            aPart.GetRegionRectangles(aPartRectangles);
+                            for (const tools::Rectangle& rPart : aPartRectangles)
+                                rRegion.Union(rPart);
+                        }
+                        return;
+                    }
+                    for (const tools::Rectangle& rRectangle : aSecondParts)
+                        rOperation.mfnRectangle(rRegion, rRectangle);
+                }));
+
+            if (aByRegion != aByRectangles)
+            {
+                std::cerr << rOperation.mpName << " " << nCount
+                          << ": the results of the region and of the rectangles differ\n";
+                bSame = false;
+            }
+        }
+    }
+    return bSame;
+}
+
+bool RegionBench::writeJson() const
+{
+    return writeBenchJson(maOptions, nullptr, maResults.size(),
+                          [this](std::ostream& rStream, size_t nIndex) {
+                              const Result& rResult = maResults[nIndex];
+                              rStream << "\"operation\": \"" << rResult.maName
+                                      << "\", \"variant\": \"" << rResult.maVariant
+                                      << "\", \"count\": " << rResult.mnCount
+                                      << ", \"result_rectangles\": "
+                                      << rResult.mnResultRectangles << ", ";
+                              writeTimes(rStream, rResult.maTimes);
+                          });
+}
+
+void showHelp()
+{
+    std::cerr << "Usage: regionbench [--counts N,...] [--repeat N] [--only OPERATION,...]\n";
+    std::cerr << "                   [FILE]\n";
+    std::cerr << "Times region operations on regions of N rectangles (default 10,100,1000) and\n";
+    std::cerr << "writes the results as JSON to FILE, or to stdout without FILE or with --.\n";
+    std::cerr << "The timings are of the median of --repeat calls (default 5).\n";
+    std::cerr << "Operations: build, union, intersect, exclude, xor (default all).\n";
+    std::cerr << "Fails if an operation gives different regions for the region as a whole and\n";
+    std::cerr << "for its rectangles one by one.\n";
+}
+}
+
+SAL_IMPLEMENT_MAIN_WITH_ARGS(argc, argv)
+{
+    // vcl::Region does not need the VCL to be initialized
+    BenchOptions aOptions;
+    aOptions.maSizes = { 10, 100, 1000 };
+    if (const std::optional<int> oExit
+        = parseBenchOptions(argc, argv, "--counts", aOptions, &showHelp))
+        return *oExit;
+
+    RegionBench aBench(std::move(aOptions));
+    const bool bSame = aBench.run();
+    const bool bWritten = aBench.writeJson();
+    return bSame && bWritten ? 0 : 1;
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 expandtab cinoptions=b1,g0,N-s cinkeys+=0=break: */